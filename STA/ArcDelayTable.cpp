@@ -0,0 +1,51 @@
+/************************************************************************
+ *   Define member functions of class ArcDelayTable: Build()
+ *
+ *   Author      : Kuan-Hsien Ho
+************************************************************************/
+
+#include <vector>
+
+#include "ArcDelayTable.h"
+#include "Cell.h"
+#include "Gate.h"
+#include "TimingGraph.h"
+
+using namespace std;
+
+void ArcDelayTable::Build(const TimingGraph &graph)
+{
+    _arc_begin_vec.assign( 1, 0 );
+    _slot_begin_vec.assign( 1, 0 );
+
+    for( unsigned i=0; i<graph.GetGateNo(); ++i )
+    {
+	const Cell *cell_ptr = graph.GetGatePtr(i)->GetCellPtr();
+	const bool has_arcs = ( cell_ptr != NULL && cell_ptr->GetIsNonClocked() ); // not PI, PO or flip-flop
+
+	for( unsigned j=graph.GetOutputBegin(i); j<graph.GetOutputEnd(i); ++j )
+	{
+	    const unsigned output_pin_id = j - graph.GetOutputBegin(i);
+
+	    if( has_arcs )
+	    {
+		const vector<vector<InputTimingTable> > &timing_vec = cell_ptr->FetInputTimingVec();
+
+		for( unsigned k=0; k<cell_ptr->GetInputPinNo(); ++k )
+		{
+		    if( timing_vec[k][output_pin_id].PinTimingSense == InputTimingTable::NON_UNATE )
+			_slot_begin_vec.push_back( _slot_begin_vec.back() + NON_UNATE_SLOT_NO );
+		    else
+			_slot_begin_vec.push_back( _slot_begin_vec.back() + UNATE_SLOT_NO );
+		}
+	    }
+
+	    _arc_begin_vec.push_back( _slot_begin_vec.size()-1 );
+	}
+    }
+
+    for( unsigned m=0; m<MODE_NO; ++m )
+	_delay_vec[m].assign( _slot_begin_vec.back(), 0.0 );
+
+    return;
+}
@@ -0,0 +1,88 @@
+/************************************************************************
+ *   Define a flat table of gate delays on timing arcs.
+ *   An arc goes from a gate input pin to a gate output pin of a
+ *   non-clocked cell. A unate arc takes 2 slots and a non-unate arc
+ *   takes 4, and each slot keeps an early-mode and a late-mode delay.
+ *   The table is sized once from the cell arcs, and then propagateSignal()
+ *   writes delays that backtraceSignal() reads back.
+ *
+ *   Defined class: ArcDelayTable
+ *
+ *   Author      : Kuan-Hsien Ho
+************************************************************************/
+
+#ifndef ARC_DELAY_TABLE_H
+#define ARC_DELAY_TABLE_H
+
+#include <cassert>
+#include <vector>
+
+//-----------------------------------------------------------------------
+//    Declare classes
+//-----------------------------------------------------------------------
+
+class ArcDelayTable;
+class TimingGraph; // defined in TimingGraph.h
+
+//-----------------------------------------------------------------------
+//    Define class
+//-----------------------------------------------------------------------
+
+class ArcDelayTable
+{
+    public:
+	enum Mode
+	{
+	    FAST, // early mode
+	    SLOW, // late mode
+	    MODE_NO
+	};
+
+	enum UnateSlot // slot offsets of a unate arc
+	{
+	    FROM_INPUT_FALL,
+	    FROM_INPUT_RISE,
+	    UNATE_SLOT_NO
+	};
+
+	enum NonUnateSlot // slot offsets of a non-unate arc
+	{
+	    INPUT_FALL_OUTPUT_FALL,
+	    INPUT_FALL_OUTPUT_RISE,
+	    INPUT_RISE_OUTPUT_FALL,
+	    INPUT_RISE_OUTPUT_RISE,
+	    NON_UNATE_SLOT_NO
+	};
+
+	void Build(const TimingGraph &graph); // after the timing graph is built
+
+	unsigned GetArcNo() const  { return _slot_begin_vec.size()-1; }
+	unsigned GetSlotNo() const { return _delay_vec[FAST].size(); }
+
+	// first slot of the arc from an input pin (index of the cell input pins) to a gate output pin (graph output id)
+	unsigned GetSlot(const unsigned &output_id, const unsigned &input_pin_id) const;
+
+	double GetDelay(const Mode &m, const unsigned &slot) const          { assert( slot < GetSlotNo() ); return _delay_vec[m][slot]; }
+	void SetDelay(const Mode &m, const unsigned &slot, const double &val) { assert( slot < GetSlotNo() ); _delay_vec[m][slot] = val; }
+	double* FetDelayArray(const Mode &m) { return _delay_vec[m].data(); } // indexed by slot
+	const double* FetDelayArray(const Mode &m) const { return _delay_vec[m].data(); }
+
+    private:
+	std::vector<unsigned> _arc_begin_vec;  // graph output id -> first arc id, with an extra end
+	std::vector<unsigned> _slot_begin_vec; // arc id -> first slot, with an extra end
+	std::vector<double> _delay_vec[MODE_NO];
+};
+
+//-----------------------------------------------------------------------
+//    Define inline member functions
+//-----------------------------------------------------------------------
+
+inline unsigned ArcDelayTable::GetSlot(const unsigned &output_id, const unsigned &input_pin_id) const
+{
+    const unsigned arc_id = _arc_begin_vec[output_id] + input_pin_id;
+    assert( arc_id < _arc_begin_vec[output_id+1] );
+
+    return _slot_begin_vec[arc_id];
+}
+
+#endif // ARC_DELAY_TABLE_H
@@ -0,0 +1,92 @@
+/************************************************************************
+ *   Define helpers to write and read binary images made of 32-bit
+ *   integers, doubles and length-prefixed strings in native format.
+ *   Readers check bounds and never assume alignment, so an image can be
+ *   read directly from a mapped file.
+ *
+ *   Author      : Kuan-Hsien Ho
+************************************************************************/
+
+#ifndef BINARY_IO_H
+#define BINARY_IO_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//-----------------------------------------------------------------------
+//    Declare functions
+//-----------------------------------------------------------------------
+
+void putU32( std::vector<char> &buf, const uint32_t &val );
+
+void putDouble( std::vector<char> &buf, const double &val );
+
+void putString( std::vector<char> &buf, std::string_view str );
+
+bool getU32( const char *&pos, const char *end, uint32_t &val );       // false if out of range
+
+bool getDouble( const char *&pos, const char *end, double &val );      // false if out of range
+
+bool getString( const char *&pos, const char *end, std::string &str ); // false if out of range
+
+//-----------------------------------------------------------------------
+//    Define inline functions
+//-----------------------------------------------------------------------
+
+inline void putU32( std::vector<char> &buf, const uint32_t &val )
+{
+    const char *val_ptr = reinterpret_cast<const char *>(&val);
+    buf.insert( buf.end(), val_ptr, val_ptr+sizeof(val) );
+}
+
+inline void putDouble( std::vector<char> &buf, const double &val )
+{
+    const char *val_ptr = reinterpret_cast<const char *>(&val);
+    buf.insert( buf.end(), val_ptr, val_ptr+sizeof(val) );
+}
+
+inline void putString( std::vector<char> &buf, std::string_view str )
+{
+    putU32( buf, str.size() );
+    buf.insert( buf.end(), str.begin(), str.end() );
+}
+
+inline bool getU32( const char *&pos, const char *end, uint32_t &val )
+{
+    if( static_cast<size_t>(end-pos) < sizeof(val) )
+	return false;
+
+    memcpy( &val, pos, sizeof(val) ); // the image is not aligned
+    pos += sizeof(val);
+
+    return true;
+}
+
+inline bool getDouble( const char *&pos, const char *end, double &val )
+{
+    if( static_cast<size_t>(end-pos) < sizeof(val) )
+	return false;
+
+    memcpy( &val, pos, sizeof(val) );
+    pos += sizeof(val);
+
+    return true;
+}
+
+inline bool getString( const char *&pos, const char *end, std::string &str )
+{
+    uint32_t length;
+
+    if( !getU32(pos, end, length) || static_cast<size_t>(end-pos) < length )
+	return false;
+
+    str.assign( pos, length );
+    pos += length;
+
+    return true;
+}
+
+#endif // BINARY_IO_H
@@ -1,16 +1,41 @@
 /************************************************************************
- *   Define member functions of class Cell: PrintCellData()
+ *   Define member functions of class Cell: BucketArcsBySense(), PrintCellData()
  *
  *   Author      : Kuan-Hsien Ho
 ************************************************************************/
 
 #include <cassert>
 #include <iostream>
+#include <vector>
 
 #include "Cell.h"
 
 using namespace std;
 
+// arcs of unknown timing sense, e.g., from a data pin of a flip-flop, are left out
+void Cell::BucketArcsBySense()
+{
+    const unsigned sense_no = InputTimingTable::UNKNOWN_UNATE;
+    _sense_output_id_vec.assign( GetInputPinNo()*sense_no, vector<unsigned>() );
+    _sense_input_id_vec.assign( GetOutputPinNo()*sense_no, vector<unsigned>() );
+
+    for( unsigned i=0; i<GetInputPinNo(); ++i )
+    {
+	for( unsigned j=0; j<GetOutputPinNo(); ++j )
+	{
+	    const unsigned sense = _input_timing_vec[i][j].PinTimingSense;
+
+	    if( sense == InputTimingTable::UNKNOWN_UNATE )
+		continue;
+
+	    _sense_output_id_vec[i*sense_no + sense].push_back(j);
+	    _sense_input_id_vec[j*sense_no + sense].push_back(i);
+	}
+    }
+
+    return;
+}
+
 // display for checking
 void Cell::PrintCellData() const
 {
@@ -13,6 +13,7 @@
 #include <cassert>
 #include <cstdio>
 #include <string>
+#include <string_view>
 #include <vector>
 
 //-----------------------------------------------------------------------
@@ -32,21 +33,27 @@ class Cell
     public:
 	friend class CellLibrary;
 
-	std::string GetName() const { return _name; }
+	const std::string& GetName() const { return _name; }
 	bool GetIsNonClocked() const { return _is_non_clocked; }
 	std::string GetInputPinName(const unsigned &id) const { return _input_pin_name_vec[id]; }
 	std::string GetClockPinName() const { return _input_pin_name_vec[_clock_pin_id]; }
 	double GetInputFallCap(const unsigned &id) const { return _input_fall_cap_vec[id]; }
 	double GetInputRiseCap(const unsigned &id) const { return _input_rise_cap_vec[id]; }
 	std::string GetOutputPinName(const unsigned &id) const { return _output_pin_name_vec[id]; }
-	int GetInputPinId(const std::string &name) const;
+	int GetInputPinId(std::string_view name) const;
 	unsigned GetClockPinId() const { return _clock_pin_id; }
-	int GetOutputPinId(const std::string &name) const;
+	int GetOutputPinId(std::string_view name) const;
 	unsigned GetInputPinNo() const { return _input_pin_name_vec.size(); }
 	unsigned GetOutputPinNo() const { return _output_pin_name_vec.size(); }
 	const std::vector<std::vector<InputTimingTable> >& FetInputTimingVec() const { return _input_timing_vec; }
 	const std::vector<ClockParams*>& FetClockParamsVec() const { return _clock_params_vec; }
 
+	// pin ids of the other ends of the arcs from an input pin or to an output pin, bucketed by a known timing sense
+	const std::vector<unsigned>& FetSenseOutputIdVec(const unsigned &input_id, const unsigned &sense) const;
+	const std::vector<unsigned>& FetSenseInputIdVec(const unsigned &output_id, const unsigned &sense) const;
+
+	void BucketArcsBySense(); // after all timing tables of the cell are loaded
+
 	void SetName(const char *n) { _name = n; }
 
 	void PrintCellData() const; // display data for checking
@@ -67,6 +74,10 @@ class Cell
 
 	// output pin data
 	std::vector<std::string> _output_pin_name_vec;
+
+	// arcs bucketed by timing sense, indexed by pin id * UNKNOWN_UNATE + sense
+	std::vector<std::vector<unsigned> > _sense_output_id_vec;
+	std::vector<std::vector<unsigned> > _sense_input_id_vec;
 };
 
 class ClockParams
@@ -109,7 +120,7 @@ class InputTimingTable
 
 	InputTimingTable(): PinTimingSense(UNKNOWN_UNATE) {} // constructor
 
-	void SetPinTimingSense(std::string &str);
+	void SetPinTimingSense(std::string_view str);
 
 	TimingSense PinTimingSense;
 
@@ -132,7 +143,7 @@ class InputTimingTable
 //    Define inline member functions
 //-----------------------------------------------------------------------
 
-inline int Cell::GetInputPinId(const std::string &name) const
+inline int Cell::GetInputPinId(std::string_view name) const
 {
     for( unsigned i=0; i<_input_pin_name_vec.size(); ++i )
 	if( _input_pin_name_vec[i] == name )
@@ -141,7 +152,7 @@ inline int Cell::GetInputPinId(const std::string &name) const
     return -1;
 }
 
-inline int Cell::GetOutputPinId(const std::string &name) const
+inline int Cell::GetOutputPinId(std::string_view name) const
 {
     for( unsigned i=0; i<_output_pin_name_vec.size(); ++i )
 	if( _output_pin_name_vec[i] == name )
@@ -150,7 +161,21 @@ inline int Cell::GetOutputPinId(const std::string &name) const
     return -1;
 }
 
-inline void InputTimingTable::SetPinTimingSense(std::string &str)
+inline const std::vector<unsigned>& Cell::FetSenseOutputIdVec(const unsigned &input_id, const unsigned &sense) const
+{
+    assert( sense < InputTimingTable::UNKNOWN_UNATE );
+
+    return _sense_output_id_vec[input_id*InputTimingTable::UNKNOWN_UNATE + sense];
+}
+
+inline const std::vector<unsigned>& Cell::FetSenseInputIdVec(const unsigned &output_id, const unsigned &sense) const
+{
+    assert( sense < InputTimingTable::UNKNOWN_UNATE );
+
+    return _sense_input_id_vec[output_id*InputTimingTable::UNKNOWN_UNATE + sense];
+}
+
+inline void InputTimingTable::SetPinTimingSense(std::string_view str)
 {
     assert( str == "positive_unate" || str == "negative_unate" || str == "non_unate" );
 
@@ -8,71 +8,73 @@
 #include <cassert>
 #include <cstdlib>
 #include <cstring>
-#include <fstream>
 #include <iostream>
 #include <string>
+#include <string_view>
 
 #include "CellLibrary.h"
+#include "MappedFile.h"
 
 using namespace std;
 
+//-----------------------------------------------------------------------
+//    Declare auxiliary functions 
+//-----------------------------------------------------------------------
+
+void loadInputTimingTable( LineTokenizer &tokenizer, InputTimingTable &cur_timing ); // parse a timing line after pin names
+
+//-----------------------------------------------------------------------
+//    Define member functions
+//-----------------------------------------------------------------------
+
 // parse cell library file
 void CellLibrary::Initialize(const char *file_name)
 {
-    ifstream inf( file_name, ifstream::in );
-
-    if( !inf )
-    {
-	cerr << "Error opening " << file_name << " for input" << endl;
-	cerr << " Exiting..." << endl;
-	exit(-1);
-    }
+    MappedFile inf( file_name );    // map the whole library, exit if failed
+    LineTokenizer tokenizer( inf ); // tokens are views into the mapped file, numbers are parsed in place
 
     // variables for parsing
-    string cur_str, pin_name, direction;
-    double cur_double;
-    inf >> cur_str;
+    string_view cur_str, pin_name, direction;
+    cur_str = tokenizer.NextWord();
 
     // read cell by cell
-    while( !inf.eof() )
+    while( !cur_str.empty() )
     {
-	assert( !strcmp(cur_str.c_str(), "cell") );
-	Cell *cell_ptr = new Cell();       // create a new cell
+	assert( cur_str == "cell" );
+	Cell *cell_ptr = _cell_arena.Create(); // create a new cell
 	Cell &cur_cell = (*cell_ptr);
-	inf >> cur_cell._name >> cur_str;
-	assert( !inf.eof() );
+	cur_cell._name = tokenizer.NextWord();
+	cur_str = tokenizer.NextWord();
+	assert( !cur_str.empty() );
 	bool is_non_clocked = true;
 
 	while( cur_str[0] == 'p' )
 	{
 	    assert( cur_str == "pin" );
-	    inf >> pin_name >> direction;
+	    pin_name = tokenizer.NextWord();
+	    direction = tokenizer.NextWord();
 	    assert( direction == "input" || direction == "output" || direction == "clock" );
 
 	    switch( direction[0] )
 	    {
 		case 'i': // input
 		    {
-			cur_cell._input_pin_name_vec.push_back(pin_name);
-			inf >> cur_double;
-			cur_cell._input_fall_cap_vec.push_back(cur_double);
-			inf >> cur_double;
-			cur_cell._input_rise_cap_vec.push_back(cur_double);
+			cur_cell._input_pin_name_vec.push_back( string(pin_name) );
+			cur_cell._input_fall_cap_vec.push_back( tokenizer.NextWordDouble() );
+			cur_cell._input_rise_cap_vec.push_back( tokenizer.NextWordDouble() );
 			break;
 		    }
 		case 'o': // output
 		    {
-			cur_cell._output_pin_name_vec.push_back(pin_name);
+			cur_cell._output_pin_name_vec.push_back( string(pin_name) );
 			break;
 		    }
 		case 'c': // clock
 		    {
 			cur_cell._clock_pin_id = (cur_cell._input_pin_name_vec).size();
-			cur_cell._input_pin_name_vec.push_back(pin_name);
-			inf >> cur_double;
-			cur_cell._input_fall_cap_vec.push_back(cur_double);
-			inf >> cur_double;
-			cur_cell._input_rise_cap_vec.push_back(cur_double);
+			cur_cell._input_pin_name_vec.push_back( string(pin_name) );
+			cur_cell._input_fall_cap_vec.push_back( tokenizer.NextWordDouble() );
+			cur_cell._input_rise_cap_vec.push_back( tokenizer.NextWordDouble() );
 			is_non_clocked = false;
 			break;
 		    }
@@ -81,7 +83,8 @@ void CellLibrary::Initialize(const char *file_name)
 		    break;
 	    }
 
-	    inf >> cur_str;
+	    cur_str = tokenizer.NextWord();
+	    assert( !cur_str.empty() );
 	}
 
 	// resize a 2D timing vector space
@@ -95,18 +98,11 @@ void CellLibrary::Initialize(const char *file_name)
 	    do
 	    {
 		assert( cur_str == "timing" );
-		inf >> cur_str;
-		const int input_id = cur_cell.GetInputPinId(cur_str);
-		inf >> cur_str;
-		const int output_id = cur_cell.GetOutputPinId(cur_str);
-		InputTimingTable &cur_timing = (cur_cell._input_timing_vec)[input_id][output_id];
-		inf >> cur_str;
-		cur_timing.SetPinTimingSense( cur_str );
-		inf >> cur_timing.FallSlewX >> cur_timing.FallSlewY >> cur_timing.FallSlewZ;
-		inf >> cur_timing.RiseSlewX >> cur_timing.RiseSlewY >> cur_timing.RiseSlewZ;
-		inf >> cur_timing.FallDelayA >> cur_timing.FallDelayB >> cur_timing.FallDelayC;
-		inf >> cur_timing.RiseDelayA >> cur_timing.RiseDelayB >> cur_timing.RiseDelayC;
-	    } while( inf >> cur_str && cur_str[0] == 't' ); // timing
+		const int input_id = cur_cell.GetInputPinId( tokenizer.NextWord() );
+		const int output_id = cur_cell.GetOutputPinId( tokenizer.NextWord() );
+		loadInputTimingTable( tokenizer, (cur_cell._input_timing_vec)[input_id][output_id] );
+		cur_str = tokenizer.NextWord();
+	    } while( !cur_str.empty() && cur_str[0] == 't' ); // timing
 	}
 	else
 	{
@@ -122,78 +118,77 @@ void CellLibrary::Initialize(const char *file_name)
 		    case 't': // timing
 			{
 			    assert( cur_str == "timing" );
-			    inf >> cur_str;
-			    const int input_id = cur_cell.GetInputPinId(cur_str);
-			    inf >> cur_str;
-			    const int output_id = cur_cell.GetOutputPinId(cur_str);
-			    InputTimingTable &cur_timing = (cur_cell._input_timing_vec)[input_id][output_id];
-			    inf >> cur_str;
-			    cur_timing.SetPinTimingSense( cur_str );
-			    inf >> cur_timing.FallSlewX >> cur_timing.FallSlewY >> cur_timing.FallSlewZ;
-			    inf >> cur_timing.RiseSlewX >> cur_timing.RiseSlewY >> cur_timing.RiseSlewZ;
-			    inf >> cur_timing.FallDelayA >> cur_timing.FallDelayB >> cur_timing.FallDelayC;
-			    inf >> cur_timing.RiseDelayA >> cur_timing.RiseDelayB >> cur_timing.RiseDelayC;
+			    const int input_id = cur_cell.GetInputPinId( tokenizer.NextWord() );
+			    const int output_id = cur_cell.GetOutputPinId( tokenizer.NextWord() );
+			    loadInputTimingTable( tokenizer, (cur_cell._input_timing_vec)[input_id][output_id] );
 			    break;
 			}
 		    case 's': // setup
 			{
-			    inf >> pin_name;
+			    pin_name = tokenizer.NextWord();
 			    assert( pin_name == cur_cell.GetClockPinName() );
-			    inf >> pin_name;
+			    pin_name = tokenizer.NextWord();
 			    const int input_id = cur_cell.GetInputPinId(pin_name);
 
 			    if( (cur_cell._clock_params_vec)[input_id] == NULL )
-				(cur_cell._clock_params_vec)[input_id] = new ClockParams();
+				(cur_cell._clock_params_vec)[input_id] = _clock_params_arena.Create();
 
 			    // set clock information
 			    ClockParams &cur_clock_params = *((cur_cell._clock_params_vec)[input_id]);
-			    inf >>  cur_str;
+			    cur_str = tokenizer.NextWord();
 			    assert( cur_str == "falling" || cur_str == "rising" );
 			    cur_clock_params.SetupEdgeType = (cur_str[0] == 'f')? ClockParams::FALLING: ClockParams::RISING;
-			    inf >> cur_clock_params.FallSetupG >> cur_clock_params.FallSetupH >> cur_clock_params.FallSetupJ;
-			    inf >> cur_clock_params.RiseSetupG >> cur_clock_params.RiseSetupH >> cur_clock_params.RiseSetupJ;
+			    cur_clock_params.FallSetupG = tokenizer.NextWordDouble();
+			    cur_clock_params.FallSetupH = tokenizer.NextWordDouble();
+			    cur_clock_params.FallSetupJ = tokenizer.NextWordDouble();
+			    cur_clock_params.RiseSetupG = tokenizer.NextWordDouble();
+			    cur_clock_params.RiseSetupH = tokenizer.NextWordDouble();
+			    cur_clock_params.RiseSetupJ = tokenizer.NextWordDouble();
 			    break;
 			}
 		    case 'h': // hold
 			{
-			    inf >> pin_name;
+			    pin_name = tokenizer.NextWord();
 			    assert( pin_name == cur_cell.GetClockPinName() );
-			    inf >> pin_name;
+			    pin_name = tokenizer.NextWord();
 			    const int input_id = cur_cell.GetInputPinId(pin_name);
 
 			    if( (cur_cell._clock_params_vec)[input_id] == NULL )
-				(cur_cell._clock_params_vec)[input_id] = new ClockParams();
+				(cur_cell._clock_params_vec)[input_id] = _clock_params_arena.Create();
 
 			    // set clock information
 			    ClockParams &cur_clock_params = *((cur_cell._clock_params_vec)[input_id]);
-			    inf >> cur_str;
+			    cur_str = tokenizer.NextWord();
 			    assert( cur_str == "falling" || cur_str == "rising" );
 			    cur_clock_params.HoldEdgeType = (cur_str[0] == 'f')? ClockParams::FALLING: ClockParams::RISING;
-			    inf >> cur_clock_params.FallHoldM >> cur_clock_params.FallHoldN >> cur_clock_params.FallHoldP;
-			    inf >> cur_clock_params.RiseHoldM >> cur_clock_params.RiseHoldN >> cur_clock_params.RiseHoldP;
+			    cur_clock_params.FallHoldM = tokenizer.NextWordDouble();
+			    cur_clock_params.FallHoldN = tokenizer.NextWordDouble();
+			    cur_clock_params.FallHoldP = tokenizer.NextWordDouble();
+			    cur_clock_params.RiseHoldM = tokenizer.NextWordDouble();
+			    cur_clock_params.RiseHoldN = tokenizer.NextWordDouble();
+			    cur_clock_params.RiseHoldP = tokenizer.NextWordDouble();
 			    break;
 			}
 		    case 'p': // preset <input pin name> <output pin name> <edge type> <slew> <delay>
+		    case 'c': // clear <input pin name> <output pin name> <edge type> <slew> <delay>
 			{
-			    inf >> cur_str >> cur_str >>cur_str >>cur_str >>cur_str >>cur_str >>cur_str >>cur_str >> cur_str;
-			    break;
-			}
-		    case 'c':  // clear <input pin name> <output pin name> <edge type> <slew> <delay>
-			{
-			    inf >> cur_str >> cur_str >>cur_str >>cur_str >>cur_str >>cur_str >>cur_str >>cur_str >> cur_str;
+			    for( unsigned i=0; i<9; ++i ) // not used
+				tokenizer.NextWord();
+
 			    break;
 			}
 		    default:
 			assert(0);
 			break;
 		}
-	    } while( inf >> cur_str && cur_str != "cell" );
+
+		cur_str = tokenizer.NextWord();
+	    } while( !cur_str.empty() && cur_str != "cell" );
 	} // end else
 
+	cur_cell.BucketArcsBySense();
 	_cell_ptr_vec.push_back(cell_ptr); // insert new cell to cell library
-    } // end while( !inf.eof() )
-
-    inf.close();
+    } // end while( !cur_str.empty() )
 
     return;
 }
@@ -210,3 +205,27 @@ void CellLibrary::PrintCellLibraryData() const
 
     return;
 }
+
+//-----------------------------------------------------------------------
+//    Define auxiliary functions 
+//-----------------------------------------------------------------------
+
+// <timing sense> <fall x> <fall y> <fall z> <rise x> <rise y> <rise z> <fall a> <fall b> <fall c> <rise a> <rise b> <rise c>
+void loadInputTimingTable( LineTokenizer &tokenizer, InputTimingTable &cur_timing )
+{
+    cur_timing.SetPinTimingSense( tokenizer.NextWord() );
+    cur_timing.FallSlewX = tokenizer.NextWordDouble();
+    cur_timing.FallSlewY = tokenizer.NextWordDouble();
+    cur_timing.FallSlewZ = tokenizer.NextWordDouble();
+    cur_timing.RiseSlewX = tokenizer.NextWordDouble();
+    cur_timing.RiseSlewY = tokenizer.NextWordDouble();
+    cur_timing.RiseSlewZ = tokenizer.NextWordDouble();
+    cur_timing.FallDelayA = tokenizer.NextWordDouble();
+    cur_timing.FallDelayB = tokenizer.NextWordDouble();
+    cur_timing.FallDelayC = tokenizer.NextWordDouble();
+    cur_timing.RiseDelayA = tokenizer.NextWordDouble();
+    cur_timing.RiseDelayB = tokenizer.NextWordDouble();
+    cur_timing.RiseDelayC = tokenizer.NextWordDouble();
+
+    return;
+}
@@ -12,6 +12,7 @@
 #include <cassert>
 
 #include "Cell.h"
+#include "ObjectArena.h"
 
 //-----------------------------------------------------------------------
 //    Declare classes
@@ -27,16 +28,25 @@ class CellLibrary
 {
     public:
 	CellLibrary(const char *file_name) { Initialize(file_name); }
+	CellLibrary(const char *file_name, const char *image_name); // load the binary image, or parse and (re)write it if stale; parse only if image_name is NULL
+	CellLibrary(const CellLibrary&) = delete; // cells are owned by the arenas
+	CellLibrary& operator=(const CellLibrary&) = delete;
 
 	unsigned GetCellNo() const { return _cell_ptr_vec.size(); }
 	Cell *GetCellPtr(unsigned id) const { assert( id < _cell_ptr_vec.size() ); return _cell_ptr_vec[id]; }
 
         void Initialize(const char *file_name);
 
+	// binary library image, valid only for the library file with the recorded size and modification time
+	bool LoadImage(const char *image_name, const char *file_name); // false if missing, stale or corrupt
+	bool SaveImage(const char *image_name, const char *file_name) const;
+
 	void PrintCellLibraryData() const; // display data for checking
 
     private:
 	std::vector<Cell*> _cell_ptr_vec;
+	ObjectArena<Cell> _cell_arena;                // owns all cells
+	ObjectArena<ClockParams> _clock_params_arena; // owns all clock parameters of cells
 };
 
 #endif // CELL_LIBRARY_H
@@ -0,0 +1,321 @@
+/************************************************************************
+ *   Define member functions of class CellLibrary for the binary library
+ *   image: CellLibrary(), LoadImage(), SaveImage()
+ *
+ *   The image is a header followed by the cells in library order. Every
+ *   string is stored as its length and bytes, and every number in the
+ *   native 32-bit or double format, so the image holds no pointer and can
+ *   be mapped at any address. A header records the size and modification
+ *   time of the library file, and an image not matching the library file
+ *   is stale and ignored.
+ *
+ *   Author      : Kuan-Hsien Ho
+************************************************************************/
+
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "BinaryIO.h"
+#include "CellLibrary.h"
+#include "MappedFile.h"
+
+using namespace std;
+
+//-----------------------------------------------------------------------
+//    Declare auxiliary functions and data
+//-----------------------------------------------------------------------
+
+struct LibImageHeader
+{
+    char Magic[8];          // "STALIBIM"
+    uint32_t Version;       // LIB_IMAGE_VERSION
+    uint32_t ByteOrder;     // 0x01020304 in the byte order of the writer
+    uint64_t SourceSize;    // size of the library file
+    int64_t SourceMtimeSec; // modification time of the library file
+    int64_t SourceMtimeNsec;
+    uint64_t ImageSize;     // size of the whole image, to detect a truncated image
+    uint32_t CellNo;
+    uint32_t Reserved;
+};
+
+static const char LIB_IMAGE_MAGIC[8] = {'S', 'T', 'A', 'L', 'I', 'B', 'I', 'M'};
+static const uint32_t LIB_IMAGE_VERSION = 1;    // increase when the layout changes
+static const uint32_t LIB_IMAGE_BYTE_ORDER = 0x01020304;
+
+bool getSourceStamp( const char *file_name, LibImageHeader &header ); // fill source size and modification time
+
+//-----------------------------------------------------------------------
+//    Define member functions
+//-----------------------------------------------------------------------
+
+CellLibrary::CellLibrary(const char *file_name, const char *image_name)
+{
+    if( image_name == NULL )
+    {
+	Initialize(file_name);
+	return;
+    }
+
+    if( LoadImage(image_name, file_name) )
+	return;
+
+    Initialize(file_name); // stale or missing image
+
+    if( !SaveImage(image_name, file_name) )
+	printf( "Warning: cannot write library image %s\n", image_name );
+}
+
+bool CellLibrary::LoadImage(const char *image_name, const char *file_name)
+{
+    assert( _cell_ptr_vec.size() == 0 );
+    LibImageHeader source_stamp;
+    MappedFile image;
+
+    if( !getSourceStamp(file_name, source_stamp) || !image.Open(image_name) )
+	return false;
+
+    LibImageHeader header;
+
+    if( image.GetSize() < sizeof(header) )
+	return false;
+
+    memcpy( &header, image.GetBegin(), sizeof(header) );
+
+    if( memcmp(header.Magic, LIB_IMAGE_MAGIC, sizeof(header.Magic)) != 0 || header.Version != LIB_IMAGE_VERSION ||
+	header.ByteOrder != LIB_IMAGE_BYTE_ORDER || header.ImageSize != image.GetSize() )
+	return false;
+
+    if( header.SourceSize != source_stamp.SourceSize || header.SourceMtimeSec != source_stamp.SourceMtimeSec ||
+	header.SourceMtimeNsec != source_stamp.SourceMtimeNsec )
+	return false; // library file changed after the image was written
+
+    const char *pos = image.GetBegin() + sizeof(header);
+    const char *end = image.GetEnd();
+    bool is_ok = true;
+    _cell_ptr_vec.reserve( header.CellNo );
+
+    for( uint32_t c=0; c<header.CellNo && is_ok; ++c )
+    {
+	Cell *cell_ptr = _cell_arena.Create();
+	Cell &cur_cell = (*cell_ptr);
+	_cell_ptr_vec.push_back(cell_ptr);
+	uint32_t is_non_clocked, clock_pin_id, input_no, output_no;
+
+	is_ok = getString(pos, end, cur_cell._name) && getU32(pos, end, is_non_clocked) && getU32(pos, end, clock_pin_id) &&
+	        getU32(pos, end, input_no) && getU32(pos, end, output_no) && 
+		input_no <= static_cast<size_t>(end-pos) && output_no <= static_cast<size_t>(end-pos);
+
+	if( !is_ok )
+	    break;
+
+	cur_cell._is_non_clocked = (is_non_clocked != 0);
+	cur_cell._clock_pin_id = clock_pin_id;
+	cur_cell._input_pin_name_vec.resize(input_no);
+	cur_cell._input_fall_cap_vec.resize(input_no);
+	cur_cell._input_rise_cap_vec.resize(input_no);
+	cur_cell._output_pin_name_vec.resize(output_no);
+
+	for( uint32_t i=0; i<input_no && is_ok; ++i )
+	    is_ok = getString(pos, end, cur_cell._input_pin_name_vec[i]) && getDouble(pos, end, cur_cell._input_fall_cap_vec[i]) &&
+		    getDouble(pos, end, cur_cell._input_rise_cap_vec[i]);
+
+	for( uint32_t j=0; j<output_no && is_ok; ++j )
+	    is_ok = getString(pos, end, cur_cell._output_pin_name_vec[j]);
+
+	cur_cell._input_timing_vec.resize(input_no, vector<InputTimingTable>(output_no));
+
+	for( uint32_t i=0; i<input_no && is_ok; ++i )
+	{
+	    for( uint32_t j=0; j<output_no && is_ok; ++j )
+	    {
+		InputTimingTable &cur_timing = cur_cell._input_timing_vec[i][j];
+		uint32_t sense;
+
+		is_ok = getU32(pos, end, sense) && sense <= InputTimingTable::UNKNOWN_UNATE &&
+		        getDouble(pos, end, cur_timing.FallSlewX) && getDouble(pos, end, cur_timing.FallSlewY) &&
+			getDouble(pos, end, cur_timing.FallSlewZ) && getDouble(pos, end, cur_timing.FallDelayA) &&
+			getDouble(pos, end, cur_timing.FallDelayB) && getDouble(pos, end, cur_timing.FallDelayC) &&
+			getDouble(pos, end, cur_timing.RiseSlewX) && getDouble(pos, end, cur_timing.RiseSlewY) &&
+			getDouble(pos, end, cur_timing.RiseSlewZ) && getDouble(pos, end, cur_timing.RiseDelayA) &&
+			getDouble(pos, end, cur_timing.RiseDelayB) && getDouble(pos, end, cur_timing.RiseDelayC);
+
+		if( is_ok )
+		    cur_timing.PinTimingSense = static_cast<InputTimingTable::TimingSense>(sense);
+	    }
+	}
+
+	if( !is_ok )
+	    break;
+
+	cur_cell.BucketArcsBySense();
+
+	if( cur_cell._is_non_clocked )
+	    continue;
+
+	cur_cell._clock_params_vec.assign( input_no, NULL );
+
+	for( uint32_t i=0; i<input_no && is_ok; ++i )
+	{
+	    uint32_t is_constrained, setup_edge, hold_edge;
+	    is_ok = getU32(pos, end, is_constrained);
+
+	    if( !is_ok || !is_constrained )
+		continue;
+
+	    ClockParams *clock_params_ptr = _clock_params_arena.Create();
+	    cur_cell._clock_params_vec[i] = clock_params_ptr;
+	    ClockParams &cur_clock_params = (*clock_params_ptr);
+
+	    is_ok = getU32(pos, end, setup_edge) && getU32(pos, end, hold_edge) &&
+		    getDouble(pos, end, cur_clock_params.FallSetupG) && getDouble(pos, end, cur_clock_params.FallSetupH) &&
+		    getDouble(pos, end, cur_clock_params.FallSetupJ) && getDouble(pos, end, cur_clock_params.FallHoldM) &&
+		    getDouble(pos, end, cur_clock_params.FallHoldN) && getDouble(pos, end, cur_clock_params.FallHoldP) &&
+		    getDouble(pos, end, cur_clock_params.RiseSetupG) && getDouble(pos, end, cur_clock_params.RiseSetupH) &&
+		    getDouble(pos, end, cur_clock_params.RiseSetupJ) && getDouble(pos, end, cur_clock_params.RiseHoldM) &&
+		    getDouble(pos, end, cur_clock_params.RiseHoldN) && getDouble(pos, end, cur_clock_params.RiseHoldP);
+
+	    cur_clock_params.SetupEdgeType = (setup_edge == ClockParams::FALLING)? ClockParams::FALLING: ClockParams::RISING;
+	    cur_clock_params.HoldEdgeType = (hold_edge == ClockParams::FALLING)? ClockParams::FALLING: ClockParams::RISING;
+	}
+    }
+
+    if( is_ok && pos == end )
+	return true;
+
+    // corrupt image, drop all cells read so far
+    _cell_ptr_vec.clear();
+    _cell_arena.Clear();
+    _clock_params_arena.Clear();
+
+    return false;
+}
+
+// write to a temporary file and rename it, so that concurrent runs never map a partially written image
+bool CellLibrary::SaveImage(const char *image_name, const char *file_name) const
+{
+    LibImageHeader header;
+    memset( &header, 0, sizeof(header) );
+
+    if( !getSourceStamp(file_name, header) )
+	return false;
+
+    memcpy( header.Magic, LIB_IMAGE_MAGIC, sizeof(header.Magic) );
+    header.Version = LIB_IMAGE_VERSION;
+    header.ByteOrder = LIB_IMAGE_BYTE_ORDER;
+    header.CellNo = _cell_ptr_vec.size();
+
+    vector<char> buf( sizeof(header) ); // header is filled in after the size is known
+
+    for( unsigned c=0; c<_cell_ptr_vec.size(); ++c )
+    {
+	const Cell &cur_cell = *(_cell_ptr_vec[c]);
+	const unsigned input_no = cur_cell._input_pin_name_vec.size();
+	const unsigned output_no = cur_cell._output_pin_name_vec.size();
+
+	putString( buf, cur_cell._name );
+	putU32( buf, cur_cell._is_non_clocked? 1: 0 );
+	putU32( buf, cur_cell._is_non_clocked? 0: cur_cell._clock_pin_id );
+	putU32( buf, input_no );
+	putU32( buf, output_no );
+
+	for( unsigned i=0; i<input_no; ++i )
+	{
+	    putString( buf, cur_cell._input_pin_name_vec[i] );
+	    putDouble( buf, cur_cell._input_fall_cap_vec[i] );
+	    putDouble( buf, cur_cell._input_rise_cap_vec[i] );
+	}
+
+	for( unsigned j=0; j<output_no; ++j )
+	    putString( buf, cur_cell._output_pin_name_vec[j] );
+
+	for( unsigned i=0; i<input_no; ++i )
+	{
+	    for( unsigned j=0; j<output_no; ++j )
+	    {
+		const InputTimingTable &cur_timing = cur_cell._input_timing_vec[i][j];
+		putU32( buf, cur_timing.PinTimingSense );
+		putDouble( buf, cur_timing.FallSlewX );  putDouble( buf, cur_timing.FallSlewY );  putDouble( buf, cur_timing.FallSlewZ );
+		putDouble( buf, cur_timing.FallDelayA ); putDouble( buf, cur_timing.FallDelayB ); putDouble( buf, cur_timing.FallDelayC );
+		putDouble( buf, cur_timing.RiseSlewX );  putDouble( buf, cur_timing.RiseSlewY );  putDouble( buf, cur_timing.RiseSlewZ );
+		putDouble( buf, cur_timing.RiseDelayA ); putDouble( buf, cur_timing.RiseDelayB ); putDouble( buf, cur_timing.RiseDelayC );
+	    }
+	}
+
+	if( cur_cell._is_non_clocked )
+	    continue;
+
+	assert( cur_cell._clock_params_vec.size() == input_no );
+
+	for( unsigned i=0; i<input_no; ++i )
+	{
+	    const ClockParams *clock_params_ptr = cur_cell._clock_params_vec[i];
+	    putU32( buf, (clock_params_ptr != NULL)? 1: 0 );
+
+	    if( clock_params_ptr == NULL )
+		continue;
+
+	    const ClockParams &cur_clock_params = (*clock_params_ptr);
+	    putU32( buf, cur_clock_params.SetupEdgeType );
+	    putU32( buf, cur_clock_params.HoldEdgeType );
+	    putDouble( buf, cur_clock_params.FallSetupG ); putDouble( buf, cur_clock_params.FallSetupH ); putDouble( buf, cur_clock_params.FallSetupJ );
+	    putDouble( buf, cur_clock_params.FallHoldM );  putDouble( buf, cur_clock_params.FallHoldN );  putDouble( buf, cur_clock_params.FallHoldP );
+	    putDouble( buf, cur_clock_params.RiseSetupG ); putDouble( buf, cur_clock_params.RiseSetupH ); putDouble( buf, cur_clock_params.RiseSetupJ );
+	    putDouble( buf, cur_clock_params.RiseHoldM );  putDouble( buf, cur_clock_params.RiseHoldN );  putDouble( buf, cur_clock_params.RiseHoldP );
+	}
+    }
+
+    header.ImageSize = buf.size();
+    memcpy( &(buf[0]), &header, sizeof(header) );
+
+    // a unique name in the directory of the image, so that two runs rebuilding it never share a temporary file
+    string tmp_name = string(image_name) + ".XXXXXX";
+    const int fd = mkstemp( &(tmp_name[0]) );
+
+    if( fd < 0 )
+	return false;
+
+    FILE *outf = NULL;
+
+    if( fchmod(fd, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH) != 0 || (outf = fdopen(fd, "wb")) == NULL ) // mkstemp() gives 0600
+    {
+	close( fd );
+	remove( tmp_name.c_str() );
+	return false;
+    }
+
+    const bool is_written = (fwrite(&(buf[0]), 1, buf.size(), outf) == buf.size());
+
+    if( fclose(outf) != 0 || !is_written || rename(tmp_name.c_str(), image_name) != 0 )
+    {
+	remove( tmp_name.c_str() );
+	return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------
+//    Define auxiliary functions 
+//-----------------------------------------------------------------------
+
+bool getSourceStamp( const char *file_name, LibImageHeader &header )
+{
+    struct stat file_stat;
+
+    if( stat(file_name, &file_stat) != 0 )
+	return false;
+
+    header.SourceSize = file_stat.st_size;
+    header.SourceMtimeSec = file_stat.st_mtim.tv_sec;
+    header.SourceMtimeNsec = file_stat.st_mtim.tv_nsec;
+
+    return true;
+}
@@ -11,21 +11,28 @@
 
 #include <cassert>
 #include <list>
-#include <map>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "ArcDelayTable.h"
 #include "Cell.h"
 #include "CellLibrary.h"
 #include "Gate.h"
+#include "NameTable.h"
+#include "ObjectArena.h"
 #include "PinNode.h"
 #include "RATData.h"
+#include "TimingGraph.h"
+#include "TimingStore.h"
 
 //-----------------------------------------------------------------------
 //    Declare classes
 //-----------------------------------------------------------------------
 
 class Circuit;
+class LineTokenizer; // defined in MappedFile.h
+class ThreadPool;    // defined in ThreadPool.h
 
 //-----------------------------------------------------------------------
 //    Define classes
@@ -34,11 +41,28 @@ class Circuit;
 class Circuit
 {
     public:
-	Circuit(const char *file_name, const CellLibrary &cell_library): _is_sequential(false), _clock_ptr(NULL), _clock_period(0.0) { Initialize(file_name, cell_library); }
+	// if is_streaming_wires, a wire is reduced to loads and delays as soon as it is parsed (see LoadWire);
+	// if is_keeping_rc_trees, RC trees of the wires whose roots are named in kept_root_name_table, or of all wires 
+	// if no table, are kept after injecting wiring effects for editing parasitics
+	Circuit(const char *file_name, const CellLibrary &cell_library, bool is_streaming_wires=false, bool is_keeping_rc_trees=false,
+	    const NameTable *kept_root_name_table_ptr=NULL): _is_sequential(false), _is_streaming_wires(is_streaming_wires), 
+	    _is_keeping_rc_trees(is_keeping_rc_trees), _has_reduced_wire(false), _kept_root_name_table_ptr(kept_root_name_table_ptr), 
+	    _clock_ptr(NULL), _clock_period(0.0), _retiming_tolerance(0.0), _is_graph_stale(false), _is_clock_period_dirty(false) { 
+	    Initialize(file_name, cell_library); _kept_root_name_table_ptr = NULL; _is_streaming_wires = false; }
+	// wired circuit from a snapshot made with the library file lib_file_name, and at/slew/rat/clock constraints from a file
+	Circuit(const char *snapshot_name, const char *file_name, const CellLibrary &cell_library, const char *lib_file_name): 
+	    _is_sequential(false), _is_streaming_wires(false), _is_keeping_rc_trees(false), _has_reduced_wire(false), 
+	    _kept_root_name_table_ptr(NULL), _clock_ptr(NULL), _clock_period(0.0), _retiming_tolerance(0.0), _is_graph_stale(false), _is_clock_period_dirty(false) { 
+	    LoadSnapshot(snapshot_name, cell_library, lib_file_name); LoadConstraints(file_name); }
+	Circuit(const Circuit&) = delete; // gates and pin nodes are owned by the arenas
+	Circuit& operator=(const Circuit&) = delete;
 
 	bool GetIsSequential() const { assert( _is_sequential || _SeqGate_ptr_vec.size() == 0 ); return _is_sequential; }
 	double GetClockPeriod() const                 { return _clock_period; }
+	double GetRetimingTolerance() const           { return _retiming_tolerance; }
 	PinNode* GetPinNodePtr(unsigned id)           { return _PinNode_ptr_vec[id]; }
+	PinNode* FindPinNodePtr(std::string_view name) const; // NULL if no such pin node
+	std::string_view GetPinNodeName(const PinNode &pnode) const { return _pin_node_name_table.GetName(pnode.GetId()); }
 	Gate* GetPIPtr(const unsigned &id) const      { return _PI_ptr_vec[id]; }
 	Gate* GetComGatePtr(const unsigned &id) const { return _ComGate_ptr_vec[id]; }
 	Gate* GetSeqGatePtr(const unsigned &id) const { return _SeqGate_ptr_vec[id]; }
@@ -50,39 +74,136 @@ class Circuit
 	unsigned GetPinNodeNo() const { return _PinNode_ptr_vec.size(); }
 	unsigned GetTotGateNo() const { return (GetPINo() + GetPONo() + GetComGateNo() + GetSeqGateNo()); }
 	unsigned GetRATDataNo() const { return _RATData_vec.size(); }
+	unsigned GetRATDataId(const PinNode &pnode) const; // index of _RATData_vec, or RATData::NO_DATA
  
 	void SetRATResultsList( std::list<RATData> &rat_list ); // defined in CircuitRAT.cpp
+	void SetRetimingTolerance(const double &val) { _retiming_tolerance = val; } // of arrival times, slews and required times
+
+	// constraints, also after STA, where they are left dirty until UpdateTiming() or UpdateConstraints()
+	void SetClockPeriod(const double &val); // defined in CircuitEdit.cpp
+	void SetArrivalTime( PinNode *pnode_ptr, const double &fast_fall, const double &slow_fall, const double &fast_rise, 
+		             const double &slow_rise );                                     // defined in CircuitEdit.cpp
+	void SetSlew( PinNode *pnode_ptr, const double &fall, const double &rise ); // of both modes, defined in CircuitEdit.cpp
+	// replace the SLOW or FAST required times of a pin node, where the ones of the other mode are kept; defined in CircuitLoad.cpp
+	void SetRATData( PinNode *pnode_ptr, const RATData::ModeType &mode, const double &fall_time, const double &rise_time );
 
 	std::vector<Gate*> &FetPOPtrVec()                  { return _PO_ptr_vec; }
 	std::vector<Gate*> &FetComGatePtrVec()             { return _ComGate_ptr_vec; }
 	const std::vector<Gate*> &FetSeqGatePtrVec() const { return _SeqGate_ptr_vec; }
 	std::vector<PinNode*> &FetPinNodePtrVec()          { return _PinNode_ptr_vec; }
 	std::vector<RATData> &FetRATDataVec()              { return _RATData_vec; }
+	TimingStore &FetTimingStore()                      { return _timing_store; }
+	const TimingStore &GetTimingStore() const          { return _timing_store; }
+	const TimingGraph &GetTimingGraph() const          { assert( _timing_graph.IsBuilt() ); return _timing_graph; }
+	bool HasTimingGraph() const                        { return _timing_graph.IsBuilt(); }
+	ArcDelayTable &FetArcDelayTable()                  { return _arc_delay_table; }
 
 	void Initialize(const char *file_name, const CellLibrary &cell_library);
+	void LoadConstraints(const char *file_name); // defined in CircuitLoad.cpp
+
+	// connectivity, wire delays, slew hats and loads after injecting wiring effects, but no constraint
+	void SaveSnapshot(const char *file_name, const char *lib_file_name) const; // defined in CircuitSnapshot.cpp
+	void LoadSnapshot(const char *file_name, const CellLibrary &cell_library, const char *lib_file_name); // defined in CircuitSnapshot.cpp
+
+	// after wiring, no connectivity change from then on; also size the arc-delay table
+	void BuildTimingGraph() { _timing_graph.Build(*this); _arc_delay_table.Build(_timing_graph); }
+	void LevelizeTimingGraph() { _timing_graph.Levelize(); }
+
+	// incremental timing after STA, defined in CircuitEdit.cpp
+	// edits are left dirty until UpdateTiming(), so that a batch of edits is propagated once
+	// of the same pins, clock pin and non-unate arcs, where the RC trees of the input wires must be kept if caps differ
+	void ReplaceCell(Gate *gate_ptr, Cell *new_cell_ptr);
+	// parasitics of a wire whose RC tree is kept
+	void SetWireRes(PinNode *root_ptr, std::string_view end1_name, std::string_view end2_name, const double &res);
+	void SetWireCap(PinNode *root_ptr, std::string_view node_name, const double &cap);
+	void ReplaceWire(std::string_view wire_block); // a wire line of the same root and taps, and its res and cap lines
+	// connectivity, where gates and wires are added the same way as loaded, and the RC trees of the wires whose taps
+	// change gates must be kept; the timing graph is stale until UpdateTiming() builds it again; defined in CircuitLoad.cpp
+	void InsertGate(LineTokenizer &tokenizer, Cell *cell_ptr); // <pin>:<node> list of an instance line
+	void RemoveGate(Gate *gate_ptr); // its pins are disconnected, and its pin nodes are left
+	bool InsertWire(LineTokenizer &tokenizer, NameTable &rc_node_name_table, std::string_view &reserved_word); // see LoadWire()
+	void RemoveWire(PinNode *root_ptr); // its taps are left undriven
+	void ConnectPin(Gate *gate_ptr, std::string_view pin_name, PinNode *pnode_ptr);
+	void DisconnectPin(Gate *gate_ptr, std::string_view pin_name);
+	// re-inject the dirty wires, re-propagate from them and the dirty gates and constraints, and clean them,
+	// or run RebuildTiming() if the timing graph is stale
+	void UpdateTiming();
+	// required times from scratch if only constraints are dirty, or UpdateTiming() if not; clean the dirty constraints
+	void UpdateConstraints(ThreadPool &thread_pool, const unsigned &chunk_size, const bool &is_push_backward);
+
 	void PrintCircuitData() const;
-	void PrintTimingData(); // print on screen
-	void PrintTimingData(const char *file_name); // print to file
+	void PrintTimingData(); // print on screen, after UpdateTiming()
+	void PrintTimingData(const char *file_name); // print to file, after UpdateTiming()
 
     private:
-	void LoadPrimaryInput( FILE *inf_ptr, const char *node_name, std::map<std::string, PinNode*> &pin_node_map );
-	void LoadPrimaryOutput( FILE *inf_ptr, const char *node_name, std::map<std::string, PinNode*> &pin_node_map );
-	void LoadInstance( FILE *inf_ptr, std::map<std::string, PinNode*> &pin_node_map, char *pos_ptr, Cell *cur_cell_ptr );
-	bool LoadWire( FILE *inf_ptr, std::map<std::string, PinNode*> &pin_node_map, char **pos_ptr, char **reserved_word );
-	void LoadRATData( std::map<std::string, PinNode*> &pin_node_map, char *pos_ptr );
+	PinNode* GrabPinNodePtr( std::string_view node_name ); // get if exists, if not, new one
+	void CheckNotOnReducedWire( const PinNode &pnode ) const; // exit if a fanout is added to a reduced wire
+	void LoadPrimaryInput( std::string_view node_name );
+	void LoadPrimaryOutput( std::string_view node_name );
+	void LoadInstance( LineTokenizer &tokenizer, Cell *cur_cell_ptr );
+	bool LoadWire( LineTokenizer &tokenizer, NameTable &rc_node_name_table, std::string_view &reserved_word );
+	void LoadSlew( LineTokenizer &tokenizer );
+	void LoadArrivalTime( LineTokenizer &tokenizer );
+	void LoadClock( LineTokenizer &tokenizer );
+	void LoadRATData( LineTokenizer &tokenizer );
+	void MarkDirtySource( const PinNode &pnode );     // of new arrival times or slews, after STA; defined in CircuitEdit.cpp
+	void MarkDirtyConstraint( const PinNode &pnode ); // of new required times, after STA; defined in CircuitEdit.cpp
+	void RebuildTiming(); // wiring effects, timing graph and STA from scratch after connectivity edits; in CircuitEdit.cpp
+	// exit if the loads of the wire of a pin node cannot be computed again, i.e., it is reduced; in CircuitLoad.cpp
+	void CheckWireKept( const PinNode &pnode, const std::string &edit ) const;
+	void CheckInputPinNode( PinNode &pnode ) const;  // a gate input pin can be connected to it; in CircuitLoad.cpp
+	void CheckOutputPinNode( PinNode &pnode ) const; // a gate output pin can be connected to it; in CircuitLoad.cpp
+	void ConnectInputPin( Gate &gate, const unsigned &pin_id, PinNode &pnode );  // defined in CircuitLoad.cpp
+	void ConnectOutputPin( Gate &gate, const unsigned &pin_id, PinNode &pnode ); // defined in CircuitLoad.cpp
+	void DisconnectInputPin( Gate &gate, const unsigned &pin_id );               // defined in CircuitLoad.cpp
+	void DisconnectOutputPin( Gate &gate, const unsigned &pin_id );              // defined in CircuitLoad.cpp
 
 	bool _is_sequential; // true if it is a sequential circuit; false otherwise
+	bool _is_streaming_wires; // reduce each wire while loading to keep only one RC tree in memory
+	bool _is_keeping_rc_trees; // keep RC trees, with node names, of selected wires after injecting wiring effects
+	bool _has_reduced_wire;   // some wire has been reduced while loading
+	const NameTable *_kept_root_name_table_ptr; // roots of the wires to keep, all if NULL; only while loading
 	PinNode *_clock_ptr;
 	double _clock_period;
+	double _retiming_tolerance; // changes within it stop incremental propagation
 
 	// circuit components
 	std::vector<Gate*> _PI_ptr_vec;         // primary input gates
 	std::vector<Gate*> _PO_ptr_vec;         // primary output gates
 	std::vector<Gate*> _ComGate_ptr_vec;    // combinational gates, including no PI or PO gates
 	std::vector<Gate*> _SeqGate_ptr_vec;    // D flip-flop gates
-        std::vector<PinNode*> _PinNode_ptr_vec; // all pin nodes, Non-sorted 
+        std::vector<PinNode*> _PinNode_ptr_vec; // all pin nodes, Non-sorted, indexed by pin-node id
+	ObjectArena<Gate> _gate_arena;          // owns all gates, including PI and PO pseudo-gates
+	ObjectArena<PinNode> _pin_node_arena;   // owns all pin nodes
+	NameTable _pin_node_name_table;         // pin-node name to pin-node id
+	TimingStore _timing_store;              // timing data of all pin nodes, indexed by pin-node id
+	TimingGraph _timing_graph;              // connectivity by ids for STA
+	ArcDelayTable _arc_delay_table;         // gate delays of timing arcs, indexed by graph output id and input pin
 
 	std::vector<RATData> _RATData_vec;      // required time constraints  
+	std::vector<unsigned> _RATData_id_vec;  // pin-node id -> index of _RATData_vec, RATData::NO_DATA if none
+
+	std::vector<unsigned> _dirty_gate_id_vec; // graph gate ids of changed arcs or loads since the last timing update
+	std::vector<unsigned> _dirty_wire_root_id_vec; // root pin-node ids of changed parasitics, arrival times or slews
+	std::vector<unsigned> _dirty_req_root_id_vec;  // root pin-node ids of changed required time constraints
+	bool _is_graph_stale;                          // connectivity changed since the timing graph was built
+	bool _is_clock_period_dirty;                   // the clock period changed, so all flip-flop constraints are dirty
 };
 
+//-----------------------------------------------------------------------
+//    Define inline member functions
+//-----------------------------------------------------------------------
+
+inline PinNode* Circuit::FindPinNodePtr(std::string_view name) const
+{
+    const unsigned id = _pin_node_name_table.Find(name);
+
+    return (id == NameTable::NOT_FOUND)? NULL: _PinNode_ptr_vec[id];
+}
+
+inline unsigned Circuit::GetRATDataId(const PinNode &pnode) const
+{
+    return (pnode.GetId() < _RATData_id_vec.size())? _RATData_id_vec[pnode.GetId()]: RATData::NO_DATA;
+}
+
 #endif // CIRCUIT_H
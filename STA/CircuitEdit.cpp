@@ -0,0 +1,524 @@
+/************************************************************************
+ *   Define member functions of class Circuit for incremental timing
+ *   after STA: ReplaceCell(), SetWireRes(), SetWireCap(), ReplaceWire(),
+ *   SetClockPeriod(), SetArrivalTime(), SetSlew(), UpdateTiming(),
+ *   UpdateConstraints(), RebuildTiming()
+ *
+ *   An edit marks the gates whose arcs or loads change dirty, the wires
+ *   whose parasitics or source arrival times and slews change dirty, and
+ *   the wires whose required time constraints change dirty. Nothing is
+ *   computed until UpdateTiming(), which injects the wiring effects of
+ *   the dirty wires again and re-propagates the union of their cones
+ *   once (see runIncrementalSTA.cpp). Only the RC trees of the wires
+ *   kept while loading are left after injecting wiring effects, so a cell
+ *   swap that changes input pin capacitances needs the RC trees of those
+ *   input wires to be kept (-keep_rc or -keep_rc_wires), unless the
+ *   driver connects to the pin directly and only its load changes. A new
+ *   clock period dirties the constraints of all flip-flops, whose cones
+ *   cover most of the circuit, so required times are rebuilt from
+ *   scratch by UpdateConstraints() if nothing else is dirty. After the
+ *   connectivity edits of CircuitLoad.cpp, RebuildTiming() replaces the
+ *   incremental STA.
+ *
+ *   Author      : Kuan-Hsien Ho
+************************************************************************/
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Cell.h"
+#include "Circuit.h"
+#include "Gate.h"
+#include "MappedFile.h"
+#include "NameTable.h"
+#include "PinNode.h"
+#include "RCTree.h"
+#include "TimingGraph.h"
+#include "process.h"
+
+using namespace std;
+
+//-----------------------------------------------------------------------
+//    Declare auxiliary functions
+//-----------------------------------------------------------------------
+
+bool areCellsSwappable( const Cell &old_cell, const Cell &new_cell ); // also of the same arc-delay table slots
+
+RCTree& fetKeptRCTree( const Circuit &circuit, PinNode *root_ptr ); // exit if not kept, or before STA
+
+unsigned findRCTreePos( const Circuit &circuit, const RCTree &rc_tree, const PinNode &root_pnode, std::string_view node_name ); // exit if not found
+
+extern unsigned getWireRootId( const TimingGraph &graph, const unsigned &pnode_id );
+
+//-----------------------------------------------------------------------
+//    Define member functions
+//-----------------------------------------------------------------------
+
+void Circuit::ReplaceCell(Gate *gate_ptr, Cell *new_cell_ptr)
+{
+    assert( gate_ptr != NULL && gate_ptr->GetCellPtr() != NULL && new_cell_ptr != NULL );
+    const Cell &old_cell = *(gate_ptr->GetCellPtr());
+
+    if( !HasTimingGraph() )
+    {
+	printf( "Error: cell %s is replaced before STA\n", old_cell.GetName().c_str() );
+	exit(-1);
+    }
+
+    if( !areCellsSwappable(old_cell, *new_cell_ptr) )
+    {
+	printf( "Error: cell %s cannot be replaced by cell %s of other pins, clock pin or arcs\n",
+		old_cell.GetName().c_str(), new_cell_ptr->GetName().c_str() );
+	exit(-1);
+    }
+
+    if( _is_graph_stale ) // loads are computed again with the new timing graph, see RebuildTiming()
+    {
+	for( unsigned i=0; i<gate_ptr->GetInputNo(); ++i )
+	    if( gate_ptr->GetInputPinNode(i) != NULL && (new_cell_ptr->GetInputFallCap(i) != old_cell.GetInputFallCap(i) ||
+		new_cell_ptr->GetInputRiseCap(i) != old_cell.GetInputRiseCap(i)) )
+		CheckWireKept( *(gate_ptr->GetInputPinNode(i)), "cell " + old_cell.GetName() + " is replaced" );
+
+	gate_ptr->_cell_ptr = new_cell_ptr;
+	return;
+    }
+
+    const TimingGraph &graph = GetTimingGraph();
+    const unsigned gate_id = graph.FindGateId( *gate_ptr );
+
+    if( gate_id == TimingGraph::NO_ID ) // connected to nothing
+    {
+	gate_ptr->_cell_ptr = new_cell_ptr;
+	return;
+    }
+
+    // loads of the gates driving the inputs change by the differences of input pin capacitances if no wire is between,
+    // or are computed again with the wiring effects of kept RC trees; wire delays of a reduced wire cannot be updated
+    for( unsigned i=graph.GetInputBegin(gate_id); i<graph.GetInputEnd(gate_id); ++i )
+    {
+	const unsigned pin_id = i - graph.GetInputBegin(gate_id);
+	const double fall_cap_diff = new_cell_ptr->GetInputFallCap(pin_id) - old_cell.GetInputFallCap(pin_id);
+	const double rise_cap_diff = new_cell_ptr->GetInputRiseCap(pin_id) - old_cell.GetInputRiseCap(pin_id);
+
+	if( graph.GetInputPinNodeId(i) == TimingGraph::NO_ID || (fall_cap_diff == 0.0 && rise_cap_diff == 0.0) )
+	    continue;
+
+	const unsigned root_id = getWireRootId( graph, graph.GetInputPinNodeId(i) );
+
+	if( _PinNode_ptr_vec[root_id]->GetFanoutRCTreePtr() != NULL )
+	{
+	    _dirty_wire_root_id_vec.push_back( root_id );
+	    continue;
+	}
+
+	CheckWireKept( *_PinNode_ptr_vec[root_id], "cell " + old_cell.GetName() + " is replaced" );
+
+	const unsigned fanin = graph.GetFanin(root_id);
+
+	if( fanin == TimingGraph::NO_ID )
+	    continue;
+
+	const unsigned output_id = TimingGraph::GetHandleId(fanin);
+	const unsigned driver_id = graph.GetOutputGateId(output_id);
+
+	if( graph.GetGatePtr(driver_id)->GetCellPtr() == NULL ) // PI
+	    continue;
+
+	GOutPin &gout_pin = graph.FetGOutPin(output_id);
+	gout_pin.SetFallLoad( gout_pin.GetFallLoad() + fall_cap_diff );
+	gout_pin.SetRiseLoad( gout_pin.GetRiseLoad() + rise_cap_diff );
+	_dirty_gate_id_vec.push_back( driver_id );
+    }
+
+    gate_ptr->_cell_ptr = new_cell_ptr;
+    _dirty_gate_id_vec.push_back( gate_id );
+
+    return;
+}
+
+// the resistor between two adjacent nodes
+void Circuit::SetWireRes(PinNode *root_ptr, string_view end1_name, string_view end2_name, const double &res)
+{
+    RCTree &rc_tree = fetKeptRCTree( *this, root_ptr );
+    const unsigned end1_pos = findRCTreePos( *this, rc_tree, *root_ptr, end1_name );
+    const unsigned end2_pos = findRCTreePos( *this, rc_tree, *root_ptr, end2_name );
+
+    if( end2_pos > 0 && rc_tree.GetFaninPos(end2_pos) == end1_pos )
+	rc_tree.SetFlatRes( end2_pos, res );
+    else if( end1_pos > 0 && rc_tree.GetFaninPos(end1_pos) == end2_pos )
+	rc_tree.SetFlatRes( end1_pos, res );
+    else
+    {
+	printf( "Error: no resistor between %s and %s on wire %s\n", string(end1_name).c_str(), string(end2_name).c_str(),
+		string(GetPinNodeName(*root_ptr)).c_str() );
+	exit(-1);
+    }
+
+    _dirty_wire_root_id_vec.push_back( root_ptr->GetId() );
+
+    return;
+}
+
+void Circuit::SetWireCap(PinNode *root_ptr, string_view node_name, const double &cap)
+{
+    RCTree &rc_tree = fetKeptRCTree( *this, root_ptr );
+    rc_tree.SetFlatCap( findRCTreePos(*this, rc_tree, *root_ptr, node_name), cap );
+    _dirty_wire_root_id_vec.push_back( root_ptr->GetId() );
+
+    return;
+}
+
+// the same format as in the netlist; the new RC tree is kept, whether the old one was or not
+void Circuit::ReplaceWire(string_view wire_block)
+{
+    LineTokenizer tokenizer( wire_block.data(), wire_block.data()+wire_block.size() );
+
+    if( !tokenizer.NextLine() || tokenizer.NextToken() != "wire" )
+    {
+	printf( "Error: a wire block does not begin with a wire line\n" );
+	exit(-1);
+    }
+
+    const string_view root_name = tokenizer.NextToken();
+    PinNode *root_ptr = FindPinNodePtr( root_name );
+
+    if( !HasTimingGraph() || root_ptr == NULL || root_ptr->_fanout_pin_node_no == 0 )
+    {
+	printf( "Error: wire %s is replaced before STA, or is not in the circuit\n", string(root_name).c_str() );
+	exit(-1);
+    }
+
+    // tap node ids follow the fanouts of the root, the same as injectWiringEffects() expects
+    const unsigned leaf_no = root_ptr->_fanout_pin_node_no;
+    NameTable rc_node_name_table;
+    bool is_new;
+    rc_node_name_table.Grab( GetPinNodeName(*root_ptr), is_new ); // id 0
+
+    for( unsigned i=0; i<leaf_no; ++i )
+	rc_node_name_table.Grab( GetPinNodeName(*static_cast<PinNode*>((root_ptr->_fanout_ptr_vec)[i])), is_new );
+
+    vector<bool> is_given_vec( leaf_no+1, false );
+    unsigned given_no = 0;
+    bool is_same_taps = true;
+
+    for( string_view token = tokenizer.NextToken(); !token.empty() && is_same_taps; token = tokenizer.NextToken() )
+    {
+	const unsigned tap_id = rc_node_name_table.Find(token);
+	is_same_taps = ( tap_id != NameTable::NOT_FOUND && tap_id > 0 && !is_given_vec[tap_id] );
+
+	if( is_same_taps )
+	{
+	    is_given_vec[tap_id] = true;
+	    ++given_no;
+	}
+    }
+
+    if( !is_same_taps || given_no != leaf_no )
+    {
+	printf( "Error: wire %s is replaced with other taps\n", string(GetPinNodeName(*root_ptr)).c_str() );
+	exit(-1);
+    }
+
+    root_ptr->ClearFanoutRCTree();
+    root_ptr->_fanout_rc_tree_ptr = new RCTree;
+    RCTree &rc_tree = *(root_ptr->_fanout_rc_tree_ptr);
+
+    for( unsigned i=0; i<=leaf_no; ++i )
+	rc_tree.AddNode();
+
+    while( tokenizer.NextLine() )
+    {
+	const string_view word = tokenizer.NextToken();
+
+	if( word == "res" )
+	{
+	    const unsigned end1_id = root_ptr->GrabFanoutRCTreeNodeId( tokenizer.NextToken(), rc_node_name_table );
+	    const unsigned end2_id = root_ptr->GrabFanoutRCTreeNodeId( tokenizer.NextToken(), rc_node_name_table );
+	    rc_tree.AddRes( end1_id, end2_id, tokenizer.NextDouble() );
+	}
+	else if( word == "cap" )
+	{
+	    const unsigned end_id = root_ptr->GrabFanoutRCTreeNodeId( tokenizer.NextToken(), rc_node_name_table );
+	    rc_tree.SetCap( end_id, tokenizer.NextDouble() );
+	}
+	else
+	{
+	    printf( "Error: %s in the wire block of %s\n", string(word).c_str(), string(GetPinNodeName(*root_ptr)).c_str() );
+	    exit(-1);
+	}
+    }
+
+    rc_tree.KeepNodeNames( rc_node_name_table );
+    rc_tree.Flatten( leaf_no ); // so that it can be edited before the next timing update
+    _dirty_wire_root_id_vec.push_back( root_ptr->GetId() );
+
+    return;
+}
+
+// setup time constraints of all flip-flops change
+void Circuit::SetClockPeriod(const double &val)
+{
+    _clock_period = val;
+
+    if( !HasTimingGraph() )
+	return;
+
+    _is_clock_period_dirty = true;
+
+    for( unsigned i=0; i<_SeqGate_ptr_vec.size(); ++i )
+    {
+	Gate &ff_gate = *(_SeqGate_ptr_vec[i]);
+
+	for( unsigned j=0; j<ff_gate.GetInputNo(); ++j )
+	    if( j != ff_gate.GetClockPinId() && ff_gate.GetInputPinNode(j) != NULL )
+		MarkDirtyConstraint( *(ff_gate.GetInputPinNode(j)) );
+    }
+
+    return;
+}
+
+// of primary inputs, where the ones of other pin nodes are overwritten by STA
+void Circuit::SetArrivalTime( PinNode *pnode_ptr, const double &fast_fall, const double &slow_fall, const double &fast_rise, 
+	                      const double &slow_rise )
+{
+    const unsigned id = pnode_ptr->GetId();
+    _timing_store.SetArrTime( TimingStore::FAST_FALL, id, fast_fall );
+    _timing_store.SetArrTime( TimingStore::SLOW_FALL, id, slow_fall );
+    _timing_store.SetArrTime( TimingStore::FAST_RISE, id, fast_rise );
+    _timing_store.SetArrTime( TimingStore::SLOW_RISE, id, slow_rise );
+
+    if( HasTimingGraph() )
+	MarkDirtySource( *pnode_ptr );
+
+    return;
+}
+
+void Circuit::SetSlew( PinNode *pnode_ptr, const double &fall, const double &rise )
+{
+    const unsigned id = pnode_ptr->GetId();
+    _timing_store.SetSlew( TimingStore::FAST_FALL, id, fall );
+    _timing_store.SetSlew( TimingStore::FAST_RISE, id, rise );
+    _timing_store.SetSlew( TimingStore::SLOW_FALL, id, fall );
+    _timing_store.SetSlew( TimingStore::SLOW_RISE, id, rise );
+
+    if( HasTimingGraph() )
+	MarkDirtySource( *pnode_ptr );
+
+    return;
+}
+
+// the wire is propagated again, and so is its driving gate, which STA takes the arrival times and slews of its root from
+void Circuit::MarkDirtySource( const PinNode &pnode )
+{
+    if( _is_graph_stale ) // STA runs from scratch
+	return;
+
+    const unsigned root_id = getWireRootId( _timing_graph, pnode.GetId() );
+    const unsigned fanin = _timing_graph.GetFanin(root_id);
+    _dirty_wire_root_id_vec.push_back( root_id );
+
+    if( fanin == TimingGraph::NO_ID )
+	return;
+
+    const unsigned driver_id = _timing_graph.GetOutputGateId( TimingGraph::GetHandleId(fanin) );
+
+    if( _timing_graph.GetGatePtr(driver_id)->GetCellPtr() != NULL ) // not PI
+	_dirty_gate_id_vec.push_back( driver_id );
+
+    return;
+}
+
+void Circuit::MarkDirtyConstraint( const PinNode &pnode )
+{
+    if( _is_graph_stale ) // STA runs from scratch
+	return;
+
+    _dirty_req_root_id_vec.push_back( getWireRootId(_timing_graph, pnode.GetId()) );
+
+    return;
+}
+
+void Circuit::UpdateTiming()
+{
+    if( _is_graph_stale )
+    {
+	RebuildTiming();
+	return;
+    }
+
+    if( _dirty_gate_id_vec.empty() && _dirty_wire_root_id_vec.empty() && _dirty_req_root_id_vec.empty() )
+	return;
+
+    if( _dirty_gate_id_vec.empty() && _dirty_wire_root_id_vec.empty() && _is_clock_period_dirty )
+    {
+	ThreadPool serial_pool(1); // no thread is spawned
+	UpdateConstraints( serial_pool, 64, false ); // any chunk size, run in turn
+	return;
+    }
+
+    sort( _dirty_wire_root_id_vec.begin(), _dirty_wire_root_id_vec.end() );
+    _dirty_wire_root_id_vec.erase( unique(_dirty_wire_root_id_vec.begin(), _dirty_wire_root_id_vec.end()), 
+	                           _dirty_wire_root_id_vec.end() );
+
+    // new loads of the driving gates, and new wire delays and slew hats of the taps
+    for( unsigned i=0; i<_dirty_wire_root_id_vec.size(); ++i )
+    {
+	const unsigned root_id = _dirty_wire_root_id_vec[i];
+
+	if( _PinNode_ptr_vec[root_id]->GetFanoutRCTreePtr() == NULL ) // new source arrival times or slews only
+	    continue;
+
+	injectWiringEffects( _PinNode_ptr_vec[root_id] );
+	_timing_graph.UpdateWireData( *this, root_id );
+	const unsigned fanin = _timing_graph.GetFanin(root_id);
+
+	if( fanin == TimingGraph::NO_ID )
+	    continue;
+
+	const unsigned driver_id = _timing_graph.GetOutputGateId( TimingGraph::GetHandleId(fanin) );
+
+	if( _timing_graph.GetGatePtr(driver_id)->GetCellPtr() != NULL ) // not PI
+	    _dirty_gate_id_vec.push_back( driver_id );
+    }
+
+    runIncrementalSTA( *this, _dirty_gate_id_vec, _dirty_wire_root_id_vec, _dirty_req_root_id_vec, _retiming_tolerance );
+    _dirty_gate_id_vec.clear();
+    _dirty_wire_root_id_vec.clear();
+    _dirty_req_root_id_vec.clear();
+    _is_clock_period_dirty = false;
+
+    return;
+}
+
+// arrival times and slews are kept, see runConstraintSTA()
+void Circuit::UpdateConstraints(ThreadPool &thread_pool, const unsigned &chunk_size, const bool &is_push_backward)
+{
+    if( _is_graph_stale || !_dirty_gate_id_vec.empty() || !_dirty_wire_root_id_vec.empty() ) // new arrival times
+    {
+	UpdateTiming();
+	return;
+    }
+
+    if( _dirty_req_root_id_vec.empty() )
+	return;
+
+    runConstraintSTA( *this, thread_pool, chunk_size, is_push_backward );
+    _dirty_req_root_id_vec.clear();
+    _is_clock_period_dirty = false;
+
+    return;
+}
+
+// the loads of any wire may change by connectivity edits, and kept RC trees are flat already, so all wires are
+// injected again but the reduced ones; the visited counts and timing of the last STA are cleared for a new one,
+// so that a pin node no longer reached is left of initial timing as in a full STA
+void Circuit::RebuildTiming()
+{
+    injectWiringEffects( *this );
+    _timing_graph = TimingGraph();
+    BuildTimingGraph();
+
+    for( unsigned i=0; i<_PinNode_ptr_vec.size(); ++i )
+    {
+	PinNode &cur_pnode = *(_PinNode_ptr_vec[i]);
+	Element *fanin_ptr = cur_pnode._fanin_ptr;
+	cur_pnode._is_not_visited = true;
+
+	// given arrival times and slews are of primary inputs and undriven pin nodes
+	if( fanin_ptr != NULL && (fanin_ptr->GetType() == Element::PIN_NODE || 
+	    static_cast<GOutPin*>(fanin_ptr)->GetGatePtr()->GetCellPtr() != NULL) )
+	    _timing_store.ResetNode( i );
+    }
+
+    for( unsigned i=0; i<_timing_graph.GetGateNo(); ++i )
+    {
+	Gate &cur_gate = *(_timing_graph.GetGatePtr(i));
+	cur_gate._input_visited_count = 0;
+
+	for( unsigned j=0; j<cur_gate.GetOutputNo(); ++j )
+	    cur_gate.FetGOutPin(j).ResetVisitedCount();
+    }
+
+    _timing_store.ResetReqTimes();
+    ThreadPool serial_pool(1); // no thread is spawned
+    runSTA( *this, serial_pool, 64, false, false );
+
+    _dirty_gate_id_vec.clear();
+    _dirty_wire_root_id_vec.clear();
+    _dirty_req_root_id_vec.clear();
+    _is_graph_stale = false;
+    _is_clock_period_dirty = false;
+
+    return;
+}
+
+//-----------------------------------------------------------------------
+//    Define auxiliary functions
+//-----------------------------------------------------------------------
+
+// the same pin names in order, the same clock pin if clocked, and the same non-unate arcs of a combinational cell
+bool areCellsSwappable( const Cell &old_cell, const Cell &new_cell )
+{
+    if( old_cell.GetIsNonClocked() != new_cell.GetIsNonClocked() || old_cell.GetInputPinNo() != new_cell.GetInputPinNo() ||
+	old_cell.GetOutputPinNo() != new_cell.GetOutputPinNo() )
+	return false;
+
+    if( !old_cell.GetIsNonClocked() && old_cell.GetClockPinId() != new_cell.GetClockPinId() )
+	return false;
+
+    for( unsigned i=0; i<old_cell.GetInputPinNo(); ++i )
+	if( old_cell.GetInputPinName(i) != new_cell.GetInputPinName(i) )
+	    return false;
+
+    for( unsigned i=0; i<old_cell.GetOutputPinNo(); ++i )
+	if( old_cell.GetOutputPinName(i) != new_cell.GetOutputPinName(i) )
+	    return false;
+
+    if( !old_cell.GetIsNonClocked() ) // no arc delay recorded
+	return true;
+
+    const vector<vector<InputTimingTable> > &old_timing_vec = old_cell.FetInputTimingVec();
+    const vector<vector<InputTimingTable> > &new_timing_vec = new_cell.FetInputTimingVec();
+
+    // a non-unate arc takes more slots of the arc-delay table
+    for( unsigned i=0; i<old_cell.GetInputPinNo(); ++i )
+	for( unsigned j=0; j<old_cell.GetOutputPinNo(); ++j )
+	    if( (old_timing_vec[i][j].PinTimingSense == InputTimingTable::NON_UNATE) !=
+		(new_timing_vec[i][j].PinTimingSense == InputTimingTable::NON_UNATE) )
+		return false;
+
+    return true;
+}
+
+RCTree& fetKeptRCTree( const Circuit &circuit, PinNode *root_ptr )
+{
+    assert( root_ptr != NULL );
+
+    if( !circuit.HasTimingGraph() || root_ptr->GetFanoutRCTreePtr() == NULL || !root_ptr->GetFanoutRCTreePtr()->HasNodeNames() )
+    {
+	printf( "Error: RC tree of wire %s is edited before STA, or is not kept\n", string(circuit.GetPinNodeName(*root_ptr)).c_str() );
+	exit(-1);
+    }
+
+    assert( root_ptr->GetFanoutRCTreePtr()->IsFlat() );
+
+    return *(root_ptr->GetFanoutRCTreePtr());
+}
+
+unsigned findRCTreePos( const Circuit &circuit, const RCTree &rc_tree, const PinNode &root_pnode, string_view node_name )
+{
+    const unsigned pos = rc_tree.FindPos(node_name);
+
+    if( pos == RCTree::NO_POS )
+    {
+	printf( "Error: no node %s on wire %s\n", string(node_name).c_str(), string(circuit.GetPinNodeName(root_pnode)).c_str() );
+	exit(-1);
+    }
+
+    return pos;
+}
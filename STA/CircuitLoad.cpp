@@ -1,5 +1,14 @@
 /************************************************************************
- *   Define member functions of class Circuit: Initialization()
+ *   Define member functions of class Circuit: Initialization(),
+ *   LoadConstraints(), and the connectivity edits after STA, which add
+ *   gates and wires the same way as they are loaded: InsertGate(),
+ *   RemoveGate(), InsertWire(), RemoveWire(), ConnectPin(),
+ *   DisconnectPin()
+ *
+ *   A connectivity edit leaves the timing graph stale, so the next
+ *   UpdateTiming() injects wiring effects, builds the graph and runs
+ *   STA from scratch. Removed gates stay in the gate arena, and pin
+ *   nodes left unconnected stay in the circuit.
  *
  *   Author      : Kuan-Hsien Ho
 ************************************************************************/
@@ -7,15 +16,19 @@
 #include <algorithm>
 #include <cstdio>
 #include <cstdlib>
-#include <cstring>
-#include <map>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "Cell.h"
 #include "CellLibrary.h"
 #include "Circuit.h"
+#include "Gate.h"
+#include "MappedFile.h"
 #include "parameterDefine.h"
 #include "PinNode.h"
+#include "RCTree.h"
+#include "process.h"
 
 using namespace std;
 
@@ -25,29 +38,78 @@ using namespace std;
 
 bool cmpCellPtrNameSort( Cell *a_ptr, Cell *b_ptr );
 
+bool cmpCellPtrName( Cell *a_ptr, string_view name );
+
 void genSortedCellPtrVec( const CellLibrary &cell_library, vector<Cell*> &cell_ptr_vec );
 
-bool isReservedWord( char *reserved_word ); // debug-only
+bool isReservedWord( string_view reserved_word ); // debug-only
 
 //-----------------------------------------------------------------------
 //    Define member functions
 //-----------------------------------------------------------------------
 
-inline void Circuit::LoadPrimaryInput( FILE *inf_ptr, const char *node_name, map<string, PinNode*> &pin_node_map )
+// get pin node pointer by name if exists; if not, new a pin node and return it
+inline PinNode* Circuit::GrabPinNodePtr( string_view node_name )
+{
+    bool is_new;
+    const unsigned id = _pin_node_name_table.Grab( node_name, is_new ); // single probe for both find and insert
+
+    if( !is_new )
+	return _PinNode_ptr_vec[id];
+
+    assert( id == _PinNode_ptr_vec.size() && id == _timing_store.GetNodeNo() ); // ids are dense
+    _timing_store.AddNode();
+    PinNode *pin_node_ptr = _pin_node_arena.Create(id);
+    _PinNode_ptr_vec.push_back(pin_node_ptr);
+
+    return pin_node_ptr;
+}
+
+// a wire reduced while loading has lost its RC tree, so its loads cannot include a fanout added later;
+// after STA, kept RC trees are flat but not reduced, see CheckWireKept()
+inline void Circuit::CheckNotOnReducedWire( const PinNode &pnode ) const
 {
-    map<string, PinNode*>::iterator mapIter = pin_node_map.find(node_name);
-    PinNode *pin_node_ptr;
+    if( !_has_reduced_wire || HasTimingGraph() )
+	return;
 
-    if( mapIter == pin_node_map.end() )
+    Element *fanin_ptr = pnode._fanin_ptr;
+    const PinNode *root_ptr = (fanin_ptr != NULL && fanin_ptr->GetType() == Element::PIN_NODE)? 
+	                      static_cast<const PinNode*>(fanin_ptr): &pnode;
+
+    // a kept RC tree is flat once reduced
+    if( root_ptr->_fanout_pin_node_no > 0 && (root_ptr->_fanout_rc_tree_ptr == NULL || root_ptr->_fanout_rc_tree_ptr->IsFlat()) )
     {
-	pin_node_ptr = new PinNode(node_name);
-	_PinNode_ptr_vec.push_back(pin_node_ptr);
-	pin_node_map[node_name] = pin_node_ptr; // insert to map
+	printf( "Error: pin node %s is connected after its wire is reduced; do not stream wires for this netlist\n", 
+		string(GetPinNodeName(pnode)).c_str() );
+	printf( "  Exiting...\n" );
+	exit(-1);
     }
-    else
-	pin_node_ptr = (*mapIter).second;
 
-    Gate *gate_ptr = new Gate(); // new a gate as primary input
+    return;
+}
+
+inline void Circuit::ConnectInputPin( Gate &gate, const unsigned &pin_id, PinNode &pnode )
+{
+    (gate._input_vec)[pin_id].SetFaninPtr( &pnode );
+    pnode._fanout_ptr_vec.push_back( &((gate._input_vec)[pin_id]) ); // a pin node may drive multiples 
+
+    return;
+}
+
+inline void Circuit::ConnectOutputPin( Gate &gate, const unsigned &pin_id, PinNode &pnode )
+{
+    (gate._output_vec)[pin_id].SetFanoutPtr( &pnode );
+    assert( pnode._fanin_ptr == NULL );
+    pnode._fanin_ptr = &((gate._output_vec)[pin_id]);
+
+    return;
+}
+
+inline void Circuit::LoadPrimaryInput( string_view node_name )
+{
+    PinNode *pin_node_ptr = GrabPinNodePtr( node_name );
+
+    Gate *gate_ptr = _gate_arena.Create(); // new a gate as primary input
     (*gate_ptr)._output_vec.push_back( GOutPin(0, gate_ptr, pin_node_ptr) );
     assert( (*gate_ptr)._output_vec.size() == 1 );
     pin_node_ptr->_fanin_ptr = &(((*gate_ptr)._output_vec)[0]);
@@ -56,21 +118,12 @@ inline void Circuit::LoadPrimaryInput( FILE *inf_ptr, const char *node_name, map
     return;
 }
 
-inline void Circuit::LoadPrimaryOutput( FILE *inf_ptr, const char *node_name, map<string, PinNode*> &pin_node_map )
+inline void Circuit::LoadPrimaryOutput( string_view node_name )
 {
-    map<string, PinNode*>::iterator mapIter = pin_node_map.find(node_name);
-    PinNode *pin_node_ptr;
-
-    if( mapIter == pin_node_map.end() )
-    {
-        pin_node_ptr = new PinNode(node_name);
-	_PinNode_ptr_vec.push_back(pin_node_ptr);
-	pin_node_map[node_name] = pin_node_ptr; // insert to map
-    }
-    else
-	pin_node_ptr = (*mapIter).second;
+    PinNode *pin_node_ptr = GrabPinNodePtr( node_name );
+    CheckNotOnReducedWire( *pin_node_ptr );
 
-    Gate *gate_ptr = new Gate(); // new a gate as primary output
+    Gate *gate_ptr = _gate_arena.Create(); // new a gate as primary output
     (*gate_ptr)._input_vec.push_back( GInPin(0, gate_ptr, pin_node_ptr) );
     assert( (*gate_ptr)._input_vec.size() == 1 );
     pin_node_ptr->_fanout_ptr_vec.push_back( &(((*gate_ptr)._input_vec)[0]) );
@@ -79,47 +132,34 @@ inline void Circuit::LoadPrimaryOutput( FILE *inf_ptr, const char *node_name, ma
     return;
 }
 
-inline void Circuit::LoadInstance( FILE *inf_ptr, map<string, PinNode*> &pin_node_map, char *pos_ptr, Cell *cur_cell_ptr )
+inline void Circuit::LoadInstance( LineTokenizer &tokenizer, Cell *cur_cell_ptr )
 {
-    char *token_ptr = static_cast<char *>(strtok_r(NULL, " ", &pos_ptr)); 
-    Gate *gate_ptr = new Gate(cur_cell_ptr);
+    string_view token = tokenizer.NextToken(); 
+    Gate *gate_ptr = _gate_arena.Create(cur_cell_ptr);
 
-    while( token_ptr != NULL )
+    while( !token.empty() )
     {
-	string cur_str = token_ptr;
-	const size_t pos = cur_str.find(':');
-	const string cur_name = cur_str.substr(0, pos); // pin name in cur_name
-	cur_str = cur_str.substr(pos+1);                // node name in cur_str
-	map<string, PinNode*>::iterator mapIter = pin_node_map.find(cur_str);
-	PinNode *pin_node_ptr = NULL;
-
-	if( mapIter == pin_node_map.end() )
-	{
-	    pin_node_ptr = new PinNode(cur_str);
-	    _PinNode_ptr_vec.push_back(pin_node_ptr);
-	    pin_node_map[cur_str] = pin_node_ptr;
-	}
-	else
-	    pin_node_ptr = (*mapIter).second;
+	const size_t pos = token.find(':');
+	assert( pos != string_view::npos );
+	const string_view cur_name = token.substr(0, pos); // pin name in cur_name
+	PinNode *pin_node_ptr = GrabPinNodePtr( token.substr(pos+1) ); // node name after ':'
 
 	int pin_id = cur_cell_ptr->GetInputPinId(cur_name);
 	assert( pin_id >= 0 || pin_id == -1 );
 
 	if( pin_id >= 0 ) // input pin
 	{
-	    (gate_ptr->_input_vec)[pin_id].SetFaninPtr(pin_node_ptr);
-	    pin_node_ptr->_fanout_ptr_vec.push_back( &((gate_ptr->_input_vec)[pin_id]) ); // a pin node may drive multiples 
+	    CheckNotOnReducedWire( *pin_node_ptr );
+	    ConnectInputPin( *gate_ptr, pin_id, *pin_node_ptr );
 	}
 	else // output pin
 	{ 
 	    pin_id = cur_cell_ptr->GetOutputPinId(cur_name);
 	    assert( pin_id >= 0 );
-	    (gate_ptr->_output_vec)[pin_id].SetFanoutPtr(pin_node_ptr);
-	    assert( pin_node_ptr->_fanin_ptr == NULL );
-	    pin_node_ptr->_fanin_ptr = &((gate_ptr->_output_vec)[pin_id]);
+	    ConnectOutputPin( *gate_ptr, pin_id, *pin_node_ptr );
 	}
 
-	token_ptr = static_cast<char *>(strtok_r(NULL, " ", &pos_ptr));
+	token = tokenizer.NextToken();
     } // end while
 
     if( cur_cell_ptr->GetIsNonClocked() ) // combinational
@@ -136,158 +176,190 @@ inline void Circuit::LoadInstance( FILE *inf_ptr, map<string, PinNode*> &pin_nod
     return;
 }
 
-inline bool Circuit::LoadWire( FILE *inf_ptr, map<string, PinNode*> &pin_node_map, char **posPtr_ptr, char **reservedWord_ptr )
+// return true if end of file; otherwise, the first word of the line next to the wire section is in reserved_word
+// rc_node_name_table is the name index of the RC tree of this wire only, and is reset for every wire
+// in streaming mode, the wire is reduced and its RC tree freed, unless kept, here if its driver is known and
+// every tap already drives its gates;
+// otherwise, it is left to injectWiringEffects() as in the normal mode
+inline bool Circuit::LoadWire( LineTokenizer &tokenizer, NameTable &rc_node_name_table, string_view &reserved_word )
 {
-    char *pos_ptr = *(posPtr_ptr);
-    char *token_ptr = static_cast<char *>(strtok_r(NULL, " ", &pos_ptr)); // get root name
-
-    map<string, PinNode*>::iterator mapIter = pin_node_map.find(token_ptr);
-    PinNode* root_ptr;
-
-    if( mapIter != pin_node_map.end() )
-    {
-	root_ptr = (*mapIter).second;
-	assert( ((*mapIter).second)->_fanin_ptr != NULL && (((*mapIter).second)->_fanout_ptr_vec).size() == 0 );
-    }
-    else
-    {
-	root_ptr = new PinNode(token_ptr);
-	_PinNode_ptr_vec.push_back(root_ptr);
-	pin_node_map[token_ptr] = root_ptr;
-    }
-
-    vector<RCTreeNode> &rc_tree = root_ptr->_fanout_rc_tree;
-    assert( rc_tree.size() == 0 );
-    rc_tree.push_back( RCTreeNode(root_ptr->_name, root_ptr) );
-    token_ptr = static_cast<char *>(strtok_r(NULL, " ", &pos_ptr));
-
-    while( token_ptr != NULL ) // get tap nodes
+    PinNode* root_ptr = GrabPinNodePtr( tokenizer.NextToken() ); // get root
+    assert( root_ptr->_fanin_ptr != NULL && (root_ptr->_fanout_ptr_vec).size() == 0 );
+
+    assert( root_ptr->_fanout_rc_tree_ptr == NULL );
+    root_ptr->_fanout_rc_tree_ptr = new RCTree;
+    RCTree &rc_tree = *(root_ptr->_fanout_rc_tree_ptr);
+    rc_node_name_table.Reset();
+    bool is_new;
+    rc_tree.AddNode();
+    rc_node_name_table.Grab( GetPinNodeName(*root_ptr), is_new ); // id 0
+    string_view token = tokenizer.NextToken();
+
+    while( !token.empty() ) // get tap nodes
     {
-	mapIter = pin_node_map.find(token_ptr);
+	const unsigned tap_id = rc_node_name_table.Grab( token, is_new ); // same id as in rc_tree
 
-	if( mapIter != pin_node_map.end() )
-	{
-	    PinNode *pin_node_ptr = (*mapIter).second;
-	    assert( pin_node_ptr->_fanin_ptr == NULL && (pin_node_ptr->_fanout_ptr_vec).size() == 1 );
-	    pin_node_ptr->_fanin_ptr = root_ptr;
-	    (root_ptr->_fanout_ptr_vec).push_back(pin_node_ptr);
-	    rc_tree.push_back( RCTreeNode( pin_node_ptr->_name, pin_node_ptr ) );
-	}
-	else
+	if( !is_new || tap_id != rc_tree.GetNodeNo() )
 	{
-	    PinNode *pin_node_ptr = new PinNode(token_ptr);
-	    _PinNode_ptr_vec.push_back(pin_node_ptr);
-	    pin_node_map[token_ptr] = pin_node_ptr;
-	    pin_node_ptr->_fanin_ptr = root_ptr;
-	    (root_ptr->_fanout_ptr_vec).push_back(pin_node_ptr);
-	    rc_tree.push_back( RCTreeNode( token_ptr, pin_node_ptr ) );
+	    printf( "Error: pin node %s is listed twice on wire %s\n", string(token).c_str(), 
+		    string(GetPinNodeName(*root_ptr)).c_str() );
+	    printf( "  Exiting...\n" );
+	    exit(-1);
 	}
 
-	token_ptr = static_cast<char *>(strtok_r(NULL, " ", &pos_ptr));
+	PinNode *pin_node_ptr = GrabPinNodePtr( token );
+	assert( pin_node_ptr->_fanin_ptr == NULL && (pin_node_ptr->_fanout_ptr_vec).size() <= 1 );
+	pin_node_ptr->_fanin_ptr = root_ptr;
+	(root_ptr->_fanout_ptr_vec).push_back(pin_node_ptr);
+	rc_tree.AddNode();
+
+	token = tokenizer.NextToken();
     }
 
-    (root_ptr->_fanout_pin_node_no) = rc_tree.size()-1; // record number of leaf pin nodes for very special case
-    assert( (1 + (root_ptr->_fanout_ptr_vec).size()) == rc_tree.size() ); 
-    char line[LINE_LEN];
+    (root_ptr->_fanout_pin_node_no) = rc_tree.GetNodeNo()-1; // record number of leaf pin nodes for very special case
+    assert( (1 + (root_ptr->_fanout_ptr_vec).size()) == rc_tree.GetNodeNo() ); 
+
+    bool is_eof = false;
 
     do
     {
-	unsigned length = 1;
-
-	do
+	if( !tokenizer.NextLine() ) // get next line
 	{
-	    if( fgets(line, LINE_LEN, inf_ptr) != NULL ) // get next line
-		length = strlen(line);
-	    else
-		return true; // end of file
-	} while( length == 1 );
+	    is_eof = true;
+	    break;
+	}
 
-	pos_ptr = NULL;
-	line[length-1] = '\0';
-	char *reserved_word = static_cast<char *>(strtok_r(line, " ", &pos_ptr));
+	const string_view word = tokenizer.NextToken();
 
-	if( *(reserved_word+1) == 'e' )
+	if( word == "res" )
 	{
-	    unsigned end1_id = root_ptr->GrabFanoutRCTreeNodeId(static_cast<char *>(strtok_r(NULL, " ", &pos_ptr)));
-	    unsigned end2_id = root_ptr->GrabFanoutRCTreeNodeId(static_cast<char *>(strtok_r(NULL, " ", &pos_ptr)));
-	    double resistance = atof(static_cast<char *>(strtok_r(NULL, " ", &pos_ptr)));
-	    // double link, but we will decompose them to fanin, fanout sets after injecting wiring effects later
-	    rc_tree[end1_id]._fanout_id_res_list.push_back( pair<unsigned, double>(end2_id, resistance) );
-	    rc_tree[end2_id]._fanout_id_res_list.push_back( pair<unsigned, double>(end1_id, resistance) );
+	    unsigned end1_id = root_ptr->GrabFanoutRCTreeNodeId( tokenizer.NextToken(), rc_node_name_table );
+	    unsigned end2_id = root_ptr->GrabFanoutRCTreeNodeId( tokenizer.NextToken(), rc_node_name_table );
+	    // undirected, but we will orient it from the root when flattening the tree later
+	    rc_tree.AddRes( end1_id, end2_id, tokenizer.NextDouble() );
 	}
-	else if( *(reserved_word) == 'c' && *(reserved_word+1) == 'a' )
+	else if( word == "cap" )
 	{
-	    string end_name = static_cast<char *>(strtok_r(NULL, " ", &pos_ptr));
-	    double capacitance = atof(static_cast<char *>(strtok_r(NULL, " ", &pos_ptr)));
-	    const unsigned end_id = root_ptr->GrabFanoutRCTreeNodeId( end_name );
-	    (rc_tree[end_id]._cap) = capacitance;
+	    const unsigned end_id = root_ptr->GrabFanoutRCTreeNodeId( tokenizer.NextToken(), rc_node_name_table );
+	    rc_tree.SetCap( end_id, tokenizer.NextDouble() );
 	}
 	else
 	{
-	    *(posPtr_ptr) = pos_ptr;
-	    *(reservedWord_ptr) = reserved_word;
-	    return false;
+	    reserved_word = word;
+	    break;
 	}
     } while(true);
 
-    return false;
+    if( _is_keeping_rc_trees && (_kept_root_name_table_ptr == NULL || 
+	_kept_root_name_table_ptr->Find(GetPinNodeName(*root_ptr)) != NameTable::NOT_FOUND) )
+	rc_tree.KeepNodeNames( rc_node_name_table ); // so that injectWiringEffects() does not free it
+
+    if( _is_streaming_wires )
+    {
+	bool is_connected = (root_ptr->_fanin_ptr != NULL); // driving gate may be given after the wire
+
+	for( unsigned i=0; i<(root_ptr->_fanout_ptr_vec).size() && is_connected; ++i )
+	    is_connected = (static_cast<PinNode*>((root_ptr->_fanout_ptr_vec)[i])->_fanout_ptr_vec.size() > 0);
+
+	if( is_connected )
+	{
+	    injectWiringEffects( root_ptr ); // frees the RC tree
+	    _has_reduced_wire = true;
+	}
+    }
+
+    return is_eof;
 }
 
-void Circuit::LoadRATData( map<string, PinNode*> &pin_node_map, char *pos_ptr )
+inline void Circuit::LoadSlew( LineTokenizer &tokenizer )
 {
-    char *node_name = static_cast<char *>(strtok_r(NULL, " ", &pos_ptr));
-    map<string, PinNode*>::iterator mapIter = pin_node_map.find(node_name);
-    PinNode* pnode_ptr;
+    PinNode *pin_node_ptr = GrabPinNodePtr( tokenizer.NextToken() ); // node name
+    const double fall_slew = tokenizer.NextDouble();
+    const double rise_slew = tokenizer.NextDouble();
 
-    if( mapIter != pin_node_map.end() )
-	pnode_ptr = (*mapIter).second;
-    else
-    {
-	pnode_ptr = new PinNode(node_name);
-	_PinNode_ptr_vec.push_back(pnode_ptr);
-	pin_node_map[node_name] = pnode_ptr;
-    }
+    SetSlew( pin_node_ptr, fall_slew, rise_slew );
 
-    char *mode = static_cast<char *>(strtok_r(NULL, " ", &pos_ptr));
-    assert( !strcmp(mode, "early") || !strcmp(mode, "late") );
-    double required_fall_time = atof(static_cast<char *>(strtok_r(NULL, " ", &pos_ptr)));
-    double required_rise_time = atof(static_cast<char *>(strtok_r(NULL, " ", &pos_ptr)));
+    return;
+}
 
-    if( (*mode) == 'e' )
+inline void Circuit::LoadArrivalTime( LineTokenizer &tokenizer )
+{
+    PinNode *pin_node_ptr = GrabPinNodePtr( tokenizer.NextToken() ); // node name
+    const double fast_fall_time = tokenizer.NextDouble();
+    const double slow_fall_time = tokenizer.NextDouble();
+    const double fast_rise_time = tokenizer.NextDouble();
+    const double slow_rise_time = tokenizer.NextDouble();
+
+    SetArrivalTime( pin_node_ptr, fast_fall_time, slow_fall_time, fast_rise_time, slow_rise_time );
+
+    return;
+}
+
+inline void Circuit::LoadClock( LineTokenizer &tokenizer )
+{
+    _clock_ptr = GrabPinNodePtr( tokenizer.NextToken() ); // node name
+    _clock_period = tokenizer.NextDouble();
+
+    return;
+}
+
+void Circuit::LoadRATData( LineTokenizer &tokenizer )
+{
+    PinNode* pnode_ptr = GrabPinNodePtr( tokenizer.NextToken() );
+    const string_view mode = tokenizer.NextToken();
+    assert( mode == "early" || mode == "late" );
+    const double required_fall_time = tokenizer.NextDouble();
+    const double required_rise_time = tokenizer.NextDouble();
+
+    // a pin node has at most one early and one late constraint in a netlist
+    assert( GetRATDataId(*pnode_ptr) == RATData::NO_DATA || 
+	    _RATData_vec[GetRATDataId(*pnode_ptr)].Mode == ((mode[0] == 'e')? RATData::SLOW: RATData::FAST) );
+    SetRATData( pnode_ptr, (mode[0] == 'e')? RATData::FAST: RATData::SLOW, required_fall_time, required_rise_time );
+
+    return;
+}
+
+void Circuit::SetRATData( PinNode *pnode_ptr, const RATData::ModeType &mode, const double &fall_time, const double &rise_time )
+{
+    assert( mode == RATData::FAST || mode == RATData::SLOW );
+
+    if( _RATData_id_vec.size() <= pnode_ptr->GetId() ) // index constraints by pin-node id to merge in constant time
+	_RATData_id_vec.resize( _PinNode_ptr_vec.size(), RATData::NO_DATA );
+
+    unsigned &rat_id = _RATData_id_vec[pnode_ptr->GetId()];
+
+    if( rat_id == RATData::NO_DATA )
     {
-	vector<RATData>::iterator vecIter=_RATData_vec.begin();
-
-        for( ; vecIter!=_RATData_vec.end(); ++vecIter )
-	    if( pnode_ptr == (*vecIter).PinNodePtr ) // same address, i.e., same pin node
-	    {
-		assert( (*vecIter).Mode == RATData::SLOW );
-		(*vecIter).Mode = RATData::BOTH;
-		(*vecIter).FastFallTime = required_fall_time;
-		(*vecIter).FastRiseTime = required_rise_time;
-		break;
-	    }
+	rat_id = _RATData_vec.size();
 
-	if( vecIter == _RATData_vec.end() )
-	    _RATData_vec.push_back( RATData(pnode_ptr, RATData::FAST, 0.0, 0.0, required_fall_time, required_rise_time) );
+	if( mode == RATData::FAST )
+	    _RATData_vec.push_back( RATData(pnode_ptr, RATData::FAST, 0.0, 0.0, fall_time, rise_time) );
+	else
+	    _RATData_vec.push_back( RATData(pnode_ptr, RATData::SLOW, fall_time, rise_time, 0.0, 0.0) );
     }
     else
     {
-	vector<RATData>::iterator vecIter=_RATData_vec.begin();
-
-        for( ; vecIter!=_RATData_vec.end(); ++vecIter )
-	    if( pnode_ptr == (*vecIter).PinNodePtr ) // same address, i.e., same pin node
-	    {
-		assert( (*vecIter).Mode == RATData::FAST );
-		(*vecIter).Mode = RATData::BOTH;
-		(*vecIter).SlowFallTime = required_fall_time;
-		(*vecIter).SlowRiseTime = required_rise_time;
-		break;
-	    }
+	RATData &rat_data = _RATData_vec[rat_id]; // same pin node
+	assert( rat_data.PinNodePtr == pnode_ptr );
 
-	if( vecIter == _RATData_vec.end() )
-	    _RATData_vec.push_back( RATData(pnode_ptr, RATData::SLOW, required_fall_time, required_rise_time, 0.0, 0.0) );
+	if( rat_data.Mode != mode )
+	    rat_data.Mode = RATData::BOTH;
+
+	if( mode == RATData::FAST )
+	{
+	    rat_data.FastFallTime = fall_time;
+	    rat_data.FastRiseTime = rise_time;
+	}
+	else
+	{
+	    rat_data.SlowFallTime = fall_time;
+	    rat_data.SlowRiseTime = rise_time;
+	}
     }
 
+    if( HasTimingGraph() )
+	MarkDirtyConstraint( *pnode_ptr );
+
     return;
 }
 
@@ -295,64 +367,40 @@ void Circuit::LoadRATData( map<string, PinNode*> &pin_node_map, char *pos_ptr )
 // a circuit must contain at least an instance, a wire, an at setting; list of <pin name>:<node> must be in a line
 void Circuit::Initialize( const char *file_name, const CellLibrary &cell_library )
 {
-    FILE *inf_ptr = fopen( file_name, "r" );  
+    MappedFile inf( file_name );    // map the whole netlist, exit if failed
+    LineTokenizer tokenizer( inf ); // tokens are views into the mapped file, no line is copied
 
-    if( inf_ptr == NULL )
-    {
-	printf( "Error in opening %s for input\n", file_name );
-	printf( "  Exiting...\n" );
-	exit(-1);
-    }
-
-    std::map<std::string, PinNode*> pin_node_map; // map pin node name and its pointer
-    vector<Cell*> cell_ptr_vec;                   // to efficiently link instances and cell pointers
+    vector<Cell*> cell_ptr_vec;     // to efficiently link instances and cell pointers
     genSortedCellPtrVec( cell_library, cell_ptr_vec );
-    Cell *cur_cell_ptr = new Cell();              // variables for instance parsing
-    char line[LINE_LEN];
 
-    {
-	unsigned length = 1;
+    NameTable rc_node_name_table;   // per-wire RC-node name index, dropped once the netlist is loaded
 
-	do
-	{
-	    if( fgets(line, LINE_LEN, inf_ptr) != NULL ) // get next line
-		length = strlen(line);
-	    else
-	    {
-		fclose(inf_ptr);
-		return;
-	    }
-	} while( length == 1 );
-
-	line[length-1] = '\0';
-    }
+    bool unEOF_flag = tokenizer.NextLine();
+    string_view reserved_word;
 
-    bool unEOF_flag = true;
-    char *pos_ptr = NULL;
-    char *reserved_word = static_cast<char *>(strtok_r(line, " ", &pos_ptr));
+    if( unEOF_flag )
+	reserved_word = tokenizer.NextToken();
 
     while( unEOF_flag )
     {
-	//printf( "%s\n", reserved_word );
 	assert( isReservedWord(reserved_word) );
 
-	switch( *(reserved_word) )
+	switch( reserved_word[0] )
 	{
 	    case 'i':
-		switch( *(reserved_word+2) )
+		switch( reserved_word[2] )
 		{
 		    case 'p': // input
-			    LoadPrimaryInput( inf_ptr, static_cast<char *>(strtok_r(NULL, " ", &pos_ptr)), pin_node_map );
+			    LoadPrimaryInput( tokenizer.NextToken() );
 			    break;
 		    case 's': // instance
 			{
-			    const char *inst_name = static_cast<char *>(strtok_r(NULL, " ", &pos_ptr));
-			    (*cur_cell_ptr).SetName(inst_name);
+			    const string_view inst_name = tokenizer.NextToken();
 			    vector<Cell*>::iterator cellPtrVecIter = lower_bound( cell_ptr_vec.begin(), cell_ptr_vec.end(), 
-				                                                  cur_cell_ptr, cmpCellPtrNameSort );
+				                                                  inst_name, cmpCellPtrName );
 			    assert( cellPtrVecIter != cell_ptr_vec.end() );
-			    assert( (**cellPtrVecIter).GetName() == (*cur_cell_ptr).GetName() );
-			    LoadInstance( inf_ptr, pin_node_map, pos_ptr, (*cellPtrVecIter) );
+			    assert( (**cellPtrVecIter).GetName() == inst_name );
+			    LoadInstance( tokenizer, (*cellPtrVecIter) );
 
 			    break;
 		        }
@@ -363,105 +411,324 @@ void Circuit::Initialize( const char *file_name, const CellLibrary &cell_library
 
 		break;
 	    case 'o': // output
-		LoadPrimaryOutput( inf_ptr, static_cast<char *>(strtok_r(NULL, " ", &pos_ptr)), pin_node_map );
+		LoadPrimaryOutput( tokenizer.NextToken() );
 		break;
 	    case 'w':
-		if( LoadWire( inf_ptr, pin_node_map, &pos_ptr, &reserved_word ) )
+		if( LoadWire( tokenizer, rc_node_name_table, reserved_word ) )
 		    unEOF_flag = false; // end of file
 
 		continue;
 	    case 's':
-		{
-		    string node_name = static_cast<char *>(strtok_r(NULL, " ", &pos_ptr));
-		    map<string, PinNode*>::iterator mapIter = pin_node_map.find(node_name); // node name
-		    PinNode *pin_node_ptr;
-
-                    if( mapIter != pin_node_map.end() )
-			pin_node_ptr = (*mapIter).second;
-		    else
-		    {
-			pin_node_ptr = new PinNode(node_name);
-			_PinNode_ptr_vec.push_back(pin_node_ptr);
-			pin_node_map[node_name] = pin_node_ptr;
-		    }
-
-		    pin_node_ptr->_fast_fall_slew = atof(static_cast<char *>(strtok_r(NULL, " ", &pos_ptr)));
-		    pin_node_ptr->_fast_rise_slew = atof(static_cast<char *>(strtok_r(NULL, " ", &pos_ptr)));
-		    pin_node_ptr->_slow_fall_slew = pin_node_ptr->_fast_fall_slew;
-		    pin_node_ptr->_slow_rise_slew = pin_node_ptr->_fast_rise_slew;
-
-		    break;
-		}
+		LoadSlew( tokenizer );
+		break;
 	    case 'a':
-		{
-		    string node_name = static_cast<char *>(strtok_r(NULL, " ", &pos_ptr));
-		    map<string, PinNode*>::iterator mapIter = pin_node_map.find(node_name); // node name
-		    PinNode *pin_node_ptr;
-
-                    if( mapIter != pin_node_map.end() )
-			pin_node_ptr = (*mapIter).second;
-		    else
-		    {
-			pin_node_ptr = new PinNode(node_name);
-			_PinNode_ptr_vec.push_back(pin_node_ptr);
-			pin_node_map[node_name] = pin_node_ptr;
-		    }
-
-		    pin_node_ptr->_fast_fall_arr_time = atof(static_cast<char *>(strtok_r(NULL, " ", &pos_ptr)));
-                    pin_node_ptr->_slow_fall_arr_time = atof(static_cast<char *>(strtok_r(NULL, " ", &pos_ptr)));
-		    pin_node_ptr->_fast_rise_arr_time = atof(static_cast<char *>(strtok_r(NULL, " ", &pos_ptr)));
-		    pin_node_ptr->_slow_rise_arr_time = atof(static_cast<char *>(strtok_r(NULL, " ", &pos_ptr)));
-
-		    break;
-		}
+		LoadArrivalTime( tokenizer );
+		break;
 	    case 'r':
-		LoadRATData(pin_node_map, pos_ptr);
+		LoadRATData( tokenizer );
 		break;
 	    case 'c':
-		{
-		    string node_name = static_cast<char *>(strtok_r(NULL, " ", &pos_ptr));
-		    map<string, PinNode*>::iterator mapIter = pin_node_map.find(node_name); // node name
-
-                    if( mapIter != pin_node_map.end() )
-			_clock_ptr = (*mapIter).second;
-		    else
-		    {
-			_clock_ptr = new PinNode(node_name);
-			_PinNode_ptr_vec.push_back(_clock_ptr);
-			pin_node_map[node_name] = _clock_ptr;
-		    }
-
-		    _clock_period = atof(static_cast<char *>(strtok_r(NULL, " ", &pos_ptr)));
-		    break;
-		}
+		LoadClock( tokenizer );
+		break;
 	    default:
 		assert(0);
 		break;
         }
 
-	unsigned length = 1;
+	unEOF_flag = tokenizer.NextLine(); // get next line
+
+	if( unEOF_flag )
+	    reserved_word = tokenizer.NextToken();
+    }
+
+    // set sequential circuit or not
+    _is_sequential = ( _SeqGate_ptr_vec.size() > 0 )? true: false;
+
+    return;
+}
+
+// parse at/slew/rat/clock lines only, for a circuit whose connectivity is already built, e.g., from a snapshot;
+// structural lines are skipped, so a complete netlist is accepted as well
+void Circuit::LoadConstraints( const char *file_name )
+{
+    MappedFile inf( file_name );    // map the whole file, exit if failed
+    LineTokenizer tokenizer( inf );
+
+    while( tokenizer.NextLine() )
+    {
+	const string_view word = tokenizer.NextToken();
+
+	if( word == "slew" )
+	    LoadSlew( tokenizer );
+	else if( word == "at" )
+	    LoadArrivalTime( tokenizer );
+	else if( word == "rat" )
+	    LoadRATData( tokenizer );
+	else if( word == "clock" )
+	    LoadClock( tokenizer );
+	else
+	    assert( isReservedWord(word) || word == "res" || word == "cap" );
+    }
+
+    return;
+}
+
+// a pin node of an instance line may be new, or be left unconnected by other edits
+void Circuit::InsertGate( LineTokenizer &tokenizer, Cell *cell_ptr )
+{
+    LineTokenizer pin_tokenizer = tokenizer; // check all pins before loading the instance
+
+    for( string_view token = pin_tokenizer.NextToken(); !token.empty(); token = pin_tokenizer.NextToken() )
+    {
+	const size_t pos = token.find(':');
+	const string_view pin_name = token.substr(0, pos);
 
-	do
+	if( pos == string_view::npos || (cell_ptr->GetInputPinId(pin_name) < 0 && cell_ptr->GetOutputPinId(pin_name) < 0) )
 	{
-	    if( fgets(line, LINE_LEN, inf_ptr) != NULL ) // get next line
-		length = strlen(line);
-	    else
-		unEOF_flag = false;
-	} while( length == 1 && unEOF_flag );
+	    printf( "Error: no pin %s of cell %s\n", string(token).c_str(), cell_ptr->GetName().c_str() );
+	    exit(-1);
+	}
 
-	if( unEOF_flag )
+	PinNode *pnode_ptr = FindPinNodePtr( token.substr(pos+1) );
+
+	if( pnode_ptr == NULL ) // new
+	    continue;
+
+	if( cell_ptr->GetInputPinId(pin_name) >= 0 )
+	    CheckInputPinNode( *pnode_ptr );
+	else
+	    CheckOutputPinNode( *pnode_ptr );
+    }
+
+    LoadInstance( tokenizer, cell_ptr );
+    _is_sequential = ( _SeqGate_ptr_vec.size() > 0 );
+    _is_graph_stale = true;
+
+    return;
+}
+
+void Circuit::RemoveGate( Gate *gate_ptr )
+{
+    assert( gate_ptr != NULL && gate_ptr->GetCellPtr() != NULL ); // neither PI nor PO
+
+    for( unsigned i=0; i<gate_ptr->GetOutputNo(); ++i )
+	if( gate_ptr->GetOutputPinNode(i) != NULL )
+	    DisconnectOutputPin( *gate_ptr, i );
+
+    for( unsigned i=0; i<gate_ptr->GetInputNo(); ++i )
+	if( gate_ptr->GetInputPinNode(i) != NULL )
+	    DisconnectInputPin( *gate_ptr, i );
+
+    vector<Gate*> &gate_ptr_vec = (gate_ptr->GetIsNonClocked())? _ComGate_ptr_vec: _SeqGate_ptr_vec;
+    gate_ptr_vec.erase( find(gate_ptr_vec.begin(), gate_ptr_vec.end(), gate_ptr) );
+    _is_sequential = ( _SeqGate_ptr_vec.size() > 0 );
+    _is_graph_stale = true;
+
+    return;
+}
+
+// the root must be driven by a gate and drive nothing yet, and a tap must be undriven and drive at most a gate pin;
+// the new RC tree is kept, the same as in ReplaceWire()
+bool Circuit::InsertWire( LineTokenizer &tokenizer, NameTable &rc_node_name_table, string_view &reserved_word )
+{
+    LineTokenizer wire_tokenizer = tokenizer; // check the root and taps before loading the wire
+    const string_view root_name = wire_tokenizer.NextToken();
+    PinNode *root_ptr = FindPinNodePtr( root_name );
+
+    if( root_ptr == NULL || root_ptr->_fanin_ptr == NULL || root_ptr->_fanin_ptr->GetType() != Element::GOUT_PIN || 
+	!root_ptr->_fanout_ptr_vec.empty() )
+    {
+	printf( "Error: wire %s is inserted on a pin node which is not driven by a gate, or drives something already\n", 
+		string(root_name).c_str() );
+	exit(-1);
+    }
+
+    for( string_view token = wire_tokenizer.NextToken(); !token.empty(); token = wire_tokenizer.NextToken() )
+    {
+	PinNode *tap_ptr = FindPinNodePtr( token );
+
+	if( tap_ptr != NULL && (tap_ptr->_fanin_ptr != NULL || tap_ptr->_fanout_ptr_vec.size() > 1) )
 	{
-	    line[length-1] = '\0';
-	    pos_ptr = NULL;
-	    reserved_word = static_cast<char *>(strtok_r(line, " ", &pos_ptr));
+	    printf( "Error: pin node %s of wire %s is driven already, or drives more than a gate pin\n", string(token).c_str(),
+		    string(root_name).c_str() );
+	    exit(-1);
 	}
     }
 
-    // set sequential circuit or not
-    _is_sequential = ( _SeqGate_ptr_vec.size() > 0 )? true: false;
+    const bool is_eof = LoadWire( tokenizer, rc_node_name_table, reserved_word );
+    RCTree &rc_tree = *(root_ptr->_fanout_rc_tree_ptr);
+
+    if( !rc_tree.HasNodeNames() )
+	rc_tree.KeepNodeNames( rc_node_name_table );
+
+    _is_graph_stale = true;
+
+    return is_eof;
+}
+
+// the loads of the driving gate are computed again with no wire
+void Circuit::RemoveWire( PinNode *root_ptr )
+{
+    const unsigned leaf_no = root_ptr->_fanout_pin_node_no;
+
+    if( leaf_no == 0 )
+    {
+	printf( "Error: pin node %s is not the root of a wire\n", string(GetPinNodeName(*root_ptr)).c_str() );
+	exit(-1);
+    }
 
-    delete cur_cell_ptr;
-    fclose(inf_ptr);
+    // taps are the first fanouts of the root, see LoadWire()
+    for( unsigned i=0; i<leaf_no; ++i )
+    {
+	PinNode &tap_pnode = *(static_cast<PinNode*>((root_ptr->_fanout_ptr_vec)[i]));
+	tap_pnode._fanin_ptr = NULL;
+	tap_pnode.SetFallSlewHatSq(0.0);
+	tap_pnode.SetRiseSlewHatSq(0.0);
+
+	for( unsigned j=0; j<tap_pnode.GetFanoutNo(); ++j )
+	{
+	    GInPin &gin_pin = *(static_cast<GInPin*>(tap_pnode.GetFanoutPtr(j)));
+	    gin_pin.SetFallArrDelay(0.0);
+	    gin_pin.SetRiseArrDelay(0.0);
+	}
+
+	_timing_store.ResetNode( tap_pnode.GetId() );
+    }
+
+    (root_ptr->_fanout_ptr_vec).erase( (root_ptr->_fanout_ptr_vec).begin(), (root_ptr->_fanout_ptr_vec).begin()+leaf_no );
+    root_ptr->_fanout_pin_node_no = 0;
+    root_ptr->ClearFanoutRCTree();
+    _is_graph_stale = true;
+
+    return;
+}
+
+// a pin of a gate which is connected to nothing
+void Circuit::ConnectPin( Gate *gate_ptr, string_view pin_name, PinNode *pnode_ptr )
+{
+    const Cell &cell = *(gate_ptr->GetCellPtr());
+    const int input_pin_id = cell.GetInputPinId(pin_name);
+    const int output_pin_id = cell.GetOutputPinId(pin_name);
+
+    if( input_pin_id >= 0 && gate_ptr->GetInputPinNode(input_pin_id) == NULL )
+    {
+	CheckInputPinNode( *pnode_ptr );
+	ConnectInputPin( *gate_ptr, input_pin_id, *pnode_ptr );
+    }
+    else if( output_pin_id >= 0 && gate_ptr->GetOutputPinNode(output_pin_id) == NULL )
+    {
+	CheckOutputPinNode( *pnode_ptr );
+	ConnectOutputPin( *gate_ptr, output_pin_id, *pnode_ptr );
+    }
+    else
+    {
+	printf( "Error: no pin %s of cell %s, or it is connected already\n", string(pin_name).c_str(), cell.GetName().c_str() );
+	exit(-1);
+    }
+
+    _is_graph_stale = true;
+
+    return;
+}
+
+void Circuit::DisconnectPin( Gate *gate_ptr, string_view pin_name )
+{
+    const Cell &cell = *(gate_ptr->GetCellPtr());
+    const int input_pin_id = cell.GetInputPinId(pin_name);
+    const int output_pin_id = cell.GetOutputPinId(pin_name);
+
+    if( input_pin_id >= 0 && gate_ptr->GetInputPinNode(input_pin_id) != NULL )
+	DisconnectInputPin( *gate_ptr, input_pin_id );
+    else if( output_pin_id >= 0 && gate_ptr->GetOutputPinNode(output_pin_id) != NULL )
+	DisconnectOutputPin( *gate_ptr, output_pin_id );
+    else
+    {
+	printf( "Error: no pin %s of cell %s, or it is connected to nothing\n", string(pin_name).c_str(), cell.GetName().c_str() );
+	exit(-1);
+    }
+
+    _is_graph_stale = true;
+
+    return;
+}
+
+// the root of the wire of a pin node, or the pin node itself if it is not a tap
+void Circuit::CheckWireKept( const PinNode &pnode, const string &edit ) const
+{
+    Element *fanin_ptr = pnode._fanin_ptr;
+    const PinNode *root_ptr = (fanin_ptr != NULL && fanin_ptr->GetType() == Element::PIN_NODE)? 
+	                      static_cast<const PinNode*>(fanin_ptr): &pnode;
+
+    if( root_ptr->_fanout_pin_node_no > 0 && root_ptr->_fanout_rc_tree_ptr == NULL )
+    {
+	printf( "Error: %s on wire %s, whose RC tree is not kept\n", edit.c_str(), string(GetPinNodeName(*root_ptr)).c_str() );
+	exit(-1);
+    }
+
+    return;
+}
+
+// a tap drives a gate pin at most, and a wire root drives its taps only
+void Circuit::CheckInputPinNode( PinNode &pnode ) const
+{
+    const bool is_tap = ( pnode._fanin_ptr != NULL && pnode._fanin_ptr->GetType() == Element::PIN_NODE );
+
+    if( pnode._fanout_pin_node_no > 0 || (is_tap && !pnode._fanout_ptr_vec.empty()) )
+    {
+	printf( "Error: pin node %s is the root of a wire, or a tap driving a gate pin already\n", 
+		string(GetPinNodeName(pnode)).c_str() );
+	exit(-1);
+    }
+
+    CheckWireKept( pnode, "pin node " + string(GetPinNodeName(pnode)) + " is connected" );
+
+    return;
+}
+
+void Circuit::CheckOutputPinNode( PinNode &pnode ) const
+{
+    if( pnode._fanin_ptr != NULL )
+    {
+	printf( "Error: pin node %s is driven already\n", string(GetPinNodeName(pnode)).c_str() );
+	exit(-1);
+    }
+
+    return;
+}
+
+// the loads of the wire are computed again without the pin
+void Circuit::DisconnectInputPin( Gate &gate, const unsigned &pin_id )
+{
+    GInPin &gin_pin = (gate._input_vec)[pin_id];
+    PinNode &pnode = *(gin_pin.GetFaninPtr());
+    CheckWireKept( pnode, "pin node " + string(GetPinNodeName(pnode)) + " is disconnected" );
+
+    vector<Element*> &fanout_ptr_vec = pnode._fanout_ptr_vec;
+    fanout_ptr_vec.erase( find(fanout_ptr_vec.begin(), fanout_ptr_vec.end(), static_cast<Element*>(&gin_pin)) );
+    gin_pin.SetFaninPtr(NULL);
+    gin_pin.SetFallArrDelay(0.0);
+    gin_pin.SetRiseArrDelay(0.0);
+
+    return;
+}
+
+// a wire has a driver, so the wire of the pin node is removed first
+void Circuit::DisconnectOutputPin( Gate &gate, const unsigned &pin_id )
+{
+    GOutPin &gout_pin = (gate._output_vec)[pin_id];
+    PinNode &pnode = *(gout_pin.GetFanoutPtr());
+
+    if( pnode._fanout_pin_node_no > 0 )
+    {
+	printf( "Error: pin node %s is disconnected before its wire is removed\n", string(GetPinNodeName(pnode)).c_str() );
+	exit(-1);
+    }
+
+    pnode._fanin_ptr = NULL;
+    gout_pin.SetFanoutPtr(NULL);
+    gout_pin.SetFallLoad(0.0);
+    gout_pin.SetRiseLoad(0.0);
+    _timing_store.ResetNode( pnode.GetId() );
 
     return;
 }
@@ -475,6 +742,11 @@ bool cmpCellPtrNameSort( Cell *a_ptr, Cell *b_ptr )
     return ( (*a_ptr).GetName() < (*b_ptr).GetName() );
 }
 
+bool cmpCellPtrName( Cell *a_ptr, string_view name ) 
+{ 
+    return ( (*a_ptr).GetName() < name );
+}
+
 void genSortedCellPtrVec( const CellLibrary &cell_library, vector<Cell*> &cell_ptr_vec )
 {
     cell_ptr_vec.resize( cell_library.GetCellNo() );
@@ -487,11 +759,11 @@ void genSortedCellPtrVec( const CellLibrary &cell_library, vector<Cell*> &cell_p
     return;
 }
 
-bool isReservedWord( char *reserved_word )
+bool isReservedWord( string_view reserved_word )
 {
-    if( !strcmp(reserved_word, "input") || !strcmp(reserved_word, "instance") || !strcmp(reserved_word, "output") ||
-	!strcmp(reserved_word, "wire") || !strcmp(reserved_word, "slew") || !strcmp(reserved_word, "at") ||
-	!strcmp(reserved_word, "rat") || !strcmp(reserved_word, "clock") )
+    if( reserved_word == "input" || reserved_word == "instance" || reserved_word == "output" ||
+	reserved_word == "wire" || reserved_word == "slew" || reserved_word == "at" ||
+	reserved_word == "rat" || reserved_word == "clock" )
 	return true;
     else
 	return false;
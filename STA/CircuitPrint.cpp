@@ -9,6 +9,8 @@
 #include <cstdlib>
 #include <iostream>
 #include <list>
+#include <string>
+#include <string_view>
 
 #include "Circuit.h"
 #include "PinNode.h"
@@ -20,7 +22,7 @@ using namespace std;
 //    Declare auxiliary functions 
 //-----------------------------------------------------------------------
 
-bool cmpPinNodePtrNameSort( PinNode *a_ptr, PinNode *b_ptr );
+void sortPinNodeIdsByName( const NameTable &pin_node_name_table, vector<unsigned> &pnode_id_vec );
 
 //-----------------------------------------------------------------------
 //    Define member functions
@@ -45,31 +47,31 @@ void Circuit::PrintCircuitData() const
     cout << "PI list:" << endl;
 
     for( unsigned i=0; i<_PI_ptr_vec.size(); ++i )
-	_PI_ptr_vec[i]->PrintGateData();
+	_PI_ptr_vec[i]->PrintGateData(_pin_node_name_table);
 
     cout << "PO list:" << endl;
 
     for( unsigned i=0; i<_PO_ptr_vec.size(); ++i )
-	_PO_ptr_vec[i]->PrintGateData();
+	_PO_ptr_vec[i]->PrintGateData(_pin_node_name_table);
 
     cout << "Com. gates:" << endl;
 
     for( unsigned i=0; i<_ComGate_ptr_vec.size(); ++i )
-	_ComGate_ptr_vec[i]->PrintGateData();
+	_ComGate_ptr_vec[i]->PrintGateData(_pin_node_name_table);
 
     if( _is_sequential )
     {
 	cout << "Seq. gates:" << endl;
 
 	for( unsigned i=0; i<_SeqGate_ptr_vec.size(); ++i )
-	    _SeqGate_ptr_vec[i]->PrintGateData();
+	    _SeqGate_ptr_vec[i]->PrintGateData(_pin_node_name_table);
     }
 
     for( unsigned i=0; i<_PinNode_ptr_vec.size(); ++i )
-        _PinNode_ptr_vec[i]->PrintPinNodeWiringData();
+        _PinNode_ptr_vec[i]->PrintPinNodeWiringData(_pin_node_name_table);
 
     for( unsigned i=0; i<_RATData_vec.size(); ++i )
-	_RATData_vec[i].PrintRATData();
+	_RATData_vec[i].PrintRATData(_pin_node_name_table);
 
     cout << "#.. Done circuit printing." << endl;
 
@@ -78,47 +80,58 @@ void Circuit::PrintCircuitData() const
 
 void Circuit::PrintTimingData() 
 {
+    UpdateTiming(); // queued edits
+
     const unsigned po_no = _PO_ptr_vec.size();
-    vector<PinNode*> PO_PinNode_ptr_vec;
-    PO_PinNode_ptr_vec.resize( po_no );
+    vector<unsigned> PO_pnode_id_vec;
+    PO_pnode_id_vec.resize( po_no );
 
     for( unsigned i=0; i<po_no; ++i )
-	PO_PinNode_ptr_vec[i] = _PO_ptr_vec[i]->GetInputPinNode(0);
+	PO_pnode_id_vec[i] = _PO_ptr_vec[i]->GetInputPinNode(0)->GetId();
 
-    sort( PO_PinNode_ptr_vec.begin(), PO_PinNode_ptr_vec.end(), cmpPinNodePtrNameSort );
+    sortPinNodeIdsByName( _pin_node_name_table, PO_pnode_id_vec );
 
     for( unsigned i=0; i<po_no; ++i )
     {
-	PinNode &cur_pnode = *(PO_PinNode_ptr_vec[i]);
-	printf( "at %s %.5le %.5le %.5le %.5le %.5le %.5le %.5le %.5le\n", cur_pnode.GetName().c_str(), 
-		cur_pnode.GetFastFallArrTime(), cur_pnode.GetFastRiseArrTime(), 
-		cur_pnode.GetSlowFallArrTime(), cur_pnode.GetSlowRiseArrTime(), 
-		cur_pnode.GetFastFallSlew(), cur_pnode.GetFastRiseSlew(), 
-		cur_pnode.GetSlowFallSlew(), cur_pnode.GetSlowRiseSlew() );
+	const unsigned id = PO_pnode_id_vec[i];
+	printf( "at %s %.5le %.5le %.5le %.5le %.5le %.5le %.5le %.5le\n", string(_pin_node_name_table.GetName(id)).c_str(), 
+		_timing_store.GetArrTime(TimingStore::FAST_FALL, id), _timing_store.GetArrTime(TimingStore::FAST_RISE, id), 
+		_timing_store.GetArrTime(TimingStore::SLOW_FALL, id), _timing_store.GetArrTime(TimingStore::SLOW_RISE, id), 
+		_timing_store.GetSlew(TimingStore::FAST_FALL, id), _timing_store.GetSlew(TimingStore::FAST_RISE, id), 
+		_timing_store.GetSlew(TimingStore::SLOW_FALL, id), _timing_store.GetSlew(TimingStore::SLOW_RISE, id) );
     }
 
     if( _is_sequential || _RATData_vec.size() > 0 )
     {
-	sort( _PinNode_ptr_vec.begin(), _PinNode_ptr_vec.end(), cmpPinNodePtrNameSort );
+	// scan the timing store for constrained pin nodes so that only they are sorted by name
+	const double *fast_fall_req_time = _timing_store.FetReqTimeArray(TimingStore::FAST_FALL);
+	const double *slow_fall_req_time = _timing_store.FetReqTimeArray(TimingStore::SLOW_FALL);
+	vector<unsigned> sorted_pnode_id_vec;
 
 	for( unsigned i=0; i<_PinNode_ptr_vec.size(); ++i )
+	    if( fast_fall_req_time[i] > NEGATIVE_BOUND || slow_fall_req_time[i] < POSITIVE_BOUND )
+		sorted_pnode_id_vec.push_back( i );
+
+	sortPinNodeIdsByName( _pin_node_name_table, sorted_pnode_id_vec );
+
+	for( unsigned i=0; i<sorted_pnode_id_vec.size(); ++i )
 	{
-	    PinNode &cur_pnode = *(_PinNode_ptr_vec[i]);
+	    const unsigned id = sorted_pnode_id_vec[i];
 
-	    if( cur_pnode.GetFastFallReqTime() > NEGATIVE_BOUND )
+	    if( _timing_store.GetReqTime(TimingStore::FAST_FALL, id) > NEGATIVE_BOUND )
 	    {
-		const double fast_fall_slack = cur_pnode.GetFastFallArrTime()-cur_pnode.GetFastFallReqTime();
-		const double fast_rise_slack = cur_pnode.GetFastRiseArrTime()-cur_pnode.GetFastRiseReqTime();
+		const double fast_fall_slack = _timing_store.GetArrTime(TimingStore::FAST_FALL, id)-_timing_store.GetReqTime(TimingStore::FAST_FALL, id);
+		const double fast_rise_slack = _timing_store.GetArrTime(TimingStore::FAST_RISE, id)-_timing_store.GetReqTime(TimingStore::FAST_RISE, id);
 
-		printf( "slack %s early %.5le %.5le\n", cur_pnode.GetName().c_str(), fast_fall_slack, fast_rise_slack );
+		printf( "slack %s early %.5le %.5le\n", string(_pin_node_name_table.GetName(id)).c_str(), fast_fall_slack, fast_rise_slack );
 	    }
 
-	    if( cur_pnode.GetSlowFallReqTime() < POSITIVE_BOUND )
+	    if( _timing_store.GetReqTime(TimingStore::SLOW_FALL, id) < POSITIVE_BOUND )
 	    {
-		const double slow_fall_slack = cur_pnode.GetSlowFallReqTime()-cur_pnode.GetSlowFallArrTime();
-		const double slow_rise_slack = cur_pnode.GetSlowRiseReqTime()-cur_pnode.GetSlowRiseArrTime();
+		const double slow_fall_slack = _timing_store.GetReqTime(TimingStore::SLOW_FALL, id)-_timing_store.GetArrTime(TimingStore::SLOW_FALL, id);
+		const double slow_rise_slack = _timing_store.GetReqTime(TimingStore::SLOW_RISE, id)-_timing_store.GetArrTime(TimingStore::SLOW_RISE, id);
 
-		printf( "slack %s late %.5le %.5le\n", cur_pnode.GetName().c_str(), slow_fall_slack, slow_rise_slack ); 
+		printf( "slack %s late %.5le %.5le\n", string(_pin_node_name_table.GetName(id)).c_str(), slow_fall_slack, slow_rise_slack ); 
 	    }
 	}
     }
@@ -128,6 +141,8 @@ void Circuit::PrintTimingData()
 
 void Circuit::PrintTimingData( const char *file_name ) 
 {
+    UpdateTiming(); // queued edits
+
     FILE *inf_ptr = fopen( file_name, "w" );
 
     if( inf_ptr == NULL )
@@ -138,50 +153,57 @@ void Circuit::PrintTimingData( const char *file_name )
     }
 
     const unsigned po_no = _PO_ptr_vec.size();
-    vector<PinNode*> PO_PinNode_ptr_vec;
-    PO_PinNode_ptr_vec.resize( po_no );
+    vector<unsigned> PO_pnode_id_vec;
+    PO_pnode_id_vec.resize( po_no );
 
     for( unsigned i=0; i<po_no; ++i )
-	PO_PinNode_ptr_vec[i] = _PO_ptr_vec[i]->GetInputPinNode(0);
+	PO_pnode_id_vec[i] = _PO_ptr_vec[i]->GetInputPinNode(0)->GetId();
 
-    sort( PO_PinNode_ptr_vec.begin(), PO_PinNode_ptr_vec.end(), cmpPinNodePtrNameSort );
+    sortPinNodeIdsByName( _pin_node_name_table, PO_pnode_id_vec );
 
     for( unsigned i=0; i<po_no; ++i )
     {
-	PinNode &cur_pnode = *(PO_PinNode_ptr_vec[i]);
-	fprintf( inf_ptr, "at %s %.5le %.5le %.5le %.5le %.5le %.5le %.5le %.5le\n", cur_pnode.GetName().c_str(), 
-		 cur_pnode.GetFastFallArrTime(), cur_pnode.GetFastRiseArrTime(), 
-		 cur_pnode.GetSlowFallArrTime(), cur_pnode.GetSlowRiseArrTime(), 
-		 cur_pnode.GetFastFallSlew(), cur_pnode.GetFastRiseSlew(), 
-		 cur_pnode.GetSlowFallSlew(), cur_pnode.GetSlowRiseSlew() );
+	const unsigned id = PO_pnode_id_vec[i];
+	fprintf( inf_ptr, "at %s %.5le %.5le %.5le %.5le %.5le %.5le %.5le %.5le\n", string(_pin_node_name_table.GetName(id)).c_str(), 
+		 _timing_store.GetArrTime(TimingStore::FAST_FALL, id), _timing_store.GetArrTime(TimingStore::FAST_RISE, id), 
+		 _timing_store.GetArrTime(TimingStore::SLOW_FALL, id), _timing_store.GetArrTime(TimingStore::SLOW_RISE, id), 
+		 _timing_store.GetSlew(TimingStore::FAST_FALL, id), _timing_store.GetSlew(TimingStore::FAST_RISE, id), 
+		 _timing_store.GetSlew(TimingStore::SLOW_FALL, id), _timing_store.GetSlew(TimingStore::SLOW_RISE, id) );
     }
 
     if( _is_sequential || _RATData_vec.size() > 0 )
     {
-	sort( _PinNode_ptr_vec.begin(), _PinNode_ptr_vec.end(), cmpPinNodePtrNameSort );
+	// scan the timing store for constrained pin nodes so that only they are sorted by name
+	const double *fast_fall_req_time = _timing_store.FetReqTimeArray(TimingStore::FAST_FALL);
+	const double *slow_fall_req_time = _timing_store.FetReqTimeArray(TimingStore::SLOW_FALL);
+	vector<unsigned> sorted_pnode_id_vec;
 
 	for( unsigned i=0; i<_PinNode_ptr_vec.size(); ++i )
-	{
-	    PinNode &cur_pnode = *(_PinNode_ptr_vec[i]);
+	    if( fast_fall_req_time[i] > NEGATIVE_BOUND || slow_fall_req_time[i] < POSITIVE_BOUND )
+		sorted_pnode_id_vec.push_back( i );
 
-//	    printf( "at %s %.5le %.5le %.5le %.5le\n", cur_pnode.GetName().c_str(), cur_pnode.GetFastFallArrTime(), cur_pnode.GetFastRiseArrTime(), cur_pnode.GetSlowFallArrTime(), cur_pnode.GetSlowRiseArrTime() );
+	sortPinNodeIdsByName( _pin_node_name_table, sorted_pnode_id_vec );
 
-	    if( cur_pnode.GetFastFallReqTime() > NEGATIVE_BOUND )
+	for( unsigned i=0; i<sorted_pnode_id_vec.size(); ++i )
+	{
+	    const unsigned id = sorted_pnode_id_vec[i];
+
+	    if( _timing_store.GetReqTime(TimingStore::FAST_FALL, id) > NEGATIVE_BOUND )
 	    {
-		const double fast_fall_slack = cur_pnode.GetFastFallArrTime()-cur_pnode.GetFastFallReqTime();
-		const double fast_rise_slack = cur_pnode.GetFastRiseArrTime()-cur_pnode.GetFastRiseReqTime();
+		const double fast_fall_slack = _timing_store.GetArrTime(TimingStore::FAST_FALL, id)-_timing_store.GetReqTime(TimingStore::FAST_FALL, id);
+		const double fast_rise_slack = _timing_store.GetArrTime(TimingStore::FAST_RISE, id)-_timing_store.GetReqTime(TimingStore::FAST_RISE, id);
 
 		fprintf( inf_ptr, "slack %s early %.5le %.5le\n", 
-		     	 cur_pnode.GetName().c_str(), fast_fall_slack, fast_rise_slack );
+		     	 string(_pin_node_name_table.GetName(id)).c_str(), fast_fall_slack, fast_rise_slack );
 	    }
 
-	    if( cur_pnode.GetSlowFallReqTime() < POSITIVE_BOUND )
+	    if( _timing_store.GetReqTime(TimingStore::SLOW_FALL, id) < POSITIVE_BOUND )
 	    {
-		const double slow_fall_slack = cur_pnode.GetSlowFallReqTime()-cur_pnode.GetSlowFallArrTime();
-		const double slow_rise_slack = cur_pnode.GetSlowRiseReqTime()-cur_pnode.GetSlowRiseArrTime();
+		const double slow_fall_slack = _timing_store.GetReqTime(TimingStore::SLOW_FALL, id)-_timing_store.GetArrTime(TimingStore::SLOW_FALL, id);
+		const double slow_rise_slack = _timing_store.GetReqTime(TimingStore::SLOW_RISE, id)-_timing_store.GetArrTime(TimingStore::SLOW_RISE, id);
 
 		fprintf( inf_ptr, "slack %s late %.5le %.5le\n", 
-			 cur_pnode.GetName().c_str(), slow_fall_slack, slow_rise_slack ); 
+			 string(_pin_node_name_table.GetName(id)).c_str(), slow_fall_slack, slow_rise_slack ); 
 	    }
 	}
     }
@@ -194,8 +216,10 @@ void Circuit::PrintTimingData( const char *file_name )
 //    Define auxiliary functions 
 //-----------------------------------------------------------------------
 
-bool cmpPinNodePtrNameSort( PinNode *a_ptr, PinNode *b_ptr )
+void sortPinNodeIdsByName( const NameTable &pin_node_name_table, vector<unsigned> &pnode_id_vec )
 {
-    return ( (*a_ptr).GetName() < (*b_ptr).GetName() );
-}
+    sort( pnode_id_vec.begin(), pnode_id_vec.end(), [&pin_node_name_table](unsigned a, unsigned b) {
+	return pin_node_name_table.GetName(a) < pin_node_name_table.GetName(b); } );
 
+    return;
+}
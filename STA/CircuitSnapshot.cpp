@@ -0,0 +1,476 @@
+/************************************************************************
+ *   Define member functions of class Circuit for the post-wiring
+ *   snapshot: SaveSnapshot(), LoadSnapshot()
+ *
+ *   A snapshot keeps what is left after injecting wiring effects, i.e.,
+ *   pin-node names and connectivity, wire delays of gate input pins,
+ *   slew hats of pin nodes and loads of gate output pins. Constraints
+ *   (at/slew/rat/clock) are not included, and cells are referred to by
+ *   name, so a snapshot is used with the library it is made with. Wire
+ *   delays and loads depend on input pin capacitances of the library, so
+ *   a header records the size and modification time of the library file,
+ *   and a snapshot not matching the library file is rejected.
+ *
+ *   Layout: header, pin nodes (name, leaf number, slew hats), gates in
+ *   the order of PIs, POs, combinational and sequential gates (cell,
+ *   pins with their pin nodes, delays and loads), and pin-node links.
+ *
+ *   Author      : Kuan-Hsien Ho
+************************************************************************/
+
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "BinaryIO.h"
+#include "Circuit.h"
+#include "MappedFile.h"
+
+using namespace std;
+
+//-----------------------------------------------------------------------
+//    Declare auxiliary functions and data
+//-----------------------------------------------------------------------
+
+struct SnapshotHeader
+{
+    char Magic[8];       // "STASNAPS"
+    uint32_t Version;    // SNAPSHOT_VERSION
+    uint32_t ByteOrder;  // 0x01020304 in the byte order of the writer
+    uint64_t LibSize;    // size of the library file
+    int64_t LibMtimeSec; // modification time of the library file
+    int64_t LibMtimeNsec;
+    uint64_t ImageSize;  // size of the whole snapshot, to detect a truncated one
+    uint32_t PinNodeNo;
+    uint32_t PINo;
+    uint32_t PONo;
+    uint32_t ComGateNo;
+    uint32_t SeqGateNo;
+    uint32_t IsSequential;
+};
+
+static const char SNAPSHOT_MAGIC[8] = {'S', 'T', 'A', 'S', 'N', 'A', 'P', 'S'};
+static const uint32_t SNAPSHOT_VERSION = 2;    // increase when the layout changes
+static const uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304;
+static const uint32_t SNAPSHOT_NO_ID = 0xffffffffu;
+
+enum SnapshotLinkType // type of an element linked to a pin node
+{
+    LINK_NONE,
+    LINK_PIN_NODE,   // followed by pin-node id
+    LINK_GATE_PIN    // followed by gate id and pin id
+};
+
+void exitWithBadSnapshot( const char *file_name );
+
+bool getLibraryStamp( const char *lib_file_name, SnapshotHeader &header ); // fill library size and modification time
+
+void putLink( vector<char> &buf, Element *element_ptr, const unordered_map<const Gate*, unsigned> &gate_id_map );
+
+void putPinNodeId( vector<char> &buf, PinNode *pin_node_ptr );
+
+//-----------------------------------------------------------------------
+//    Define member functions
+//-----------------------------------------------------------------------
+
+void Circuit::SaveSnapshot(const char *file_name, const char *lib_file_name) const
+{
+    SnapshotHeader header;
+    memset( &header, 0, sizeof(header) );
+
+    if( !getLibraryStamp(lib_file_name, header) )
+    {
+	printf( "Error in writing snapshot %s: cannot stat library %s\n", file_name, lib_file_name );
+	printf( "  Exiting...\n" );
+	exit(-1);
+    }
+
+    memcpy( header.Magic, SNAPSHOT_MAGIC, sizeof(header.Magic) );
+    header.Version = SNAPSHOT_VERSION;
+    header.ByteOrder = SNAPSHOT_BYTE_ORDER;
+    header.PinNodeNo = _PinNode_ptr_vec.size();
+    header.PINo = _PI_ptr_vec.size();
+    header.PONo = _PO_ptr_vec.size();
+    header.ComGateNo = _ComGate_ptr_vec.size();
+    header.SeqGateNo = _SeqGate_ptr_vec.size();
+    header.IsSequential = _is_sequential? 1: 0;
+
+    vector<char> buf( sizeof(header) ); // header is filled in after the size is known
+
+    // pin nodes
+    for( unsigned i=0; i<_PinNode_ptr_vec.size(); ++i )
+    {
+	const PinNode &cur_pnode = *(_PinNode_ptr_vec[i]);
+	// wiring effects must be injected; kept RC trees are not saved
+	assert( cur_pnode._id == i && (cur_pnode._fanout_rc_tree_ptr == NULL || cur_pnode._fanout_rc_tree_ptr->IsFlat()) );
+	putString( buf, _pin_node_name_table.GetName(i) );
+	putU32( buf, cur_pnode._fanout_pin_node_no );
+	putDouble( buf, cur_pnode._fall_slew_hat_sq );
+	putDouble( buf, cur_pnode._rise_slew_hat_sq );
+    }
+
+    // gates
+    const vector<Gate*> *gate_ptr_vec_arr[4] = {&_PI_ptr_vec, &_PO_ptr_vec, &_ComGate_ptr_vec, &_SeqGate_ptr_vec};
+    unordered_map<const Gate*, unsigned> gate_id_map; // gate id follows the order of gates in the snapshot
+
+    for( unsigned k=0; k<4; ++k )
+    {
+	const vector<Gate*> &gate_ptr_vec = *(gate_ptr_vec_arr[k]);
+
+	for( unsigned i=0; i<gate_ptr_vec.size(); ++i )
+	{
+	    Gate &cur_gate = *(gate_ptr_vec[i]);
+	    const unsigned gate_id = gate_id_map.size();
+	    gate_id_map[&cur_gate] = gate_id;
+	    assert( (cur_gate._cell_ptr == NULL) == (k < 2) );
+
+	    if( cur_gate._cell_ptr != NULL )
+		putString( buf, cur_gate._cell_ptr->GetName() );
+
+	    putU32( buf, cur_gate._input_vec.size() );
+	    putU32( buf, cur_gate._output_vec.size() );
+
+	    for( unsigned j=0; j<cur_gate._input_vec.size(); ++j )
+	    {
+		GInPin &gin_pin = cur_gate._input_vec[j];
+		putPinNodeId( buf, gin_pin.GetFaninPtr() );
+		putDouble( buf, gin_pin.GetFallArrDelay() );
+		putDouble( buf, gin_pin.GetRiseArrDelay() );
+	    }
+
+	    for( unsigned j=0; j<cur_gate._output_vec.size(); ++j )
+	    {
+		GOutPin &gout_pin = cur_gate._output_vec[j];
+		putPinNodeId( buf, gout_pin.GetFanoutPtr() );
+		putDouble( buf, gout_pin.GetFallLoad() );
+		putDouble( buf, gout_pin.GetRiseLoad() );
+	    }
+	}
+    }
+
+    // pin-node links, in the original fanout order
+    for( unsigned i=0; i<_PinNode_ptr_vec.size(); ++i )
+    {
+	const PinNode &cur_pnode = *(_PinNode_ptr_vec[i]);
+	putLink( buf, cur_pnode._fanin_ptr, gate_id_map );
+	putU32( buf, cur_pnode._fanout_ptr_vec.size() );
+
+	for( unsigned j=0; j<cur_pnode._fanout_ptr_vec.size(); ++j )
+	    putLink( buf, cur_pnode._fanout_ptr_vec[j], gate_id_map );
+    }
+
+    header.ImageSize = buf.size();
+    memcpy( &(buf[0]), &header, sizeof(header) );
+
+    // written to a unique temporary file and renamed, so that a reader never maps a partial snapshot
+    string tmp_name = string(file_name) + ".XXXXXX";
+    const int fd = mkstemp( &(tmp_name[0]) );
+    FILE *outf = NULL;
+    bool is_written = false;
+
+    if( fd >= 0 )
+    {
+	if( fchmod(fd, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH) != 0 || (outf = fdopen(fd, "wb")) == NULL ) // mkstemp() gives 0600
+	    close( fd );
+	else
+	{
+	    const bool is_all_written = (fwrite(&(buf[0]), 1, buf.size(), outf) == buf.size());
+	    is_written = (fclose(outf) == 0 && is_all_written && rename(tmp_name.c_str(), file_name) == 0);
+	}
+
+	if( !is_written )
+	    remove( tmp_name.c_str() );
+    }
+
+    if( !is_written )
+    {
+	printf( "Error in writing snapshot %s\n", file_name );
+	printf( "  Exiting...\n" );
+	exit(-1);
+    }
+
+    return;
+}
+
+// build a wired circuit from a snapshot, exit if the snapshot is corrupt or does not match the library
+void Circuit::LoadSnapshot(const char *file_name, const CellLibrary &cell_library, const char *lib_file_name)
+{
+    assert( _PinNode_ptr_vec.size() == 0 && GetTotGateNo() == 0 );
+    MappedFile inf( file_name ); // exit if failed
+    SnapshotHeader header, lib_stamp;
+
+    if( inf.GetSize() < sizeof(header) )
+	exitWithBadSnapshot( file_name );
+
+    memcpy( &header, inf.GetBegin(), sizeof(header) );
+
+    if( memcmp(header.Magic, SNAPSHOT_MAGIC, sizeof(header.Magic)) != 0 || header.Version != SNAPSHOT_VERSION ||
+	header.ByteOrder != SNAPSHOT_BYTE_ORDER || header.ImageSize != inf.GetSize() )
+	exitWithBadSnapshot( file_name );
+
+    if( !getLibraryStamp(lib_file_name, lib_stamp) || header.LibSize != lib_stamp.LibSize || 
+	header.LibMtimeSec != lib_stamp.LibMtimeSec || header.LibMtimeNsec != lib_stamp.LibMtimeNsec )
+	exitWithBadSnapshot( file_name ); // library file changed after the snapshot was written
+
+    const char *pos = inf.GetBegin() + sizeof(header);
+    const char *end = inf.GetEnd();
+    string name;
+
+    // pin nodes
+    _PinNode_ptr_vec.reserve( header.PinNodeNo );
+    _pin_node_name_table.Reserve( header.PinNodeNo, inf.GetSize() );
+    _timing_store.Reserve( header.PinNodeNo );
+
+    for( uint32_t i=0; i<header.PinNodeNo; ++i )
+    {
+	if( !getString(pos, end, name) )
+	    exitWithBadSnapshot( file_name );
+
+	bool is_new;
+	const unsigned id = _pin_node_name_table.Grab( name, is_new );
+
+	if( !is_new )
+	    exitWithBadSnapshot( file_name );
+
+	_timing_store.AddNode();
+	PinNode *pin_node_ptr = _pin_node_arena.Create(id);
+	_PinNode_ptr_vec.push_back(pin_node_ptr);
+
+	if( !getU32(pos, end, pin_node_ptr->_fanout_pin_node_no) || !getDouble(pos, end, pin_node_ptr->_fall_slew_hat_sq) ||
+	    !getDouble(pos, end, pin_node_ptr->_rise_slew_hat_sq) )
+	    exitWithBadSnapshot( file_name );
+    }
+
+    // gates
+    NameTable cell_name_table; // cell name -> cell id of the library
+    bool is_new;
+
+    for( unsigned i=0; i<cell_library.GetCellNo(); ++i )
+	cell_name_table.Grab( cell_library.GetCellPtr(i)->GetName(), is_new );
+
+    vector<Gate*> *gate_ptr_vec_arr[4] = {&_PI_ptr_vec, &_PO_ptr_vec, &_ComGate_ptr_vec, &_SeqGate_ptr_vec};
+    const uint32_t gate_no_arr[4] = {header.PINo, header.PONo, header.ComGateNo, header.SeqGateNo};
+    vector<Gate*> gate_ptr_vec; // indexed by gate id
+
+    for( unsigned k=0; k<4; ++k )
+    {
+	for( uint32_t i=0; i<gate_no_arr[k]; ++i )
+	{
+	    Gate *gate_ptr = NULL;
+	    uint32_t input_no, output_no;
+
+	    if( k < 2 ) // PI or PO
+	    {
+		gate_ptr = _gate_arena.Create();
+
+		if( !getU32(pos, end, input_no) || !getU32(pos, end, output_no) || input_no != ((k == 1)? 1: 0) || 
+		    output_no != ((k == 0)? 1: 0) )
+		    exitWithBadSnapshot( file_name );
+
+		if( k == 0 )
+		    gate_ptr->_output_vec.push_back( GOutPin(0, gate_ptr, NULL) );
+		else
+		    gate_ptr->_input_vec.push_back( GInPin(0, gate_ptr, NULL) );
+	    }
+	    else
+	    {
+		if( !getString(pos, end, name) )
+		    exitWithBadSnapshot( file_name );
+
+		const unsigned cell_id = cell_name_table.Find( name );
+
+		if( cell_id == NameTable::NOT_FOUND )
+		{
+		    printf( "Error in loading snapshot %s: cell %s is not in the library\n", file_name, name.c_str() );
+		    printf( "  Exiting...\n" );
+		    exit(-1);
+		}
+
+		Cell *cell_ptr = cell_library.GetCellPtr(cell_id);
+		gate_ptr = _gate_arena.Create(cell_ptr);
+		gate_ptr->_is_non_clocked = cell_ptr->GetIsNonClocked();
+
+		if( !getU32(pos, end, input_no) || !getU32(pos, end, output_no) || input_no != cell_ptr->GetInputPinNo() ||
+		    output_no != cell_ptr->GetOutputPinNo() || gate_ptr->_is_non_clocked != (k == 2) )
+		    exitWithBadSnapshot( file_name );
+	    }
+
+	    gate_ptr_vec_arr[k]->push_back(gate_ptr);
+	    gate_ptr_vec.push_back(gate_ptr);
+
+	    for( uint32_t j=0; j<input_no; ++j )
+	    {
+		GInPin &gin_pin = gate_ptr->_input_vec[j];
+		uint32_t pnode_id;
+		double fall_delay, rise_delay;
+
+		if( !getU32(pos, end, pnode_id) || (pnode_id != SNAPSHOT_NO_ID && pnode_id >= _PinNode_ptr_vec.size()) ||
+		    !getDouble(pos, end, fall_delay) || !getDouble(pos, end, rise_delay) )
+		    exitWithBadSnapshot( file_name );
+
+		gin_pin.SetFaninPtr( (pnode_id == SNAPSHOT_NO_ID)? NULL: _PinNode_ptr_vec[pnode_id] );
+		gin_pin.SetFallArrDelay( fall_delay );
+		gin_pin.SetRiseArrDelay( rise_delay );
+	    }
+
+	    for( uint32_t j=0; j<output_no; ++j )
+	    {
+		GOutPin &gout_pin = gate_ptr->_output_vec[j];
+		uint32_t pnode_id;
+		double fall_load, rise_load;
+
+		if( !getU32(pos, end, pnode_id) || (pnode_id != SNAPSHOT_NO_ID && pnode_id >= _PinNode_ptr_vec.size()) ||
+		    !getDouble(pos, end, fall_load) || !getDouble(pos, end, rise_load) )
+		    exitWithBadSnapshot( file_name );
+
+		gout_pin.SetFanoutPtr( (pnode_id == SNAPSHOT_NO_ID)? NULL: _PinNode_ptr_vec[pnode_id] );
+		gout_pin.SetFallLoad( fall_load );
+		gout_pin.SetRiseLoad( rise_load );
+	    }
+	}
+    }
+
+    // pin-node links
+    for( uint32_t i=0; i<header.PinNodeNo; ++i )
+    {
+	PinNode &cur_pnode = *(_PinNode_ptr_vec[i]);
+	uint32_t fanout_no = 0;
+
+	for( int j=-1; j<static_cast<int>(fanout_no); ++j ) // fanin first, then fanouts
+	{
+	    uint32_t link_type, id, pin_id;
+	    Element *element_ptr = NULL;
+
+	    if( !getU32(pos, end, link_type) )
+		exitWithBadSnapshot( file_name );
+
+	    if( link_type == LINK_PIN_NODE )
+	    {
+		if( !getU32(pos, end, id) || id >= _PinNode_ptr_vec.size() )
+		    exitWithBadSnapshot( file_name );
+
+		element_ptr = _PinNode_ptr_vec[id];
+	    }
+	    else if( link_type == LINK_GATE_PIN )
+	    {
+		if( !getU32(pos, end, id) || id >= gate_ptr_vec.size() || !getU32(pos, end, pin_id) )
+		    exitWithBadSnapshot( file_name );
+
+		Gate &cur_gate = *(gate_ptr_vec[id]);
+
+		if( j < 0 ) // fanin is a gate output pin
+		{
+		    if( pin_id >= cur_gate._output_vec.size() )
+			exitWithBadSnapshot( file_name );
+
+		    element_ptr = &(cur_gate._output_vec[pin_id]);
+		}
+		else
+		{
+		    if( pin_id >= cur_gate._input_vec.size() )
+			exitWithBadSnapshot( file_name );
+
+		    element_ptr = &(cur_gate._input_vec[pin_id]);
+		}
+	    }
+	    else if( link_type != LINK_NONE )
+		exitWithBadSnapshot( file_name );
+
+	    if( j < 0 )
+	    {
+		cur_pnode._fanin_ptr = element_ptr;
+
+		if( !getU32(pos, end, fanout_no) || fanout_no > static_cast<size_t>(end-pos) )
+		    exitWithBadSnapshot( file_name );
+
+		cur_pnode._fanout_ptr_vec.reserve( fanout_no );
+	    }
+	    else
+		cur_pnode._fanout_ptr_vec.push_back( element_ptr );
+	}
+    }
+
+    if( pos != end )
+	exitWithBadSnapshot( file_name );
+
+    _is_sequential = (header.IsSequential != 0);
+    assert( _is_sequential == (_SeqGate_ptr_vec.size() > 0) );
+
+    return;
+}
+
+//-----------------------------------------------------------------------
+//    Define auxiliary functions 
+//-----------------------------------------------------------------------
+
+void exitWithBadSnapshot( const char *file_name )
+{
+    printf( "Error in loading snapshot %s: not a snapshot of this version and library, or corrupt\n", file_name );
+    printf( "  Exiting...\n" );
+    exit(-1);
+}
+
+bool getLibraryStamp( const char *lib_file_name, SnapshotHeader &header )
+{
+    struct stat file_stat;
+
+    if( stat(lib_file_name, &file_stat) != 0 )
+	return false;
+
+    header.LibSize = file_stat.st_size;
+    header.LibMtimeSec = file_stat.st_mtim.tv_sec;
+    header.LibMtimeNsec = file_stat.st_mtim.tv_nsec;
+
+    return true;
+}
+
+void putLink( vector<char> &buf, Element *element_ptr, const unordered_map<const Gate*, unsigned> &gate_id_map )
+{
+    if( element_ptr == NULL )
+    {
+	putU32( buf, LINK_NONE );
+	return;
+    }
+
+    switch( element_ptr->GetType() )
+    {
+	case Element::PIN_NODE:
+	    putU32( buf, LINK_PIN_NODE );
+	    putU32( buf, static_cast<PinNode*>(element_ptr)->GetId() );
+	    break;
+	case Element::GIN_PIN:
+	    {
+		const GInPin *gin_pin_ptr = static_cast<GInPin*>(element_ptr);
+		putU32( buf, LINK_GATE_PIN );
+		putU32( buf, gate_id_map.find(gin_pin_ptr->GetGatePtr())->second );
+		putU32( buf, gin_pin_ptr->GetPinId() );
+		break;
+	    }
+	case Element::GOUT_PIN:
+	    {
+		const GOutPin *gout_pin_ptr = static_cast<GOutPin*>(element_ptr);
+		putU32( buf, LINK_GATE_PIN );
+		putU32( buf, gate_id_map.find(gout_pin_ptr->GetGatePtr())->second );
+		putU32( buf, gout_pin_ptr->GetPinId() );
+		break;
+	    }
+	default:
+	    assert(0);
+	    break;
+    }
+
+    return;
+}
+
+void putPinNodeId( vector<char> &buf, PinNode *pin_node_ptr )
+{
+    putU32( buf, (pin_node_ptr == NULL)? SNAPSHOT_NO_ID: pin_node_ptr->GetId() );
+}
@@ -10,7 +10,7 @@
 
 using namespace std;
 
-void Gate::PrintGateData()
+void Gate::PrintGateData(const NameTable &pin_node_name_table)
 {
     if( _cell_ptr == NULL )
     {
@@ -35,13 +35,13 @@ void Gate::PrintGateData()
 	PinNode *pin_node_ptr = _input_vec[i].GetFaninPtr();
 
 	if( _cell_ptr == NULL )
-	    cout << "  input " << pin_node_ptr->GetName() << endl;
+	    cout << "  input " << pin_node_name_table.GetName(pin_node_ptr->GetId()) << endl;
 	else
 	{
 	    cout << "  input " << _cell_ptr->GetInputPinName(i) << ": ";
 	    
 	    if( pin_node_ptr != NULL ) 
-		cout << pin_node_ptr->GetName() << endl;
+		cout << pin_node_name_table.GetName(pin_node_ptr->GetId()) << endl;
 	    else
 		cout << "NULL" << endl;
 	}
@@ -57,13 +57,13 @@ void Gate::PrintGateData()
 	PinNode *pin_node_ptr = _output_vec[i].GetFanoutPtr();
 
 	if( _cell_ptr == NULL )
-	    cout << "  output " << pin_node_ptr->GetName() << endl;
+	    cout << "  output " << pin_node_name_table.GetName(pin_node_ptr->GetId()) << endl;
 	else
 	{
 	    cout << "  output " << _cell_ptr->GetOutputPinName(i) << ": ";
 
 	    if( pin_node_ptr != NULL )
-		cout << pin_node_ptr->GetName() << endl;
+		cout << pin_node_name_table.GetName(pin_node_ptr->GetId()) << endl;
 	    else
 		cout << "NULL" << endl;
 	}
@@ -13,7 +13,6 @@
 #include <vector>
 
 #include "Cell.h"
-#include "DelayData.h"
 #include "Element.h"
 #include "PinNode.h"
 
@@ -71,21 +70,16 @@ class GOutPin: public Element
 	unsigned   GetPinId() const                        { return _pin_id; }
         double     GetFallLoad() const                     { return _fall_load; }
 	double     GetRiseLoad() const                     { return _rise_load; }
-	DelayData* GetFastDelayDataPtr(const unsigned &id) { return _fast_delay_data_ptr_vec[id]; }
-	DelayData* GetSlowDelayDataPtr(const unsigned &id) { return _slow_delay_data_ptr_vec[id]; }
 	unsigned   GetVisitedCount() const                 { return _visited_count; }
 	Gate*      GetGatePtr() const                      { return _gate_ptr; }
 	PinNode*   GetFanoutPtr()                          { return _fanout_ptr; }
 
-	void InitFastDelayDataPtrVec(const unsigned &in_no) { _fast_delay_data_ptr_vec.assign(in_no, NULL); }
-	void InitSlowDelayDataPtrVec(const unsigned &in_no) { _slow_delay_data_ptr_vec.assign(in_no, NULL); }
 	void IncVisitedCount() { ++_visited_count; }
+	void ResetVisitedCount() { _visited_count = 0; }
 
 	void SetPinId(const unsigned &pid) { _pin_id = pid; }
 	void SetFallLoad(const double &val) { _fall_load = val; }
 	void SetRiseLoad(const double &val) { _rise_load = val; }
-	void SetFastDelayDataPtr(const unsigned &id, DelayData*ptr) { _fast_delay_data_ptr_vec[id] = ptr; }
-	void SetSlowDelayDataPtr(const unsigned &id, DelayData*ptr) { _slow_delay_data_ptr_vec[id] = ptr; }
 
 	void SetGatePtr(Gate *gate_ptr) { _gate_ptr = gate_ptr; }
 	void SetFanoutPtr(PinNode *node_ptr) { _fanout_ptr = node_ptr; }
@@ -95,9 +89,6 @@ class GOutPin: public Element
 	double _fall_load; // output falling loading capacitance
 	double _rise_load; // output rising oading capacitance
 
-	std::vector<DelayData*> _fast_delay_data_ptr_vec; // record gate delay, index corresponding to input pin id
-	std::vector<DelayData*> _slow_delay_data_ptr_vec;
-
 	unsigned _visited_count; // for backward STA
 
 	Gate *_gate_ptr;
@@ -133,7 +124,7 @@ class Gate: public Element
         GOutPin &FetGOutPin(const unsigned &id) { return _output_vec[id]; }
 
 	void IncInputVisitedCount() { ++_input_visited_count; } // both combinational and sequential circuits
-	void PrintGateData(); // display data for checking
+	void PrintGateData(const NameTable &pin_node_name_table); // display data for checking, names by pin-node id
 
     protected:
 	Cell *_cell_ptr;      // point to cell
@@ -0,0 +1,213 @@
+/************************************************************************
+ *   Define gate kernels of one timing arc, specialized at compile time
+ *   by timing sense and analysis mode. propagateSignal() and
+ *   backtraceSignal() run them over arcs bucketed by timing sense, so
+ *   that each instantiation works on arcs of a single sense without
+ *   branching.
+ *
+ *   Values of a pin are indexed by Edge, i.e., by fall or rise
+ *   transition. Delays of an arc are indexed by its slots in the
+ *   ArcDelayTable.
+ *
+ *   Lane kernels work on all four lanes of a pin at once, i.e., on its
+ *   values indexed by TimingStore::Split. They have a scalar version
+ *   here and an AVX2 version in GateKernelAvx2.cpp, which is used only
+ *   if the CPU supports it. Both give bitwise identical results.
+ *
+ *   Author      : Kuan-Hsien Ho
+************************************************************************/
+
+#ifndef GATE_KERNEL_H
+#define GATE_KERNEL_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "ArcDelayTable.h"
+#include "Cell.h"
+#include "TimingStore.h"
+
+//-----------------------------------------------------------------------
+//    Define types and helpers
+//-----------------------------------------------------------------------
+
+enum Edge // signal transition
+{
+    FALL,
+    RISE,
+    EDGE_NO
+};
+
+// timing store split of a mode and a transition
+template<ArcDelayTable::Mode MODE, Edge EDGE>
+constexpr TimingStore::Split getSplit()
+{
+    if constexpr( MODE == ArcDelayTable::FAST )
+	return (EDGE == FALL)? TimingStore::FAST_FALL: TimingStore::FAST_RISE;
+    else
+	return (EDGE == FALL)? TimingStore::SLOW_FALL: TimingStore::SLOW_RISE;
+}
+
+// arrival times and slews are folded by min in early mode and by max in late mode
+template<ArcDelayTable::Mode MODE>
+constexpr double getInitArrival()
+{
+    return (MODE == ArcDelayTable::FAST)? std::numeric_limits<double>::infinity(): -std::numeric_limits<double>::infinity();
+}
+
+template<ArcDelayTable::Mode MODE>
+inline double foldArrival(const double &cur, const double &val)
+{
+    return (MODE == ArcDelayTable::FAST)? std::min(cur, val): std::max(cur, val);
+}
+
+// required times are folded by max in early mode and by min in late mode
+template<ArcDelayTable::Mode MODE>
+constexpr double getInitReqTime()
+{
+    return -getInitArrival<MODE>();
+}
+
+template<ArcDelayTable::Mode MODE>
+inline double foldReqTime(const double &cur, const double &val)
+{
+    return (MODE == ArcDelayTable::FAST)? std::max(cur, val): std::min(cur, val);
+}
+
+//-----------------------------------------------------------------------
+//    Define kernels of a transition
+//-----------------------------------------------------------------------
+
+template<Edge OUT>
+inline double computeGateDelay(const InputTimingTable &timing, const double &load, const double &input_slew)
+{
+    if constexpr( OUT == FALL )
+	return timing.FallDelayA + timing.FallDelayB * load + timing.FallDelayC * input_slew;
+    else
+	return timing.RiseDelayA + timing.RiseDelayB * load + timing.RiseDelayC * input_slew;
+}
+
+template<Edge OUT>
+inline double computeGateSlew(const InputTimingTable &timing, const double &load, const double &input_slew)
+{
+    if constexpr( OUT == FALL )
+	return timing.FallSlewX + timing.FallSlewY * load + timing.FallSlewZ * input_slew;
+    else
+	return timing.RiseSlewX + timing.RiseSlewY * load + timing.RiseSlewZ * input_slew;
+}
+
+// input transition IN causes output transition OUT: fold the output candidate and record the gate delay
+template<Edge IN, Edge OUT, ArcDelayTable::Mode MODE>
+inline void propagateTransition(const InputTimingTable &timing, const double input_arrival[], const double input_slew[],
+	                        const double load[], double &arc_delay, double output_arrival[], double output_slew[])
+{
+    arc_delay = computeGateDelay<OUT>( timing, load[OUT], input_slew[IN] );
+    output_arrival[OUT] = foldArrival<MODE>( output_arrival[OUT], input_arrival[IN] + arc_delay );
+    output_slew[OUT] = foldArrival<MODE>( output_slew[OUT], computeGateSlew<OUT>( timing, load[OUT], input_slew[IN] ) );
+}
+
+template<Edge IN, Edge OUT, ArcDelayTable::Mode MODE>
+inline void backtraceTransition(const double output_req_time[], const double &arc_delay, double input_req_time[])
+{
+    input_req_time[IN] = foldReqTime<MODE>( input_req_time[IN], output_req_time[OUT] - arc_delay );
+}
+
+//-----------------------------------------------------------------------
+//    Define kernels of an arc
+//-----------------------------------------------------------------------
+
+// fold the output candidates of an arc in one mode, and record its delays from arc_delay[0]
+template<InputTimingTable::TimingSense SENSE, ArcDelayTable::Mode MODE>
+inline void propagateArc(const InputTimingTable &timing, const double input_arrival[], const double input_slew[],
+	                 const double load[], double arc_delay[], double output_arrival[], double output_slew[])
+{
+    static_assert( SENSE != InputTimingTable::UNKNOWN_UNATE, "no kernel of an unknown timing sense" );
+
+    if constexpr( SENSE == InputTimingTable::POSITIVE_UNATE )
+    {
+	propagateTransition<FALL, FALL, MODE>( timing, input_arrival, input_slew, load, arc_delay[ArcDelayTable::FROM_INPUT_FALL], output_arrival, output_slew );
+	propagateTransition<RISE, RISE, MODE>( timing, input_arrival, input_slew, load, arc_delay[ArcDelayTable::FROM_INPUT_RISE], output_arrival, output_slew );
+    }
+    else if constexpr( SENSE == InputTimingTable::NEGATIVE_UNATE )
+    {
+	propagateTransition<RISE, FALL, MODE>( timing, input_arrival, input_slew, load, arc_delay[ArcDelayTable::FROM_INPUT_RISE], output_arrival, output_slew );
+	propagateTransition<FALL, RISE, MODE>( timing, input_arrival, input_slew, load, arc_delay[ArcDelayTable::FROM_INPUT_FALL], output_arrival, output_slew );
+    }
+    else
+    {
+	propagateTransition<RISE, FALL, MODE>( timing, input_arrival, input_slew, load, arc_delay[ArcDelayTable::INPUT_RISE_OUTPUT_FALL], output_arrival, output_slew );
+	propagateTransition<FALL, RISE, MODE>( timing, input_arrival, input_slew, load, arc_delay[ArcDelayTable::INPUT_FALL_OUTPUT_RISE], output_arrival, output_slew );
+	propagateTransition<FALL, FALL, MODE>( timing, input_arrival, input_slew, load, arc_delay[ArcDelayTable::INPUT_FALL_OUTPUT_FALL], output_arrival, output_slew );
+	propagateTransition<RISE, RISE, MODE>( timing, input_arrival, input_slew, load, arc_delay[ArcDelayTable::INPUT_RISE_OUTPUT_RISE], output_arrival, output_slew );
+    }
+}
+
+// fold the input required-time candidates of an arc in one mode from its delays from arc_delay[0]
+template<InputTimingTable::TimingSense SENSE, ArcDelayTable::Mode MODE>
+inline void backtraceArc(const double output_req_time[], const double arc_delay[], double input_req_time[])
+{
+    static_assert( SENSE != InputTimingTable::UNKNOWN_UNATE, "no kernel of an unknown timing sense" );
+
+    if constexpr( SENSE == InputTimingTable::POSITIVE_UNATE )
+    {
+	backtraceTransition<FALL, FALL, MODE>( output_req_time, arc_delay[ArcDelayTable::FROM_INPUT_FALL], input_req_time );
+	backtraceTransition<RISE, RISE, MODE>( output_req_time, arc_delay[ArcDelayTable::FROM_INPUT_RISE], input_req_time );
+    }
+    else if constexpr( SENSE == InputTimingTable::NEGATIVE_UNATE )
+    {
+	backtraceTransition<FALL, RISE, MODE>( output_req_time, arc_delay[ArcDelayTable::FROM_INPUT_FALL], input_req_time );
+	backtraceTransition<RISE, FALL, MODE>( output_req_time, arc_delay[ArcDelayTable::FROM_INPUT_RISE], input_req_time );
+    }
+    else
+    {
+	backtraceTransition<FALL, RISE, MODE>( output_req_time, arc_delay[ArcDelayTable::INPUT_FALL_OUTPUT_RISE], input_req_time );
+	backtraceTransition<RISE, FALL, MODE>( output_req_time, arc_delay[ArcDelayTable::INPUT_RISE_OUTPUT_FALL], input_req_time );
+	backtraceTransition<FALL, FALL, MODE>( output_req_time, arc_delay[ArcDelayTable::INPUT_FALL_OUTPUT_FALL], input_req_time );
+	backtraceTransition<RISE, RISE, MODE>( output_req_time, arc_delay[ArcDelayTable::INPUT_RISE_OUTPUT_RISE], input_req_time );
+    }
+}
+
+//-----------------------------------------------------------------------
+//    Define lane kernels
+//-----------------------------------------------------------------------
+
+// fold the output candidates of an arc in both modes, and record its delays in both modes
+template<InputTimingTable::TimingSense SENSE>
+inline void propagateArcLanes(const InputTimingTable &timing, const double input_arrival[], const double input_slew[], const double load[],
+	                      double fast_arc_delay[], double slow_arc_delay[], double output_arrival[], double output_slew[])
+{
+    propagateArc<SENSE, ArcDelayTable::FAST>( timing, input_arrival+TimingStore::FAST_FALL, input_slew+TimingStore::FAST_FALL, load, 
+	                                      fast_arc_delay, output_arrival+TimingStore::FAST_FALL, output_slew+TimingStore::FAST_FALL );
+    propagateArc<SENSE, ArcDelayTable::SLOW>( timing, input_arrival+TimingStore::SLOW_FALL, input_slew+TimingStore::SLOW_FALL, load, 
+	                                      slow_arc_delay, output_arrival+TimingStore::SLOW_FALL, output_slew+TimingStore::SLOW_FALL );
+}
+
+// signal at a wire tap from the signal at the wire root, where slews of the root are squared already
+inline void propagateWireLanes(const double root_arrival[], const double root_slew_sq[], const double wire_delay[], 
+	                       const double slew_hat_sq[], double tap_arrival[], double tap_slew[])
+{
+    for( unsigned s=0; s<TimingStore::SPLIT_NO; ++s )
+    {
+	const unsigned e = s % EDGE_NO; // splits alternate fall and rise
+	tap_arrival[s] = root_arrival[s] + wire_delay[e];
+	tap_slew[s] = std::sqrt( root_slew_sq[s] + slew_hat_sq[e] );
+    }
+}
+
+//-----------------------------------------------------------------------
+//    Declare AVX2 lane kernels, defined in GateKernelAvx2.cpp
+//-----------------------------------------------------------------------
+
+bool getIsAvx2Supported();              // by the CPU
+bool getIsAvx2KernelOn();               // on by default if supported
+void setIsAvx2KernelOn(const bool &on); // cannot be turned on if not supported
+
+template<InputTimingTable::TimingSense SENSE>
+void propagateArcAvx2(const InputTimingTable &timing, const double input_arrival[], const double input_slew[], const double load[],
+	              double fast_arc_delay[], double slow_arc_delay[], double output_arrival[], double output_slew[]);
+
+void propagateWireAvx2(const double root_arrival[], const double root_slew_sq[], const double wire_delay[], 
+	               const double slew_hat_sq[], double tap_arrival[], double tap_slew[]);
+
+#endif // GATE_KERNEL_H
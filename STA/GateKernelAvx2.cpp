@@ -0,0 +1,158 @@
+/************************************************************************
+ *   Define AVX2 lane kernels, where the four lanes of a pin, i.e., early
+ *   and late mode by fall and rise transition, are packed in one
+ *   register. Only functions of this file are compiled for AVX2, and
+ *   they are called only if the CPU supports it.
+ *
+ *   Delays and slews are computed by separate multiplies and adds in
+ *   the order of the scalar kernels, without fused multiply-add, so
+ *   results are bitwise identical to them.
+ *
+ *   Author      : Kuan-Hsien Ho
+************************************************************************/
+
+#include <immintrin.h>
+
+#include "ArcDelayTable.h"
+#include "Cell.h"
+#include "GateKernel.h"
+#include "TimingStore.h"
+
+//-----------------------------------------------------------------------
+//    Declare auxiliary functions
+//-----------------------------------------------------------------------
+
+bool detectAvx2();
+
+#pragma GCC push_options
+#pragma GCC target("avx2") // for the kernels only, down to pop_options
+
+// fold candidates by min in early-mode lanes and by max in late-mode lanes
+inline __m256d foldLanes( const __m256d &cur, const __m256d &val );
+
+//-----------------------------------------------------------------------
+//    Define lane kernels
+//-----------------------------------------------------------------------
+
+template<InputTimingTable::TimingSense SENSE>
+void propagateArcAvx2( const InputTimingTable &timing, const double input_arrival[], const double input_slew[], const double load[],
+	               double fast_arc_delay[], double slow_arc_delay[], double output_arrival[], double output_slew[] )
+{
+    static_assert( SENSE != InputTimingTable::UNKNOWN_UNATE, "no kernel of an unknown timing sense" );
+
+    // lanes: fast fall, fast rise, slow fall, slow rise of the output
+    const __m256d load_lanes = _mm256_setr_pd( load[FALL], load[RISE], load[FALL], load[RISE] );
+    const __m256d delay_base = _mm256_add_pd( _mm256_setr_pd(timing.FallDelayA, timing.RiseDelayA, timing.FallDelayA, timing.RiseDelayA),
+	                                      _mm256_mul_pd(_mm256_setr_pd(timing.FallDelayB, timing.RiseDelayB, timing.FallDelayB, timing.RiseDelayB), load_lanes) );
+    const __m256d delay_c = _mm256_setr_pd( timing.FallDelayC, timing.RiseDelayC, timing.FallDelayC, timing.RiseDelayC );
+    const __m256d slew_base = _mm256_add_pd( _mm256_setr_pd(timing.FallSlewX, timing.RiseSlewX, timing.FallSlewX, timing.RiseSlewX),
+	                                     _mm256_mul_pd(_mm256_setr_pd(timing.FallSlewY, timing.RiseSlewY, timing.FallSlewY, timing.RiseSlewY), load_lanes) );
+    const __m256d slew_z = _mm256_setr_pd( timing.FallSlewZ, timing.RiseSlewZ, timing.FallSlewZ, timing.RiseSlewZ );
+    const __m256d in_arrival = _mm256_loadu_pd( input_arrival );
+    const __m256d in_slew = _mm256_loadu_pd( input_slew );
+    __m256d out_arrival = _mm256_loadu_pd( output_arrival );
+    __m256d out_slew = _mm256_loadu_pd( output_slew );
+    __m256d cross_delay, same_delay;
+
+    // output transitions from opposite input transitions, i.e., fall and rise swapped in each mode
+    if constexpr( SENSE != InputTimingTable::POSITIVE_UNATE )
+    {
+	const __m256d cross_arrival = _mm256_permute_pd( in_arrival, 0x5 );
+	const __m256d cross_slew = _mm256_permute_pd( in_slew, 0x5 );
+	cross_delay = _mm256_add_pd( delay_base, _mm256_mul_pd(delay_c, cross_slew) );
+	out_arrival = foldLanes( out_arrival, _mm256_add_pd(cross_arrival, cross_delay) );
+	out_slew = foldLanes( out_slew, _mm256_add_pd(slew_base, _mm256_mul_pd(slew_z, cross_slew)) );
+    }
+
+    // output transitions from the same input transitions
+    if constexpr( SENSE != InputTimingTable::NEGATIVE_UNATE )
+    {
+	same_delay = _mm256_add_pd( delay_base, _mm256_mul_pd(delay_c, in_slew) );
+	out_arrival = foldLanes( out_arrival, _mm256_add_pd(in_arrival, same_delay) );
+	out_slew = foldLanes( out_slew, _mm256_add_pd(slew_base, _mm256_mul_pd(slew_z, in_slew)) );
+    }
+
+    _mm256_storeu_pd( output_arrival, out_arrival );
+    _mm256_storeu_pd( output_slew, out_slew );
+
+    // record delays by the slots of the arc
+    if constexpr( SENSE == InputTimingTable::POSITIVE_UNATE )
+    {
+	// output fall from input fall, output rise from input rise
+	_mm_storeu_pd( fast_arc_delay+ArcDelayTable::FROM_INPUT_FALL, _mm256_castpd256_pd128(same_delay) );
+	_mm_storeu_pd( slow_arc_delay+ArcDelayTable::FROM_INPUT_FALL, _mm256_extractf128_pd(same_delay, 1) );
+    }
+    else if constexpr( SENSE == InputTimingTable::NEGATIVE_UNATE )
+    {
+	// output rise from input fall, output fall from input rise
+	const __m256d slot_delay = _mm256_permute_pd( cross_delay, 0x5 );
+	_mm_storeu_pd( fast_arc_delay+ArcDelayTable::FROM_INPUT_FALL, _mm256_castpd256_pd128(slot_delay) );
+	_mm_storeu_pd( slow_arc_delay+ArcDelayTable::FROM_INPUT_FALL, _mm256_extractf128_pd(slot_delay, 1) );
+    }
+    else
+    {
+	// fall to fall, fall to rise, then rise to fall, rise to rise
+	const __m256d fall_slot_delay = _mm256_blend_pd( same_delay, cross_delay, 0xA );
+	const __m256d rise_slot_delay = _mm256_blend_pd( cross_delay, same_delay, 0xA );
+	_mm_storeu_pd( fast_arc_delay+ArcDelayTable::INPUT_FALL_OUTPUT_FALL, _mm256_castpd256_pd128(fall_slot_delay) );
+	_mm_storeu_pd( fast_arc_delay+ArcDelayTable::INPUT_RISE_OUTPUT_FALL, _mm256_castpd256_pd128(rise_slot_delay) );
+	_mm_storeu_pd( slow_arc_delay+ArcDelayTable::INPUT_FALL_OUTPUT_FALL, _mm256_extractf128_pd(fall_slot_delay, 1) );
+	_mm_storeu_pd( slow_arc_delay+ArcDelayTable::INPUT_RISE_OUTPUT_FALL, _mm256_extractf128_pd(rise_slot_delay, 1) );
+    }
+}
+
+template void propagateArcAvx2<InputTimingTable::POSITIVE_UNATE>( const InputTimingTable&, const double[], const double[], const double[],
+	                                                          double[], double[], double[], double[] );
+template void propagateArcAvx2<InputTimingTable::NEGATIVE_UNATE>( const InputTimingTable&, const double[], const double[], const double[],
+	                                                          double[], double[], double[], double[] );
+template void propagateArcAvx2<InputTimingTable::NON_UNATE>( const InputTimingTable&, const double[], const double[], const double[],
+	                                                     double[], double[], double[], double[] );
+
+void propagateWireAvx2( const double root_arrival[], const double root_slew_sq[], const double wire_delay[],
+	                const double slew_hat_sq[], double tap_arrival[], double tap_slew[] )
+{
+    const __m256d delay_lanes = _mm256_setr_pd( wire_delay[FALL], wire_delay[RISE], wire_delay[FALL], wire_delay[RISE] );
+    const __m256d slew_hat_sq_lanes = _mm256_setr_pd( slew_hat_sq[FALL], slew_hat_sq[RISE], slew_hat_sq[FALL], slew_hat_sq[RISE] );
+
+    _mm256_storeu_pd( tap_arrival, _mm256_add_pd(_mm256_loadu_pd(root_arrival), delay_lanes) );
+    _mm256_storeu_pd( tap_slew, _mm256_sqrt_pd(_mm256_add_pd(_mm256_loadu_pd(root_slew_sq), slew_hat_sq_lanes)) );
+}
+
+inline __m256d foldLanes( const __m256d &cur, const __m256d &val )
+{
+    // the same as std::min(cur, val) and std::max(cur, val) of scalar kernels
+    return _mm256_blend_pd( _mm256_min_pd(val, cur), _mm256_max_pd(val, cur), 0xC );
+}
+
+#pragma GCC pop_options
+
+//-----------------------------------------------------------------------
+//    Define dispatch
+//-----------------------------------------------------------------------
+
+static const bool is_avx2_supported = detectAvx2();
+static bool is_avx2_kernel_on = is_avx2_supported;
+
+bool getIsAvx2Supported()
+{
+    return is_avx2_supported;
+}
+
+bool getIsAvx2KernelOn()
+{
+    return is_avx2_kernel_on;
+}
+
+void setIsAvx2KernelOn( const bool &on )
+{
+    is_avx2_kernel_on = ( on && is_avx2_supported );
+
+    return;
+}
+
+bool detectAvx2()
+{
+    __builtin_cpu_init(); // before main()
+
+    return __builtin_cpu_supports("avx2");
+}
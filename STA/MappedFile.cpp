@@ -0,0 +1,73 @@
+/************************************************************************
+ *   Define member functions of class MappedFile: Open(), Close()
+ *
+ *   Author      : Kuan-Hsien Ho
+************************************************************************/
+
+#include <cstdio>
+#include <cstdlib>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "MappedFile.h"
+
+using namespace std;
+
+MappedFile::MappedFile(const char *file_name): _begin(NULL), _size(0)
+{
+    if( !Open(file_name) )
+    {
+	printf( "Error in opening %s for input\n", file_name );
+	printf( "  Exiting...\n" );
+	exit(-1);
+    }
+}
+
+bool MappedFile::Open(const char *file_name)
+{
+    Close();
+    const int fd = open( file_name, O_RDONLY );
+
+    if( fd < 0 )
+	return false;
+
+    struct stat file_stat;
+
+    if( fstat(fd, &file_stat) != 0 )
+    {
+	close(fd);
+	return false;
+    }
+
+    if( file_stat.st_size == 0 ) // nothing to map
+    {
+	close(fd);
+	return true;
+    }
+
+    void *addr = mmap( NULL, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+    close(fd); // the mapping keeps its own reference to the file
+
+    if( addr == MAP_FAILED )
+	return false;
+
+    madvise( addr, file_stat.st_size, MADV_SEQUENTIAL ); // files are parsed from head to tail
+    _begin = static_cast<const char *>(addr);
+    _size = file_stat.st_size;
+
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if( _begin != NULL )
+	munmap( const_cast<char *>(_begin), _size );
+
+    _begin = NULL;
+    _size = 0;
+
+    return;
+}
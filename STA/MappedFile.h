@@ -0,0 +1,119 @@
+/************************************************************************
+ *   Define a read-only memory-mapped input file and a zero-copy line
+ *   tokenizer working on it. Tokens are views into the mapped bytes, so
+ *   no line is copied and there is no limit on the line length.
+ *
+ *   Defined classes: MappedFile, LineTokenizer
+ *
+ *   Author      : Kuan-Hsien Ho
+************************************************************************/
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+
+#include "NumberParse.h"
+
+//-----------------------------------------------------------------------
+//    Declare classes
+//-----------------------------------------------------------------------
+
+class LineTokenizer;
+class MappedFile;
+
+//-----------------------------------------------------------------------
+//    Define classes
+//-----------------------------------------------------------------------
+
+class MappedFile
+{
+    public:
+	MappedFile(): _begin(NULL), _size(0) {}
+	MappedFile(const char *file_name); // exit if the file cannot be mapped
+	~MappedFile() { Close(); }
+
+	const char* GetBegin() const { return _begin; }
+	const char* GetEnd() const   { return _begin + _size; }
+	size_t GetSize() const       { return _size; }
+
+	bool Open(const char *file_name); // false if the file cannot be mapped
+	void Close();
+
+    private:
+	MappedFile(const MappedFile &);            // non-copyable
+	MappedFile& operator=(const MappedFile &);
+
+	const char *_begin; // NULL for an empty file
+	size_t _size;
+};
+
+// split a character range into lines, and each line into blank-separated tokens
+class LineTokenizer
+{
+    public:
+	LineTokenizer(const char *begin, const char *end): _pos(begin), _end(end), _line_end(begin) {}
+	LineTokenizer(const MappedFile &file): _pos(file.GetBegin()), _end(file.GetEnd()), _line_end(file.GetBegin()) {}
+
+	bool NextLine();              // move to next non-blank line; false at end of range
+	std::string_view NextToken(); // next token of current line; empty if the line is exhausted
+	double NextDouble() { return parseDouble(NextToken()); } // next token of current line as a number
+	std::string_view NextWord();  // next token, moving to following lines if needed; empty at end of range
+	double NextWordDouble() { return parseDouble(NextWord()); }
+
+    private:
+	static bool IsBlank(const char &c) { return (c == ' ' || c == '\t' || c == '\r'); }
+
+	const char *_pos;      // current position within the current line
+	const char *_end;      // end of the whole range
+	const char *_line_end; // end of the current line, i.e., at '\n' or _end
+};
+
+//-----------------------------------------------------------------------
+//    Define inline member functions
+//-----------------------------------------------------------------------
+
+inline bool LineTokenizer::NextLine()
+{
+    _pos = _line_end;
+
+    // skip the terminator of the previous line and any blank lines
+    while( _pos < _end && (*_pos == '\n' || IsBlank(*_pos)) )
+	++_pos;
+
+    if( _pos == _end )
+	return false;
+
+    const char *newline_ptr = static_cast<const char *>(memchr(_pos, '\n', _end-_pos));
+    _line_end = (newline_ptr == NULL)? _end: newline_ptr;
+
+    return true;
+}
+
+inline std::string_view LineTokenizer::NextToken()
+{
+    while( _pos < _line_end && IsBlank(*_pos) )
+	++_pos;
+
+    const char *token_ptr = _pos;
+
+    while( _pos < _line_end && !IsBlank(*_pos) )
+	++_pos;
+
+    return std::string_view(token_ptr, _pos-token_ptr);
+}
+
+inline std::string_view LineTokenizer::NextWord()
+{
+    std::string_view token = NextToken();
+
+    while( token.empty() && NextLine() )
+	token = NextToken();
+
+    return token;
+}
+
+#endif // MAPPED_FILE_H
@@ -0,0 +1,76 @@
+/************************************************************************
+ *   Define member functions of class NameTable: Reserve(), Reset(),
+ *   Clear(), Rehash()
+ *
+ *   Author      : Kuan-Hsien Ho
+************************************************************************/
+
+#include <algorithm>
+
+#include "NameTable.h"
+
+using namespace std;
+
+// reserve space for name_no names of total byte_no bytes to avoid rehashing while inserting
+void NameTable::Reserve(const unsigned &name_no, const size_t &byte_no)
+{
+    _byte_vec.reserve( byte_no );
+    _offset_vec.reserve( name_no+1 );
+    _hash_vec.reserve( name_no );
+
+    size_t slot_no = _slot_vec.size();
+
+    while( slot_no < 2*static_cast<size_t>(name_no) )
+	slot_no *= 2;
+
+    if( slot_no > _slot_vec.size() )
+	Rehash( slot_no );
+
+    return;
+}
+
+void NameTable::Reset()
+{
+    _byte_vec.clear();
+    _offset_vec.assign( 1, 0 );
+    _hash_vec.clear();
+
+    if( _slot_vec.size() > 16 ) // do not let one large table slow down all later small ones
+	_slot_vec.assign( 16, 0 );
+    else
+	fill( _slot_vec.begin(), _slot_vec.end(), 0 );
+
+    _slot_mask = _slot_vec.size()-1;
+
+    return;
+}
+
+void NameTable::Clear()
+{
+    vector<char>().swap( _byte_vec );
+    _offset_vec.assign( 1, 0 );
+    vector<uint32_t>().swap( _hash_vec );
+    _slot_vec.assign( 16, 0 );
+    _slot_mask = _slot_vec.size()-1;
+
+    return;
+}
+
+void NameTable::Rehash(const size_t &slot_no)
+{
+    assert( (slot_no & (slot_no-1)) == 0 ); // power of two
+    _slot_vec.assign( slot_no, 0 );
+    _slot_mask = slot_no-1;
+
+    for( unsigned id=0; id<_hash_vec.size(); ++id )
+    {
+	size_t i = (_hash_vec[id] & _slot_mask);
+
+	while( _slot_vec[i] != 0 )
+	    i = ((i+1) & _slot_mask);
+
+	_slot_vec[i] = id+1;
+    }
+
+    return;
+}
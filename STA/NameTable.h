@@ -0,0 +1,123 @@
+/************************************************************************
+ *   Define a name interning table which maps names to dense ids.
+ *   Names are kept back-to-back in a byte arena and looked up by an
+ *   open-addressing hash with linear probing, so finding or inserting
+ *   a name takes a single probe sequence and no per-name allocation.
+ *
+ *   Defined class: NameTable
+ *
+ *   Author      : Kuan-Hsien Ho
+************************************************************************/
+
+#ifndef NAME_TABLE_H
+#define NAME_TABLE_H
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+//-----------------------------------------------------------------------
+//    Declare classes
+//-----------------------------------------------------------------------
+
+class NameTable;
+
+//-----------------------------------------------------------------------
+//    Define class
+//-----------------------------------------------------------------------
+
+class NameTable
+{
+    public:
+	enum { NOT_FOUND = 0xffffffffu };
+
+	NameTable() { Clear(); }
+
+	unsigned GetNameNo() const { return _hash_vec.size(); }
+	std::string_view GetName(const unsigned &id) const {
+	    assert( id < _hash_vec.size() );
+	    return std::string_view(&(_byte_vec[_offset_vec[id]]), _offset_vec[id+1]-_offset_vec[id]); }
+
+	unsigned Find(std::string_view name) const;           // id of name, or NOT_FOUND
+	unsigned Grab(std::string_view name, bool &is_new);   // id of name; insert it with the next id if not found
+	void Reserve(const unsigned &name_no, const size_t &byte_no);
+	void Reset(); // drop all names but keep the arena capacity, for tables rebuilt many times
+	void Clear();
+
+    private:
+	static uint32_t Hash(std::string_view name);
+	void Rehash(const size_t &slot_no);
+
+	std::vector<char> _byte_vec;       // arena of name bytes
+	std::vector<size_t> _offset_vec;   // name id -> begin of name in _byte_vec, with an extra end offset
+	std::vector<uint32_t> _hash_vec;   // name id -> hash value, to reject mismatches and rehash fast
+	std::vector<unsigned> _slot_vec;   // hash slots storing (name id + 1), 0 for an empty slot
+	size_t _slot_mask;                 // slot number is a power of two
+};
+
+//-----------------------------------------------------------------------
+//    Define inline member functions
+//-----------------------------------------------------------------------
+
+// FNV-1a, names are short
+inline uint32_t NameTable::Hash(std::string_view name)
+{
+    uint32_t hash = 2166136261u;
+
+    for( size_t i=0; i<name.size(); ++i )
+    {
+	hash ^= static_cast<unsigned char>(name[i]);
+	hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+inline unsigned NameTable::Find(std::string_view name) const
+{
+    const uint32_t hash = Hash(name);
+
+    for( size_t i=(hash & _slot_mask); _slot_vec[i]!=0; i=((i+1) & _slot_mask) )
+    {
+	const unsigned id = _slot_vec[i]-1;
+
+	if( _hash_vec[id] == hash && GetName(id) == name )
+	    return id;
+    }
+
+    return NOT_FOUND;
+}
+
+inline unsigned NameTable::Grab(std::string_view name, bool &is_new)
+{
+    const uint32_t hash = Hash(name);
+    size_t i = (hash & _slot_mask);
+
+    for( ; _slot_vec[i]!=0; i=((i+1) & _slot_mask) )
+    {
+	const unsigned id = _slot_vec[i]-1;
+
+	if( _hash_vec[id] == hash && GetName(id) == name )
+	{
+	    is_new = false;
+	    return id;
+	}
+    }
+
+    // insert at the empty slot that ends the probe sequence
+    const unsigned id = _hash_vec.size();
+    _byte_vec.insert( _byte_vec.end(), name.begin(), name.end() );
+    _offset_vec.push_back( _byte_vec.size() );
+    _hash_vec.push_back( hash );
+    _slot_vec[i] = id+1;
+    is_new = true;
+
+    if( 2*_hash_vec.size() > _slot_vec.size() ) // keep load factor under 0.5
+	Rehash( 2*_slot_vec.size() );
+
+    return id;
+}
+
+#endif // NAME_TABLE_H
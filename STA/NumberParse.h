@@ -0,0 +1,40 @@
+/************************************************************************
+ *   Define the number parsing shared by the library and netlist
+ *   loaders. Numbers are parsed by std::from_chars, which is locale-free,
+ *   needs no null-terminated copy and rounds correctly, so the values are
+ *   the same as those of atof() or ifstream, only faster.
+ *
+ *   Author      : Kuan-Hsien Ho
+************************************************************************/
+
+#ifndef NUMBER_PARSE_H
+#define NUMBER_PARSE_H
+
+#include <charconv>
+#include <string_view>
+
+//-----------------------------------------------------------------------
+//    Declare functions
+//-----------------------------------------------------------------------
+
+double parseDouble( std::string_view token ); // 0.0 if token does not begin with a number, as atof()
+
+//-----------------------------------------------------------------------
+//    Define inline functions
+//-----------------------------------------------------------------------
+
+inline double parseDouble( std::string_view token )
+{
+    const char *begin = token.data();
+    const char *end = begin + token.size();
+
+    if( begin != end && *begin == '+' ) // accepted by atof() but not by from_chars()
+	++begin;
+
+    double val = 0.0;
+    std::from_chars( begin, end, val ); // val is untouched on failure
+
+    return val;
+}
+
+#endif // NUMBER_PARSE_H
@@ -0,0 +1,91 @@
+/************************************************************************
+ *   Define a bump allocator of objects of one type.
+ *   Objects are constructed in place in large blocks, and they live
+ *   until the arena is cleared or destroyed, which destroys them all and
+ *   frees only a few blocks. Pointers to objects stay valid while the
+ *   arena grows.
+ *
+ *   Defined class: ObjectArena
+ *
+ *   Author      : Kuan-Hsien Ho
+************************************************************************/
+
+#ifndef OBJECT_ARENA_H
+#define OBJECT_ARENA_H
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+//-----------------------------------------------------------------------
+//    Declare classes
+//-----------------------------------------------------------------------
+
+template<class T> class ObjectArena;
+
+//-----------------------------------------------------------------------
+//    Define class
+//-----------------------------------------------------------------------
+
+template<class T>
+class ObjectArena
+{
+    public:
+	static constexpr size_t BLOCK_OBJECT_NO = 4096; // objects per block
+
+	ObjectArena(): _block_object_no(BLOCK_OBJECT_NO) {}
+	~ObjectArena() { Clear(); }
+	ObjectArena(const ObjectArena&) = delete;
+	ObjectArena& operator=(const ObjectArena&) = delete;
+
+	size_t GetObjectNo() const { return (_block_vec.empty())? 0: (_block_vec.size()-1)*BLOCK_OBJECT_NO + _block_object_no; }
+
+	template<class... Args> T* Create(Args&&... args); // construct a new object in place
+	void Clear(); // destroy all objects and free all blocks
+
+    private:
+	std::vector<T*> _block_vec;
+	size_t _block_object_no; // objects in the last block
+};
+
+//-----------------------------------------------------------------------
+//    Define inline member functions
+//-----------------------------------------------------------------------
+
+template<class T>
+template<class... Args>
+inline T* ObjectArena<T>::Create(Args&&... args)
+{
+    if( _block_object_no == BLOCK_OBJECT_NO )
+    {
+	_block_vec.push_back( static_cast<T*>(::operator new(BLOCK_OBJECT_NO * sizeof(T))) );
+	_block_object_no = 0;
+    }
+
+    T *ptr = new( _block_vec.back() + _block_object_no ) T( std::forward<Args>(args)... );
+    ++_block_object_no;
+
+    return ptr;
+}
+
+template<class T>
+void ObjectArena<T>::Clear()
+{
+    for( size_t i=0; i<_block_vec.size(); ++i )
+    {
+	const size_t object_no = (i+1 == _block_vec.size())? _block_object_no: BLOCK_OBJECT_NO;
+
+	for( size_t j=0; j<object_no; ++j )
+	    _block_vec[i][j].~T();
+
+	::operator delete( _block_vec[i] );
+    }
+
+    _block_vec.clear();
+    _block_object_no = BLOCK_OBJECT_NO;
+
+    return;
+}
+
+#endif // OBJECT_ARENA_H
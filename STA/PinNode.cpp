@@ -1,5 +1,6 @@
 /************************************************************************
- *   Define member functions of class PinNode: PrintPinNodeWiringData()
+ *   Define member functions of class PinNode: GrabFanoutRCTreeNodeId(),
+ *   PrintPinNodeWiringData()
  *
  *   Author      : Kuan-Hsien Ho
 ************************************************************************/
@@ -9,6 +10,7 @@
 #include <cstring>
 #include <iostream>
 #include <string>
+#include <string_view>
 
 #include "Cell.h"
 #include "Gate.h"
@@ -16,40 +18,22 @@
 
 using namespace std;
 
-// Note the input augement n becomes NULL afterwards
-unsigned PinNode::GrabFanoutRCTreeNodeId(string &n)
+unsigned PinNode::GrabFanoutRCTreeNodeId(string_view n, NameTable &rc_node_name_table)
 {
-    unsigned i=0;
+    bool is_new;
+    const unsigned i = rc_node_name_table.Grab( n, is_new );
 
-    for( ; i<_fanout_rc_tree.size(); ++i )
-	if( _fanout_rc_tree[i].GetName() == n )
-	    return i;
+    if( is_new )
+	_fanout_rc_tree_ptr->AddNode(); // node ids follow name ids
 
-    _fanout_rc_tree.push_back( RCTreeNode(n) );
-    assert( _fanout_rc_tree.size() == (i+1) );
+    assert( i < _fanout_rc_tree_ptr->GetNodeNo() );
 
     return i;
 }
 
-// Note the input augement n becomes NULL afterwards
-unsigned PinNode::GrabFanoutRCTreeNodeId(const char *n)
+void PinNode::PrintPinNodeWiringData(const NameTable &pin_node_name_table) const
 {
-    string name = n;
-    unsigned i=0;
-
-    for( ; i<_fanout_rc_tree.size(); ++i )
-	if( _fanout_rc_tree[i].GetName() == name )
-	    return i;
-
-    _fanout_rc_tree.push_back( RCTreeNode(name) );
-    assert( _fanout_rc_tree.size() == (i+1) );
-
-    return i;
-}
-
-void PinNode::PrintPinNodeWiringData() const
-{
-    cout << "pin-node " << _name << endl;
+    cout << "pin-node " << pin_node_name_table.GetName(_id) << endl;
 
     if( _fanin_ptr == NULL )
 	cout << "  fanin: NULL" << endl;
@@ -59,7 +43,7 @@ void PinNode::PrintPinNodeWiringData() const
 	assert( _fanin_ptr->GetType() == PIN_NODE || _fanin_ptr->GetType() == GOUT_PIN );
 
 	if( _fanin_ptr->GetType() == PIN_NODE )
-	    cout << "pin-node " << static_cast<PinNode*>(_fanin_ptr)->GetName() << endl;
+	    cout << "pin-node " << pin_node_name_table.GetName(static_cast<PinNode*>(_fanin_ptr)->_id) << endl;
 	else
 	{
 	    GOutPin *gOutPin_ptr = static_cast<GOutPin*>(_fanin_ptr);
@@ -86,7 +70,7 @@ void PinNode::PrintPinNodeWiringData() const
 	assert( _fanout_ptr_vec[i]->GetType() == PIN_NODE || _fanout_ptr_vec[i]->GetType() == GIN_PIN );
 
 	if( _fanout_ptr_vec[i]->GetType() == PIN_NODE )
-	    cout << "pin-node " << static_cast<PinNode*>(_fanout_ptr_vec[i])->GetName() << endl;
+	    cout << "pin-node " << pin_node_name_table.GetName(static_cast<PinNode*>(_fanout_ptr_vec[i])->_id) << endl;
 	else
 	{
 	    GInPin *gInPin_ptr = static_cast<GInPin*>(_fanout_ptr_vec[i]);
@@ -109,12 +93,10 @@ void PinNode::PrintPinNodeWiringData() const
 
     assert( _fanin_ptr != NULL && _fanout_ptr_vec.size() > 0 );
 
-    cout << "  RC tree: ";
-
-    for( unsigned i=0; i<_fanout_rc_tree.size(); ++i )
-	cout << _fanout_rc_tree[i].GetName() << " ";
-
-    cout << endl;
+    if( _fanout_rc_tree_ptr == NULL )
+	cout << "  RC tree: reduced" << endl;
+    else
+	cout << "  RC tree: " << _fanout_rc_tree_ptr->GetNodeNo() << " nodes" << endl;
 
     return;
 }
@@ -1,5 +1,7 @@
 /************************************************************************
- *   Define the data structures of pin node for connectivity.
+ *   Define the data structures of pin node for connectivity. The name
+ *   and timing data of a pin node are kept by the circuit, in its name
+ *   table and timing store indexed by the pin-node id.
  *
  *   Defined class: PinNode
  *
@@ -10,19 +12,19 @@
 #define PIN_NODE_H
 
 #include <cassert>
-#include <string>
+#include <string_view>
 #include <vector>
 
 #include "Element.h"
+#include "NameTable.h"
 #include "parameterDefine.h"
-#include "RCTreeNode.h"
+#include "RCTree.h"
 
 //-----------------------------------------------------------------------
 //    Declare classes
 //-----------------------------------------------------------------------
 
 class PinNode;
-class RCTreeNode; // defined in RCTreeNode.h (cross reference)
 
 //-----------------------------------------------------------------------
 //    Define class
@@ -34,30 +36,18 @@ class PinNode: public Element
 	friend class Circuit;
 
 	// Constructors
-	PinNode(const char *n): _name(n), _is_not_visited(true), _fast_fall_arr_time(0.0), _fast_fall_req_time(MIN_REQ_TIME), _fast_fall_slew(0.0), _fast_rise_arr_time(0.0), _fast_rise_req_time(MIN_REQ_TIME), _fast_rise_slew(0.0), _slow_fall_arr_time(0.0), _slow_fall_req_time(MAX_REQ_TIME), _slow_fall_slew(0.0), _slow_rise_arr_time(0.0), _slow_rise_req_time(MAX_REQ_TIME), _slow_rise_slew(0.0), _fall_slew_hat_sq(0.0), _rise_slew_hat_sq(0.0), _fanin_ptr(NULL), _fanout_pin_node_no(0) {}
-
-	PinNode(const std::string &n): _name(n), _is_not_visited(true), _fast_fall_arr_time(0.0), _fast_fall_req_time(MIN_REQ_TIME), _fast_fall_slew(0.0), _fast_rise_arr_time(0.0), _fast_rise_req_time(MIN_REQ_TIME), _fast_rise_slew(0.0), _slow_fall_arr_time(0.0), _slow_fall_req_time(MAX_REQ_TIME), _slow_fall_slew(0.0), _slow_rise_arr_time(0.0), _slow_rise_req_time(MAX_REQ_TIME), _slow_rise_slew(0.0), _fall_slew_hat_sq(0.0), _rise_slew_hat_sq(0.0), _fanin_ptr(NULL), _fanout_pin_node_no(0) {}
+	PinNode(const unsigned &id): _id(id), _is_not_visited(true), _fall_slew_hat_sq(0.0), _rise_slew_hat_sq(0.0), _fanin_ptr(NULL), _fanout_pin_node_no(0), _fanout_rc_tree_ptr(NULL) {}
+	~PinNode() { delete _fanout_rc_tree_ptr; }
+	PinNode(const PinNode&) = delete; // owns its unreduced RC tree
+	PinNode& operator=(const PinNode&) = delete;
 
 	// Parents
 	Type GetType() { return PIN_NODE; }
 
 	// Get members
-	std::string GetName() { return _name; }
+	unsigned GetId() const { return _id; }
 	bool GetIsNotVisited() const { return _is_not_visited; }
 
-	double GetFastFallArrTime() { return _fast_fall_arr_time; }
-	double GetFastFallReqTime() { return _fast_fall_req_time; }
-	double GetFastFallSlew()    { return _fast_fall_slew; }
-	double GetFastRiseArrTime() { return _fast_rise_arr_time; }
-	double GetFastRiseReqTime() { return _fast_rise_req_time; }
-	double GetFastRiseSlew()    { return _fast_rise_slew; }
-	double GetSlowFallArrTime() { return _slow_fall_arr_time; }
-	double GetSlowFallReqTime() { return _slow_fall_req_time; }
-	double GetSlowFallSlew()    { return _slow_fall_slew; }
-	double GetSlowRiseArrTime() { return _slow_rise_arr_time; }
-	double GetSlowRiseReqTime() { return _slow_rise_req_time; }
-	double GetSlowRiseSlew()    { return _slow_rise_slew; }
-
 	double GetFallSlewHatSq()   { return _fall_slew_hat_sq; }
 	double GetRiseSlewHatSq()   { return _rise_slew_hat_sq; }
 
@@ -75,19 +65,6 @@ class PinNode: public Element
 
 	// Set members
 	void SetIsVisited()                 { _is_not_visited = false; }
-	void SetFastFallArrTime(double val) { _fast_fall_arr_time = val; } 
-	void SetFastFallReqTime(double val) { if(val > _fast_fall_req_time) {_fast_fall_req_time = val;} }
-	void SetFastFallSlew(double val)    { _fast_fall_slew = val; }
-	void SetFastRiseArrTime(double val) { _fast_rise_arr_time = val; }
-	void SetFastRiseReqTime(double val) { if(val > _fast_rise_req_time) {_fast_rise_req_time = val;} }
-	void SetFastRiseSlew(double val)    { _fast_rise_slew = val; }
-	void SetSlowFallArrTime(double val) { _slow_fall_arr_time = val; }
-	void SetSlowFallReqTime(double val) { if(val < _slow_fall_req_time) {_slow_fall_req_time = val;} }
-	void SetSlowFallSlew(double val)    { _slow_fall_slew = val; }
-	void SetSlowRiseArrTime(double val) { _slow_rise_arr_time = val; }
-	void SetSlowRiseReqTime(double val) { if(val < _slow_rise_req_time) {_slow_rise_req_time = val;} }
-	void SetSlowRiseSlew(double val)    { _slow_rise_slew = val; }
-
 	void SetFallSlewHatSq(double val)   { _fall_slew_hat_sq = val; }
 	void SetRiseSlewHatSq(double val)   { _rise_slew_hat_sq = val; }
 
@@ -95,33 +72,18 @@ class PinNode: public Element
 	void SetFanoutPtrVec(unsigned id, Element *element_ptr) {
 	    assert(id < _fanout_ptr_vec.size()); _fanout_ptr_vec[id] = element_ptr; }
 
-        std::vector<RCTreeNode>& FetFanoutRCTree() { return _fanout_rc_tree; }
+	RCTree* GetFanoutRCTreePtr() { return _fanout_rc_tree_ptr; }
+	void ClearFanoutRCTree()     { delete _fanout_rc_tree_ptr; _fanout_rc_tree_ptr = NULL; }
 
 	// Others
-	unsigned GrabFanoutRCTreeNodeId(std::string &n); // get id if exists, if not, new a node, then swap name, return id
-	unsigned GrabFanoutRCTreeNodeId(const char *n);
-	void PrintPinNodeWiringData() const;
+	// get id if exists, if not, new a node, return id; rc_node_name_table maps names to node ids of _fanout_rc_tree_ptr
+	unsigned GrabFanoutRCTreeNodeId(std::string_view n, NameTable &rc_node_name_table);
+	void PrintPinNodeWiringData(const NameTable &pin_node_name_table) const; // names by pin-node id
 
     private:
-	std::string _name;
+	unsigned _id; // dense pin-node id, i.e., index of name in the circuit pin-node name table and of the timing store
 	bool _is_not_visited;
 
-	// early timing analysis
-	double _fast_fall_arr_time;
-        double _fast_fall_req_time;
-	double _fast_fall_slew;
-	double _fast_rise_arr_time;
-	double _fast_rise_req_time;
-	double _fast_rise_slew;
-
-	// late timing analysis
-	double _slow_fall_arr_time;
-        double _slow_fall_req_time;
-	double _slow_fall_slew;
-	double _slow_rise_arr_time;
-	double _slow_rise_req_time;
-	double _slow_rise_slew;
-
 	double _fall_slew_hat_sq; // square of output slew hat 
 	double _rise_slew_hat_sq; 
 
@@ -130,7 +92,7 @@ class PinNode: public Element
 	std::vector<Element *> _fanout_ptr_vec;
 	unsigned _fanout_pin_node_no; // use for very special case that leaf_pnode_no < _fanout_ptr_vec.size()
 
-	std::vector<RCTreeNode> _fanout_rc_tree;
+	RCTree *_fanout_rc_tree_ptr; // only for the root of a wire not reduced yet
 };
 
 #endif // PIN_NODE_H
@@ -5,14 +5,15 @@
 ************************************************************************/
 
 #include <cstdio>
+#include <string>
 
 #include "RATData.h"
 
 using namespace std;
 
-void RATData::PrintRATData() const
+void RATData::PrintRATData(const NameTable &pin_node_name_table) const
 {
-    printf( "RAT: %s ", (*PinNodePtr).GetName().c_str() );
+    printf( "RAT: %s ", string(pin_node_name_table.GetName(PinNodePtr->GetId())).c_str() );
 
     if( Mode == FAST )
 	printf( "early %.5le %.5le\n", FastFallTime, FastRiseTime );
@@ -10,7 +10,6 @@
 #define RAT_DATA_H
 
 #include <cassert>
-#include <string>
 
 #include "PinNode.h"
 
@@ -34,16 +33,12 @@ class RATData
 	    BOTH  // both late and early mode
 	};
 
+	enum { NO_DATA = 0xffffffffu }; // id of a pin node without required time constraints
+
         RATData(PinNode *ptr, ModeType m, double sf_t, double sr_t, double ff_t, double fr_t): 
 	    PinNodePtr(ptr), Mode(m), SlowFallTime(sf_t), SlowRiseTime(sr_t), FastFallTime(ff_t), FastRiseTime(fr_t) {}
 
-	std::string GetPinNodeName() const { assert( PinNodePtr!=NULL ); return PinNodePtr->GetName(); }
-	void PrintRATData() const;
-
-	bool operator < (const RATData &rhs) const
-	{
-	    return (this->GetPinNodeName() < rhs.GetPinNodeName());
-	}
+	void PrintRATData(const NameTable &pin_node_name_table) const; // names by pin-node id
 
 	// member variables
 	PinNode *PinNodePtr;
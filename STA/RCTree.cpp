@@ -0,0 +1,129 @@
+/************************************************************************
+ *   Define member functions of class RCTree: Flatten(), KeepNodeNames(),
+ *   FindPos()
+ *
+ *   Author      : Kuan-Hsien Ho
+************************************************************************/
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "RCTree.h"
+
+using namespace std;
+
+// fanout nodes of a node are placed in the reverse order of their resistors, so that a backward loop
+// adding each node to its fanin node sums the fanouts in the same order as the resistors were given
+void RCTree::Flatten(const unsigned &leaf_no)
+{
+    assert( !_is_flat && _cap_vec.size() > leaf_no );
+    const unsigned node_no = _cap_vec.size();
+    const unsigned res_no = _res_vec.size();
+
+    // adjacent (node id, resistance) lists of all nodes in one array, each in the order of resistors
+    vector<unsigned> adj_begin_vec(node_no+1, 0);
+
+    for( unsigned i=0; i<2*res_no; ++i )
+	++adj_begin_vec[_link_vec[i]+1];
+
+    for( unsigned i=0; i<node_no; ++i )
+	adj_begin_vec[i+1] += adj_begin_vec[i];
+
+    vector<pair<unsigned, double> > adj_vec(2*res_no);
+    vector<unsigned> adj_end_vec(adj_begin_vec.begin(), adj_begin_vec.end()-1);
+
+    for( unsigned i=0; i<res_no; ++i )
+    {
+	const unsigned end1_id = _link_vec[2*i], end2_id = _link_vec[2*i+1];
+
+	adj_vec[adj_end_vec[end1_id]++] = pair<unsigned, double>(end2_id, _res_vec[i]);
+	adj_vec[adj_end_vec[end2_id]++] = pair<unsigned, double>(end1_id, _res_vec[i]);
+    }
+
+    // breadth-first traversal from the root
+    vector<unsigned> pos_vec(node_no, NO_POS); // node id -> position
+    vector<unsigned> id_vec;                   // position -> node id
+    vector<unsigned> fanin_pos_vec;
+    vector<double> res_vec;
+
+    id_vec.reserve(node_no);
+    fanin_pos_vec.reserve(node_no);
+    res_vec.reserve(node_no);
+    pos_vec[0] = 0;
+    id_vec.push_back(0);
+    fanin_pos_vec.push_back(0); // no use for the root
+    res_vec.push_back(0.0);
+
+    for( unsigned i=0; i<id_vec.size(); ++i )
+    {
+	const unsigned cur_id = id_vec[i];
+	const unsigned first_pos = id_vec.size();
+
+	for( unsigned j=adj_begin_vec[cur_id]; j<adj_begin_vec[cur_id+1]; ++j )
+	{
+	    const unsigned adj_id = adj_vec[j].first;
+
+	    if( pos_vec[adj_id] == NO_POS ) // otherwise it is the fanin node
+	    {
+		pos_vec[adj_id] = id_vec.size();
+		id_vec.push_back(adj_id);
+		fanin_pos_vec.push_back(i);
+		res_vec.push_back(adj_vec[j].second);
+	    }
+	}
+
+	reverse( id_vec.begin()+first_pos, id_vec.end() );
+	reverse( res_vec.begin()+first_pos, res_vec.end() );
+
+	for( unsigned j=first_pos; j<id_vec.size(); ++j )
+	    pos_vec[id_vec[j]] = j;
+    }
+
+    vector<double> cap_vec(id_vec.size());
+
+    for( unsigned i=0; i<id_vec.size(); ++i )
+	cap_vec[i] = _cap_vec[id_vec[i]];
+
+    if( HasNodeNames() )
+    {
+	vector<string> name_vec(id_vec.size());
+
+	for( unsigned i=0; i<id_vec.size(); ++i )
+	    name_vec[i].swap( _node_name_vec[id_vec[i]] );
+
+	_node_name_vec.swap(name_vec);
+    }
+
+    _leaf_pos_vec.assign( pos_vec.begin(), pos_vec.begin()+leaf_no+1 );
+    _cap_vec.swap(cap_vec);
+    _res_vec.swap(res_vec);
+    _link_vec.swap(fanin_pos_vec);
+    _is_flat = true;
+
+    return;
+}
+
+void RCTree::KeepNodeNames(const NameTable &rc_node_name_table)
+{
+    assert( !_is_flat && rc_node_name_table.GetNameNo() == GetNodeNo() );
+    _node_name_vec.resize( GetNodeNo() );
+
+    for( unsigned i=0; i<GetNodeNo(); ++i )
+	_node_name_vec[i] = rc_node_name_table.GetName(i);
+
+    return;
+}
+
+// linear, since the tree is edited rarely and its delays are recomputed in linear time anyway
+unsigned RCTree::FindPos(string_view name) const
+{
+    assert( _is_flat );
+
+    for( unsigned i=0; i<_node_name_vec.size(); ++i )
+	if( _node_name_vec[i] == name )
+	    return i;
+
+    return NO_POS;
+}
@@ -0,0 +1,83 @@
+/************************************************************************
+ *   Define the RC tree of a wire for wiring delay estimation.
+ *   While loading, nodes are numbered in reading order and resistors are
+ *   kept as an edge list. Flatten() then turns the tree into a parent-
+ *   index array, a resistance array and a capacitance array, all indexed
+ *   by positions in topological order, so that loads and delays can be
+ *   accumulated by plain backward and forward loops.
+ *
+ *   A tree kept after wiring for editing parasitics also keeps its node
+ *   names, so that its resistors and capacitors can be found by name
+ *   and changed in the flat form, whose topology does not change.
+ *
+ *   Defined class: RCTree
+ *
+ *   Author      : Kuan-Hsien Ho
+************************************************************************/
+
+#ifndef RCTREE_H
+#define RCTREE_H
+
+#include <cassert>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "NameTable.h"
+
+//-----------------------------------------------------------------------
+//    Declare classes
+//-----------------------------------------------------------------------
+
+class RCTree;
+
+//-----------------------------------------------------------------------
+//    Define class
+//-----------------------------------------------------------------------
+
+class RCTree
+{
+    public:
+	enum { NO_POS = 0xffffffffu };
+
+	RCTree(): _is_flat(false) {}
+
+	bool IsFlat() const        { return _is_flat; }
+	unsigned GetNodeNo() const { return _cap_vec.size(); }
+
+	// building, before flattening: the root is node 0, and nodes 1 to leaf_no are the taps
+	unsigned AddNode() { assert( !_is_flat ); _cap_vec.push_back(0.0); return _cap_vec.size()-1; }
+	void AddRes(const unsigned &end1_id, const unsigned &end2_id, const double &res) {
+	    assert( !_is_flat && end1_id < _cap_vec.size() && end2_id < _cap_vec.size() );
+	    _link_vec.push_back(end1_id); _link_vec.push_back(end2_id); _res_vec.push_back(res); }
+	void SetCap(const unsigned &id, const double &cap) { assert( !_is_flat && id < _cap_vec.size() ); _cap_vec[id] = cap; }
+
+	// reorder nodes breadth-first from the root; nodes not connected to the root are dropped
+	void Flatten(const unsigned &leaf_no);
+
+	// node names of a tree kept for editing, where names of rc_node_name_table are node ids
+	void KeepNodeNames(const NameTable &rc_node_name_table);
+	bool HasNodeNames() const { return !_node_name_vec.empty(); }
+	unsigned FindPos(std::string_view name) const; // flat form; NO_POS if no such node connected to the root
+
+	// flat form: the root is at position 0 and every other node is behind its fanin node,
+	// and fanout nodes of a node take consecutive positions
+	unsigned GetFaninPos(const unsigned &pos) const { assert( _is_flat && pos < _link_vec.size() ); return _link_vec[pos]; }
+	double GetRes(const unsigned &pos) const        { assert( _is_flat && pos < _res_vec.size() ); return _res_vec[pos]; }
+	double GetCap(const unsigned &pos) const        { assert( _is_flat && pos < _cap_vec.size() ); return _cap_vec[pos]; }
+	unsigned GetLeafNo() const { assert( _is_flat ); return _leaf_pos_vec.size()-1; }
+	unsigned GetLeafPos(const unsigned &leaf_id) const { // NO_POS if the tap is not connected
+	    assert( _is_flat && leaf_id < _leaf_pos_vec.size() ); return _leaf_pos_vec[leaf_id]; }
+	void SetFlatRes(const unsigned &pos, const double &res) { assert( _is_flat && pos > 0 && pos < _res_vec.size() ); _res_vec[pos] = res; }
+	void SetFlatCap(const unsigned &pos, const double &cap) { assert( _is_flat && pos < _cap_vec.size() ); _cap_vec[pos] = cap; }
+
+    private:
+	bool _is_flat;
+	std::vector<double> _cap_vec;         // capacitance by node id, or by position if flat
+	std::vector<double> _res_vec;         // resistance by resistor, or resistance to fanin node by position if flat
+	std::vector<unsigned> _link_vec;      // two end node ids by resistor, or fanin position by position if flat
+	std::vector<unsigned> _leaf_pos_vec;  // position by tap node id if flat, the one in id 0 is the root
+	std::vector<std::string> _node_name_vec; // name by node id, or by position if flat; empty if not kept
+};
+
+#endif // RCTREE_H
@@ -0,0 +1,191 @@
+/************************************************************************
+ *   Define member functions of class ThreadPool: ThreadPool(),
+ *   ~ThreadPool(), Run(), Push(), ParallelFor(), WorkLoop(), RunTasks(),
+ *   PopOrSteal()
+ *
+ *   Author      : Kuan-Hsien Ho
+************************************************************************/
+
+#include <cassert>
+
+#include "ThreadPool.h"
+
+using namespace std;
+
+ThreadPool::ThreadPool(unsigned thread_no): _func_ptr(NULL), _pending_task_no(0), _run_no(0), _busy_thread_no(0), _is_stopping(false)
+{
+    if( thread_no == 0 )
+	thread_no = thread::hardware_concurrency();
+
+    if( thread_no == 0 ) // unknown
+	thread_no = 1;
+
+    vector<TaskQueue>(thread_no).swap( _queue_vec );
+    _thread_vec.reserve( thread_no-1 );
+
+    for( unsigned i=1; i<thread_no; ++i )
+	_thread_vec.push_back( thread(&ThreadPool::WorkLoop, this, i) );
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+	lock_guard<mutex> lock( _mutex );
+	_is_stopping = true;
+    }
+
+    _start_cv.notify_all();
+
+    for( unsigned i=0; i<_thread_vec.size(); ++i )
+	_thread_vec[i].join();
+}
+
+void ThreadPool::Run(const vector<unsigned> &task_vec, const TaskFunc &func)
+{
+    if( task_vec.size() == 0 )
+	return;
+
+    _func_ptr = &func;
+    _pending_task_no.store( task_vec.size() );
+
+    // deal tasks in turn to the front, so every worker pops its most costly one first from the back if tasks
+    // are sorted by cost, and thieves take the cheapest ones
+    for( unsigned i=0; i<task_vec.size(); ++i )
+	_queue_vec[i % _queue_vec.size()].Deque.push_front( task_vec[i] );
+
+    if( _thread_vec.size() == 0 ) // serial
+    {
+	RunTasks(0);
+	return;
+    }
+
+    {
+	lock_guard<mutex> lock( _mutex );
+	_busy_thread_no = _thread_vec.size();
+	++_run_no;
+    }
+
+    _start_cv.notify_all();
+    RunTasks(0);
+
+    unique_lock<mutex> lock( _mutex );
+    _done_cv.wait( lock, [this]{ return _busy_thread_no == 0; } );
+
+    return;
+}
+
+void ThreadPool::Push(const unsigned &worker_id, const unsigned &task)
+{
+    assert( worker_id < _queue_vec.size() );
+    _pending_task_no.fetch_add( 1 ); // before the pushing task is finished, so the run cannot end early
+
+    TaskQueue &queue = _queue_vec[worker_id];
+    lock_guard<mutex> lock( queue.Mutex );
+    queue.Deque.push_back( task );
+
+    return;
+}
+
+void ThreadPool::ParallelFor(const unsigned &task_no, const unsigned &chunk_size, const RangeFunc &func)
+{
+    assert( chunk_size > 0 );
+    const unsigned chunk_no = (task_no + chunk_size - 1) / chunk_size;
+
+    if( chunk_no <= 1 || _thread_vec.size() == 0 )
+    {
+	if( task_no > 0 )
+	    func( 0, 0, task_no );
+
+	return;
+    }
+
+    vector<unsigned> chunk_vec( chunk_no );
+
+    for( unsigned i=0; i<chunk_no; ++i )
+	chunk_vec[i] = i;
+
+    const TaskFunc chunk_func = [&](unsigned worker_id, unsigned chunk_id) {
+	const unsigned begin = chunk_id * chunk_size;
+	func( worker_id, begin, (begin + chunk_size < task_no)? begin + chunk_size: task_no ); };
+
+    Run( chunk_vec, chunk_func );
+
+    return;
+}
+
+void ThreadPool::WorkLoop(const unsigned worker_id)
+{
+    unsigned seen_run_no = 0;
+
+    while( true )
+    {
+	{
+	    unique_lock<mutex> lock( _mutex );
+	    _start_cv.wait( lock, [&]{ return _is_stopping || _run_no != seen_run_no; } );
+
+	    if( _is_stopping )
+		return;
+
+	    seen_run_no = _run_no;
+	}
+
+	RunTasks( worker_id );
+
+	{
+	    lock_guard<mutex> lock( _mutex );
+
+	    if( --_busy_thread_no == 0 )
+		_done_cv.notify_all();
+	}
+    }
+}
+
+void ThreadPool::RunTasks(const unsigned worker_id)
+{
+    unsigned task;
+
+    while( _pending_task_no.load() > 0 )
+    {
+	if( PopOrSteal(worker_id, task) )
+	{
+	    (*_func_ptr)( worker_id, task );
+	    _pending_task_no.fetch_sub( 1 );
+	}
+	else
+	    this_thread::yield(); // running tasks may still push new ones
+    }
+
+    return;
+}
+
+bool ThreadPool::PopOrSteal(const unsigned worker_id, unsigned &task)
+{
+    const unsigned queue_no = _queue_vec.size();
+
+    {
+	TaskQueue &queue = _queue_vec[worker_id]; // own deque first, newest task to go depth first
+	lock_guard<mutex> lock( queue.Mutex );
+
+	if( !queue.Deque.empty() )
+	{
+	    task = queue.Deque.back();
+	    queue.Deque.pop_back();
+	    return true;
+	}
+    }
+
+    for( unsigned i=1; i<queue_no; ++i ) // steal the oldest task of another deque
+    {
+	TaskQueue &queue = _queue_vec[(worker_id + i) % queue_no];
+	lock_guard<mutex> lock( queue.Mutex );
+
+	if( !queue.Deque.empty() )
+	{
+	    task = queue.Deque.front();
+	    queue.Deque.pop_front();
+	    return true;
+	}
+    }
+
+    return false;
+}
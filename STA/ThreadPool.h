@@ -0,0 +1,81 @@
+/************************************************************************
+ *   Define a work-stealing thread pool. Each worker owns a task deque;
+ *   a worker pops the newest task from the back of its own deque, so
+ *   tasks it pushes are run depth first while their data is still in
+ *   cache, and steals the oldest task from the front of the others when
+ *   its deque is empty. Tasks dealt in decreasing cost are run roughly
+ *   largest first. Threads persist across runs, and the caller of Run()
+ *   works as worker 0.
+ *
+ *   Defined class: ThreadPool
+ *
+ *   Author      : Kuan-Hsien Ho
+************************************************************************/
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//-----------------------------------------------------------------------
+//    Declare classes
+//-----------------------------------------------------------------------
+
+class ThreadPool;
+
+//-----------------------------------------------------------------------
+//    Define classes
+//-----------------------------------------------------------------------
+
+class ThreadPool
+{
+    public:
+	typedef std::function<void(unsigned worker_id, unsigned task)> TaskFunc;
+	typedef std::function<void(unsigned worker_id, unsigned begin, unsigned end)> RangeFunc;
+
+	ThreadPool(unsigned thread_no); // 0 for the number of hardware threads
+	~ThreadPool();
+
+	unsigned GetThreadNo() const { return _queue_vec.size(); }
+
+	// run func on every task of task_vec and every task pushed while running; return when all are done
+	void Run(const std::vector<unsigned> &task_vec, const TaskFunc &func);
+	void Push(const unsigned &worker_id, const unsigned &task); // only called by a task of Run()
+
+	// run func on chunks of [0, task_no) with at most chunk_size tasks each
+	void ParallelFor(const unsigned &task_no, const unsigned &chunk_size, const RangeFunc &func);
+
+    private:
+	struct TaskQueue
+	{
+	    std::mutex Mutex;
+	    std::deque<unsigned> Deque;
+	};
+
+	ThreadPool(const ThreadPool &);            // non-copyable
+	ThreadPool& operator=(const ThreadPool &);
+
+	void WorkLoop(const unsigned worker_id);  // body of threads
+	void RunTasks(const unsigned worker_id);  // run own and stolen tasks until all tasks are done
+	bool PopOrSteal(const unsigned worker_id, unsigned &task);
+
+	std::vector<TaskQueue> _queue_vec;      // one per worker
+	std::vector<std::thread> _thread_vec;   // workers 1, 2, ...
+	const TaskFunc *_func_ptr;              // function of the current run
+	std::atomic<size_t> _pending_task_no;   // tasks not finished in the current run
+
+	std::mutex _mutex;                      // guard of the following members
+	std::condition_variable _start_cv;      // a run starts, or the pool stops
+	std::condition_variable _done_cv;       // all threads leave a run
+	unsigned _run_no;                       // number of runs started
+	unsigned _busy_thread_no;               // threads still in the current run
+	bool _is_stopping;
+};
+
+#endif // THREAD_POOL_H
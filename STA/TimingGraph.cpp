@@ -0,0 +1,290 @@
+/************************************************************************
+ *   Define member functions of class TimingGraph: Build(), FetGOutPin(),
+ *   FindGateId(), UpdateWireData(), Levelize()
+ *
+ *   Author      : Kuan-Hsien Ho
+************************************************************************/
+
+#include <unordered_map>
+
+#include "Circuit.h"
+#include "Gate.h"
+#include "PinNode.h"
+#include "TimingGraph.h"
+
+using namespace std;
+
+void TimingGraph::Build(Circuit &circuit)
+{
+    assert( !IsBuilt() );
+    _PI_no = circuit.GetPINo();
+    _PO_no = circuit.GetPONo();
+    _ComGate_no = circuit.GetComGateNo();
+    _gate_ptr_vec.reserve( circuit.GetTotGateNo() );
+
+    for( unsigned i=0; i<circuit.GetPINo(); ++i )
+	_gate_ptr_vec.push_back( circuit.GetPIPtr(i) );
+
+    _gate_ptr_vec.insert( _gate_ptr_vec.end(), circuit.FetPOPtrVec().begin(), circuit.FetPOPtrVec().end() );
+    _gate_ptr_vec.insert( _gate_ptr_vec.end(), circuit.FetComGatePtrVec().begin(), circuit.FetComGatePtrVec().end() );
+    _gate_ptr_vec.insert( _gate_ptr_vec.end(), circuit.FetSeqGatePtrVec().begin(), circuit.FetSeqGatePtrVec().end() );
+
+    const unsigned gate_no = _gate_ptr_vec.size();
+    unordered_map<const Gate*, unsigned> gate_id_map; // only for building
+    gate_id_map.reserve( gate_no );
+    _input_begin_vec.assign( 1, 0 );
+    _output_begin_vec.assign( 1, 0 );
+
+    // gates and their pins
+    for( unsigned i=0; i<gate_no; ++i )
+    {
+	Gate &cur_gate = *(_gate_ptr_vec[i]);
+	gate_id_map[&cur_gate] = i;
+
+	for( unsigned j=0; j<cur_gate.GetInputNo(); ++j )
+	{
+	    PinNode *pnode_ptr = cur_gate.GetInputPinNode(j);
+	    _input_pin_node_id_vec.push_back( (pnode_ptr == NULL)? NO_ID: pnode_ptr->GetId() );
+	    _input_gate_id_vec.push_back(i);
+	}
+
+	for( unsigned j=0; j<cur_gate.GetOutputNo(); ++j )
+	{
+	    PinNode *pnode_ptr = cur_gate.GetOutputPinNode(j);
+	    _output_pin_node_id_vec.push_back( (pnode_ptr == NULL)? NO_ID: pnode_ptr->GetId() );
+	    _output_gate_id_vec.push_back(i);
+	}
+
+	_input_begin_vec.push_back( _input_pin_node_id_vec.size() );
+	_output_begin_vec.push_back( _output_pin_node_id_vec.size() );
+    }
+
+    assert( _input_pin_node_id_vec.size() <= ID_MASK && _output_pin_node_id_vec.size() <= ID_MASK );
+
+    // pin nodes
+    const vector<PinNode*> &pnode_ptr_vec = circuit.FetPinNodePtrVec();
+    const unsigned pnode_no = pnode_ptr_vec.size();
+    assert( pnode_no <= ID_MASK );
+    _fanout_begin_vec.assign( 1, 0 );
+    _fanin_vec.assign( pnode_no, NO_ID );
+    _tap_input_id_vec.assign( pnode_no, NO_ID );
+    _wire_fall_delay_vec.assign( pnode_no, 0.0 );
+    _wire_rise_delay_vec.assign( pnode_no, 0.0 );
+    _fall_slew_hat_sq_vec.assign( pnode_no, 0.0 );
+    _rise_slew_hat_sq_vec.assign( pnode_no, 0.0 );
+
+    for( unsigned i=0; i<pnode_no; ++i )
+    {
+	PinNode &cur_pnode = *(pnode_ptr_vec[i]);
+	assert( cur_pnode.GetId() == i );
+
+	for( unsigned j=0; j<cur_pnode.GetFanoutNo(); ++j )
+	{
+	    Element *fanout_ptr = cur_pnode.GetFanoutPtr(j);
+
+	    if( fanout_ptr->GetType() == Element::PIN_NODE )
+		_fanout_vec.push_back( MakeHandle(PIN_NODE, static_cast<PinNode*>(fanout_ptr)->GetId()) );
+	    else
+	    {
+		assert( fanout_ptr->GetType() == Element::GIN_PIN );
+		GInPin *gin_pin_ptr = static_cast<GInPin*>(fanout_ptr);
+		Gate *gate_ptr = gin_pin_ptr->GetGatePtr();
+		const unsigned input_id = _input_begin_vec[gate_id_map[gate_ptr]] + (gin_pin_ptr - &(gate_ptr->FetGInPin(0)));
+		_fanout_vec.push_back( MakeHandle(GATE_INPUT, input_id) );
+	    }
+	}
+
+	_fanout_begin_vec.push_back( _fanout_vec.size() );
+	Element *fanin_ptr = cur_pnode.GetFaninPtr();
+
+	if( fanin_ptr == NULL )
+	    continue;
+
+	if( fanin_ptr->GetType() == Element::PIN_NODE ) // tap of a wire
+	{
+	    _fanin_vec[i] = MakeHandle(PIN_NODE, static_cast<PinNode*>(fanin_ptr)->GetId());
+	    _fall_slew_hat_sq_vec[i] = cur_pnode.GetFallSlewHatSq();
+	    _rise_slew_hat_sq_vec[i] = cur_pnode.GetRiseSlewHatSq();
+
+	    if( cur_pnode.GetFanoutNo() > 0 )
+	    {
+		assert( GetKind(_fanout_vec[_fanout_begin_vec[i]]) == GATE_INPUT );
+		GInPin &gin_pin = *(static_cast<GInPin*>(cur_pnode.GetFanoutPtr(0)));
+		_tap_input_id_vec[i] = GetHandleId( _fanout_vec[_fanout_begin_vec[i]] );
+		_wire_fall_delay_vec[i] = gin_pin.GetFallArrDelay();
+		_wire_rise_delay_vec[i] = gin_pin.GetRiseArrDelay();
+	    }
+	}
+	else
+	{
+	    assert( fanin_ptr->GetType() == Element::GOUT_PIN );
+	    GOutPin *gout_pin_ptr = static_cast<GOutPin*>(fanin_ptr);
+	    Gate *gate_ptr = gout_pin_ptr->GetGatePtr();
+	    const unsigned output_id = _output_begin_vec[gate_id_map[gate_ptr]] + (gout_pin_ptr - &(gate_ptr->FetGOutPin(0)));
+	    _fanin_vec[i] = MakeHandle(GATE_OUTPUT, output_id);
+	}
+    }
+
+    _is_built = true;
+
+    return;
+}
+
+GOutPin& TimingGraph::FetGOutPin(const unsigned &output_id) const
+{
+    const unsigned gate_id = _output_gate_id_vec[output_id];
+
+    return _gate_ptr_vec[gate_id]->FetGOutPin( output_id - _output_begin_vec[gate_id] );
+}
+
+// by a pin node of the gate, i.e., the fanin of an output pin node or a fanout of an input pin node
+unsigned TimingGraph::FindGateId(Gate &gate) const
+{
+    for( unsigned i=0; i<gate.GetOutputNo(); ++i )
+    {
+	if( gate.GetOutputPinNode(i) == NULL )
+	    continue;
+
+	const unsigned fanin = _fanin_vec[ gate.GetOutputPinNode(i)->GetId() ];
+
+	if( fanin != NO_ID && GetKind(fanin) == GATE_OUTPUT && _gate_ptr_vec[ _output_gate_id_vec[GetHandleId(fanin)] ] == &gate )
+	    return _output_gate_id_vec[ GetHandleId(fanin) ];
+    }
+
+    for( unsigned i=0; i<gate.GetInputNo(); ++i )
+    {
+	if( gate.GetInputPinNode(i) == NULL )
+	    continue;
+
+	const unsigned pnode_id = gate.GetInputPinNode(i)->GetId();
+
+	for( unsigned j=_fanout_begin_vec[pnode_id]; j<_fanout_begin_vec[pnode_id+1]; ++j )
+	    if( GetKind(_fanout_vec[j]) == GATE_INPUT && _gate_ptr_vec[ _input_gate_id_vec[GetHandleId(_fanout_vec[j])] ] == &gate )
+		return _input_gate_id_vec[ GetHandleId(_fanout_vec[j]) ];
+    }
+
+    return NO_ID;
+}
+
+// the same wire data as Build() takes; connectivity does not change
+void TimingGraph::UpdateWireData(Circuit &circuit, const unsigned &root_id)
+{
+    assert( IsBuilt() );
+
+    for( unsigned i=_fanout_begin_vec[root_id]; i<_fanout_begin_vec[root_id+1]; ++i )
+    {
+	if( GetKind(_fanout_vec[i]) != PIN_NODE )
+	    continue;
+
+	const unsigned tap_id = GetHandleId(_fanout_vec[i]);
+	PinNode &tap_pnode = *(circuit.GetPinNodePtr(tap_id));
+	_fall_slew_hat_sq_vec[tap_id] = tap_pnode.GetFallSlewHatSq();
+	_rise_slew_hat_sq_vec[tap_id] = tap_pnode.GetRiseSlewHatSq();
+
+	if( _tap_input_id_vec[tap_id] != NO_ID )
+	{
+	    GInPin &gin_pin = *(static_cast<GInPin*>(tap_pnode.GetFanoutPtr(0)));
+	    _wire_fall_delay_vec[tap_id] = gin_pin.GetFallArrDelay();
+	    _wire_rise_delay_vec[tap_id] = gin_pin.GetRiseArrDelay();
+	}
+    }
+
+    return;
+}
+
+void TimingGraph::Levelize()
+{
+    assert( IsBuilt() );
+    const unsigned gate_no = GetGateNo();
+    vector<unsigned> reached_input_no_vec( gate_no, 0 ); // the same counting as Gate::IncInputVisitedCount() in serial STA
+    _level_begin_vec.assign( 1, 0 );
+    _level_gate_id_vec.clear();
+    _level_gate_id_vec.reserve( gate_no );
+    _gate_level_vec.assign( gate_no, NO_ID );
+    _clock_level = NO_ID;
+
+    // inputs counted before STA by resistDefectGates() and resistDefectPinNodes(), i.e., unconnected inputs of 
+    // combinational gates and inputs on wires driven by nothing, so that gates are levelized at any time
+    for( unsigned i=0; i<gate_no; ++i )
+    {
+	const bool is_com_gate = ( i >= GetFirstComGateId() && i < GetFirstComGateId()+_ComGate_no );
+
+	for( unsigned j=GetInputBegin(i); j<GetInputEnd(i); ++j )
+	{
+	    const unsigned pnode_id = GetInputPinNodeId(j);
+
+	    if( pnode_id == NO_ID )
+	    {
+		if( is_com_gate )
+		    ++reached_input_no_vec[i];
+
+		continue;
+	    }
+
+	    unsigned fanin = GetFanin(pnode_id);
+
+	    while( fanin != NO_ID && GetKind(fanin) == PIN_NODE )
+		fanin = GetFanin( GetHandleId(fanin) );
+
+	    if( fanin == NO_ID )
+		++reached_input_no_vec[i];
+	}
+    }
+
+    // primary inputs
+    for( unsigned i=0; i<_PI_no; ++i )
+	_level_gate_id_vec.push_back(i);
+
+    for( unsigned phase=0; phase<2; ++phase )
+    {
+	// a level is closed when its gates are known, and the gates they reach make the next level
+	while( _level_gate_id_vec.size() > _level_begin_vec.back() )
+	{
+	    const unsigned level = _level_begin_vec.size()-1;
+	    const unsigned level_end = _level_gate_id_vec.size();
+	    _level_begin_vec.push_back( level_end );
+
+	    for( unsigned i=_level_begin_vec[level]; i<level_end; ++i )
+	    {
+		const unsigned gate_id = _level_gate_id_vec[i];
+		_gate_level_vec[gate_id] = level;
+
+		for( unsigned j=GetOutputBegin(gate_id); j<GetOutputEnd(gate_id); ++j )
+		{
+		    const unsigned pnode_id = GetOutputPinNodeId(j);
+
+		    if( pnode_id == NO_ID )
+			continue;
+
+		    for( unsigned k=GetFanoutBegin(pnode_id); k<GetFanoutEnd(pnode_id); ++k )
+		    {
+			const unsigned fanout = GetFanout(k);
+			const unsigned driven_input_id = (GetKind(fanout) == PIN_NODE)? GetTapInputId(GetHandleId(fanout)): GetHandleId(fanout);
+
+			if( driven_input_id == NO_ID ) // very special case
+			    continue;
+
+			const unsigned driven_gate_id = GetInputGateId(driven_input_id);
+			const Gate &driven_gate = *(_gate_ptr_vec[driven_gate_id]);
+
+			// all inputs have been reached, and it is not a flip-flop
+			if( ++reached_input_no_vec[driven_gate_id] == driven_gate.GetInputNo() && 
+			    (driven_gate.GetCellPtr() == NULL || driven_gate.GetIsNonClocked()) )
+			    _level_gate_id_vec.push_back( driven_gate_id );
+		    }
+		}
+	    }
+	}
+
+	if( phase > 0 || GetSeqGateNo() == 0 )
+	    break;
+
+	// flip-flops, after all gates reached from primary inputs
+	_clock_level = _level_begin_vec.size()-1;
+
+	for( unsigned i=GetFirstSeqGateId(); i<gate_no; ++i )
+	    _level_gate_id_vec.push_back(i);
+    }
+
+    return;
+}
@@ -0,0 +1,139 @@
+/************************************************************************
+ *   Define an immutable timing graph built from a wired circuit.
+ *   Gates, gate pins and pin nodes are numbered by 32-bit ids, and the
+ *   connectivity is kept in compressed sparse row arrays, so that STA
+ *   walks contiguous id ranges instead of Element pointers and virtual
+ *   GetType() calls. An arc end is a handle whose two tag bits tell a
+ *   pin node from a gate input or gate output pin.
+ *
+ *   Gates can be levelized, i.e., bucketed by topological levels in
+ *   the order the serial forward STA reaches them, so that the gates of
+ *   a level can be propagated in parallel.
+ *
+ *   Defined class: TimingGraph
+ *
+ *   Author      : Kuan-Hsien Ho
+************************************************************************/
+
+#ifndef TIMING_GRAPH_H
+#define TIMING_GRAPH_H
+
+#include <cassert>
+#include <vector>
+
+//-----------------------------------------------------------------------
+//    Declare classes
+//-----------------------------------------------------------------------
+
+class Circuit; // defined in Circuit.h
+class Gate;    // defined in Gate.h
+class GOutPin; // defined in Gate.h
+class TimingGraph;
+
+//-----------------------------------------------------------------------
+//    Define class
+//-----------------------------------------------------------------------
+
+class TimingGraph
+{
+    public:
+	enum Kind // tag of a handle
+	{
+	    PIN_NODE,    // handle id is a pin-node id
+	    GATE_INPUT,  // handle id is a gate input pin id, i.e., index of all gate input pins
+	    GATE_OUTPUT  // handle id is a gate output pin id
+	};
+
+	enum { NO_ID = 0xffffffffu, KIND_SHIFT = 30, ID_MASK = 0x3fffffffu };
+
+	static unsigned MakeHandle(const Kind &k, const unsigned &id) { assert( id <= ID_MASK ); return ((k << KIND_SHIFT) | id); }
+	static Kind GetKind(const unsigned &handle) { assert( handle != NO_ID ); return static_cast<Kind>(handle >> KIND_SHIFT); }
+	static unsigned GetHandleId(const unsigned &handle) { return (handle & ID_MASK); }
+
+	TimingGraph(): _is_built(false), _PI_no(0), _PO_no(0), _ComGate_no(0), _clock_level(NO_ID) {}
+
+	bool IsBuilt() const { return _is_built; }
+	void Build(Circuit &circuit); // after wiring effects are injected
+
+	// gate ids are primary inputs, primary outputs, combinational gates, and then sequential gates
+	unsigned GetGateNo() const                        { return _gate_ptr_vec.size(); }
+	unsigned GetPINo() const                          { return _PI_no; }
+	unsigned GetPONo() const                          { return _PO_no; }
+	unsigned GetComGateNo() const                     { return _ComGate_no; }
+	unsigned GetSeqGateNo() const                     { return GetGateNo() - _PI_no - _PO_no - _ComGate_no; }
+	unsigned GetFirstPOId() const                     { return _PI_no; }
+	unsigned GetFirstComGateId() const                { return _PI_no + _PO_no; }
+	unsigned GetFirstSeqGateId() const                { return _PI_no + _PO_no + _ComGate_no; }
+	Gate* GetGatePtr(const unsigned &gate_id) const   { return _gate_ptr_vec[gate_id]; }
+	unsigned GetInputBegin(const unsigned &gate_id) const  { return _input_begin_vec[gate_id]; }
+	unsigned GetInputEnd(const unsigned &gate_id) const    { return _input_begin_vec[gate_id+1]; }
+	unsigned GetOutputBegin(const unsigned &gate_id) const { return _output_begin_vec[gate_id]; }
+	unsigned GetOutputEnd(const unsigned &gate_id) const   { return _output_begin_vec[gate_id+1]; }
+
+	// gate pins, NO_ID for a pin not connected to any pin node
+	unsigned GetInputPinNodeId(const unsigned &input_id) const   { return _input_pin_node_id_vec[input_id]; }
+	unsigned GetOutputPinNodeId(const unsigned &output_id) const { return _output_pin_node_id_vec[output_id]; }
+	unsigned GetInputGateId(const unsigned &input_id) const      { return _input_gate_id_vec[input_id]; }
+	unsigned GetOutputGateId(const unsigned &output_id) const    { return _output_gate_id_vec[output_id]; }
+	GOutPin& FetGOutPin(const unsigned &output_id) const;
+	unsigned FindGateId(Gate &gate) const; // NO_ID if the gate has no pin node
+
+	// pin nodes: a fanout is a tap pin node or a gate input pin, and a fanin is a wire root pin node or
+	// a gate output pin, NO_ID if none
+	unsigned GetPinNodeNo() const                            { return _fanin_vec.size(); }
+	unsigned GetFanoutBegin(const unsigned &pnode_id) const  { return _fanout_begin_vec[pnode_id]; }
+	unsigned GetFanoutEnd(const unsigned &pnode_id) const    { return _fanout_begin_vec[pnode_id+1]; }
+	unsigned GetFanoutNo(const unsigned &pnode_id) const     { return GetFanoutEnd(pnode_id) - GetFanoutBegin(pnode_id); }
+	unsigned GetFanout(const unsigned &fanout_id) const      { return _fanout_vec[fanout_id]; }
+	unsigned GetFanin(const unsigned &pnode_id) const        { return _fanin_vec[pnode_id]; }
+
+	// wire data of a tap pin node, i.e., of its first driven gate input pin; input id is NO_ID if it drives none
+	unsigned GetTapInputId(const unsigned &pnode_id) const   { return _tap_input_id_vec[pnode_id]; }
+	double GetWireFallDelay(const unsigned &pnode_id) const  { return _wire_fall_delay_vec[pnode_id]; }
+	double GetWireRiseDelay(const unsigned &pnode_id) const  { return _wire_rise_delay_vec[pnode_id]; }
+	double GetFallSlewHatSq(const unsigned &pnode_id) const  { return _fall_slew_hat_sq_vec[pnode_id]; }
+	double GetRiseSlewHatSq(const unsigned &pnode_id) const  { return _rise_slew_hat_sq_vec[pnode_id]; }
+	void UpdateWireData(Circuit &circuit, const unsigned &root_id); // of the taps, after wiring effects are injected again
+
+	// levels: primary inputs are at level 0, and a gate is one level above the last driving gate which reaches it;
+	// in a sequential circuit, all flip-flops are at the clock level, above all gates reached from primary inputs
+	void Levelize(); // independent of the input visited counts of gates, so also after STA
+	bool IsLevelized() const                               { return !_level_begin_vec.empty(); }
+	unsigned GetLevelNo() const                            { return _level_begin_vec.size()-1; }
+	unsigned GetLevelBegin(const unsigned &level) const    { return _level_begin_vec[level]; }
+	unsigned GetLevelEnd(const unsigned &level) const      { return _level_begin_vec[level+1]; }
+	unsigned GetLevelGateId(const unsigned &index) const   { return _level_gate_id_vec[index]; }
+	unsigned GetGateLevel(const unsigned &gate_id) const   { return _gate_level_vec[gate_id]; } // NO_ID if never reached
+	unsigned GetClockLevel() const                         { return _clock_level; }             // NO_ID if combinational
+
+    private:
+	bool _is_built;
+	unsigned _PI_no;
+	unsigned _PO_no;
+	unsigned _ComGate_no;
+
+	std::vector<Gate*> _gate_ptr_vec;
+	std::vector<unsigned> _input_begin_vec;        // gate id -> first input id, with an extra end
+	std::vector<unsigned> _output_begin_vec;       // gate id -> first output id, with an extra end
+	std::vector<unsigned> _input_pin_node_id_vec;  // input id -> driving pin-node id
+	std::vector<unsigned> _output_pin_node_id_vec; // output id -> driven pin-node id
+	std::vector<unsigned> _input_gate_id_vec;      // input id -> gate id
+	std::vector<unsigned> _output_gate_id_vec;     // output id -> gate id
+
+	std::vector<unsigned> _fanout_begin_vec;       // pin-node id -> first index of _fanout_vec, with an extra end
+	std::vector<unsigned> _fanout_vec;             // fanout handles in the order of PinNode::GetFanoutPtr()
+	std::vector<unsigned> _fanin_vec;              // pin-node id -> fanin handle
+
+	std::vector<unsigned> _tap_input_id_vec;
+	std::vector<double> _wire_fall_delay_vec;
+	std::vector<double> _wire_rise_delay_vec;
+	std::vector<double> _fall_slew_hat_sq_vec;
+	std::vector<double> _rise_slew_hat_sq_vec;
+
+	std::vector<unsigned> _level_begin_vec;        // level -> first index of _level_gate_id_vec, with an extra end
+	std::vector<unsigned> _level_gate_id_vec;      // gate ids by levels
+	std::vector<unsigned> _gate_level_vec;         // gate id -> level
+	unsigned _clock_level;
+};
+
+#endif // TIMING_GRAPH_H
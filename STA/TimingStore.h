@@ -0,0 +1,165 @@
+/************************************************************************
+ *   Define a structure-of-arrays store of pin-node timing data.
+ *   Arrival time, required time and slew of every early/late mode and
+ *   fall/rise transition are kept in separate contiguous arrays indexed
+ *   by pin-node id, so that a loop over many pin nodes only touches the
+ *   values it uses.
+ *
+ *   Required times are tightened, i.e., by max in early mode and by min
+ *   in late mode, and can also be tightened atomically with
+ *   compare-and-swap when several threads push into the same pin node.
+ *
+ *   Defined class: TimingStore
+ *
+ *   Author      : Kuan-Hsien Ho
+************************************************************************/
+
+#ifndef TIMING_STORE_H
+#define TIMING_STORE_H
+
+#include <cassert>
+#include <vector>
+
+#include "parameterDefine.h"
+
+//-----------------------------------------------------------------------
+//    Declare classes
+//-----------------------------------------------------------------------
+
+class TimingStore;
+
+//-----------------------------------------------------------------------
+//    Define class
+//-----------------------------------------------------------------------
+
+class TimingStore
+{
+    public:
+	enum Split // early (fast) or late (slow) mode, by fall or rise transition
+	{
+	    FAST_FALL,
+	    FAST_RISE,
+	    SLOW_FALL,
+	    SLOW_RISE,
+	    SPLIT_NO
+	};
+
+	unsigned GetNodeNo() const { return _arr_time_vec[0].size(); }
+
+	double GetArrTime(const Split &s, const unsigned &id) const { assert( id < GetNodeNo() ); return _arr_time_vec[s][id]; }
+	double GetReqTime(const Split &s, const unsigned &id) const { assert( id < GetNodeNo() ); return _req_time_vec[s][id]; }
+	double GetSlew(const Split &s, const unsigned &id) const    { assert( id < GetNodeNo() ); return _slew_vec[s][id]; }
+
+	void SetArrTime(const Split &s, const unsigned &id, const double &val) { assert( id < GetNodeNo() ); _arr_time_vec[s][id] = val; }
+	void SetReqTime(const Split &s, const unsigned &id, const double &val) { assert( id < GetNodeNo() ); _req_time_vec[s][id] = val; }
+	void SetSlew(const Split &s, const unsigned &id, const double &val)    { assert( id < GetNodeNo() ); _slew_vec[s][id] = val; }
+
+	void TightenReqTime(const Split &s, const unsigned &id, const double &val); // only if val is tighter
+
+	// only while other threads may tighten the same required time
+	double AtomicGetReqTime(const Split &s, const unsigned &id) const;
+	void AtomicTightenReqTime(const Split &s, const unsigned &id, const double &val); // only if val is tighter
+
+	// whole arrays indexed by pin-node id
+	double* FetArrTimeArray(const Split &s) { return _arr_time_vec[s].data(); }
+	double* FetReqTimeArray(const Split &s) { return _req_time_vec[s].data(); }
+	double* FetSlewArray(const Split &s)    { return _slew_vec[s].data(); }
+
+	unsigned AddNode(); // add a pin node of initial timing, and return its id
+	void Reserve(const unsigned &node_no);
+	void ResetReqTimes(); // unconstrained again, before injecting new constraints
+	void ResetNode(const unsigned &id); // initial timing again, e.g., of a pin node left undriven
+
+    private:
+	std::vector<double> _arr_time_vec[SPLIT_NO];
+	std::vector<double> _req_time_vec[SPLIT_NO]; // unconstrained if MIN_REQ_TIME in early mode or MAX_REQ_TIME in late mode
+	std::vector<double> _slew_vec[SPLIT_NO];
+};
+
+//-----------------------------------------------------------------------
+//    Define inline member functions
+//-----------------------------------------------------------------------
+
+inline unsigned TimingStore::AddNode()
+{
+    for( unsigned s=0; s<SPLIT_NO; ++s )
+    {
+	_arr_time_vec[s].push_back(0.0);
+	_req_time_vec[s].push_back( (s == FAST_FALL || s == FAST_RISE)? MIN_REQ_TIME: MAX_REQ_TIME );
+	_slew_vec[s].push_back(0.0);
+    }
+
+    return GetNodeNo()-1;
+}
+
+inline double TimingStore::AtomicGetReqTime(const Split &s, const unsigned &id) const
+{
+    assert( id < GetNodeNo() );
+    double val;
+    __atomic_load( &_req_time_vec[s][id], &val, __ATOMIC_RELAXED ); // ordered by the end of a parallel loop
+
+    return val;
+}
+
+inline void TimingStore::AtomicTightenReqTime(const Split &s, const unsigned &id, const double &val)
+{
+    assert( id < GetNodeNo() );
+    double *req_time_ptr = &_req_time_vec[s][id];
+    const bool is_early = ( s == FAST_FALL || s == FAST_RISE );
+    double new_val = val, cur_val;
+    __atomic_load( req_time_ptr, &cur_val, __ATOMIC_RELAXED );
+
+    // a failed swap reloads cur_val, and then val is compared again
+    while( (is_early)? (new_val > cur_val): (new_val < cur_val) )
+	if( __atomic_compare_exchange( req_time_ptr, &cur_val, &new_val, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED ) )
+	    break;
+
+    return;
+}
+
+inline void TimingStore::TightenReqTime(const Split &s, const unsigned &id, const double &val)
+{
+    assert( id < GetNodeNo() );
+    double &req_time = _req_time_vec[s][id];
+
+    if( (s == FAST_FALL || s == FAST_RISE)? (val > req_time): (val < req_time) )
+	req_time = val;
+
+    return;
+}
+
+inline void TimingStore::Reserve(const unsigned &node_no)
+{
+    for( unsigned s=0; s<SPLIT_NO; ++s )
+    {
+	_arr_time_vec[s].reserve(node_no);
+	_req_time_vec[s].reserve(node_no);
+	_slew_vec[s].reserve(node_no);
+    }
+
+    return;
+}
+
+inline void TimingStore::ResetReqTimes()
+{
+    for( unsigned s=0; s<SPLIT_NO; ++s )
+	_req_time_vec[s].assign( GetNodeNo(), (s == FAST_FALL || s == FAST_RISE)? MIN_REQ_TIME: MAX_REQ_TIME );
+
+    return;
+}
+
+inline void TimingStore::ResetNode(const unsigned &id)
+{
+    assert( id < GetNodeNo() );
+
+    for( unsigned s=0; s<SPLIT_NO; ++s )
+    {
+	_arr_time_vec[s][id] = 0.0;
+	_req_time_vec[s][id] = (s == FAST_FALL || s == FAST_RISE)? MIN_REQ_TIME: MAX_REQ_TIME;
+	_slew_vec[s][id] = 0.0;
+    }
+
+    return;
+}
+
+#endif // TIMING_STORE_H
@@ -8,12 +8,14 @@
 
 // backtrace signal changes
 
-#include <algorithm>
 #include <vector>
 
-#include "DelayData.h"
+#include "ArcDelayTable.h"
+#include "Circuit.h"
 #include "Gate.h"
+#include "GateKernel.h"
 #include "PinNode.h"
+#include "TimingGraph.h"
 #include "process.h"
 
 using namespace std;
@@ -22,319 +24,175 @@ using namespace std;
 //    Declare main functions
 //-----------------------------------------------------------------------
 
-void backtraceSignal( Gate &cur_gate );     // backtraceFastSignal() + backtraceSlowSignal()
+void backtraceSignal( Circuit &circuit, const unsigned &gate_id );     // backtraceFastSignal() + backtraceSlowSignal()
 
-void backtraceFastSignal( Gate &cur_gate ); // can be called independently
+void backtraceFastSignal( Circuit &circuit, const unsigned &gate_id ); // can be called independently
 
-void backtraceSlowSignal( Gate &cur_gate );
+void backtraceSlowSignal( Circuit &circuit, const unsigned &gate_id );
+
+void backtraceInputSignal( Circuit &circuit, const unsigned &input_id ); // into one gate input pin node, in both modes
+
+void backtraceSharedInputSignal( Circuit &circuit, const unsigned &input_id ); // atomically, into a pin node shared by threads
+
+//-----------------------------------------------------------------------
+//    Declare auxiliary functions 
+//-----------------------------------------------------------------------
+
+// backtraceFastSignal() and backtraceSlowSignal() in one mode
+template<ArcDelayTable::Mode MODE>
+void backtraceModeSignal( Circuit &circuit, const unsigned &gate_id );
+
+// backtraceInputSignal() and backtraceSharedInputSignal()
+template<bool IS_ATOMIC>
+void backtraceInputPinNode( Circuit &circuit, const unsigned &input_id );
+
+// fold the required times of an input pin from all outputs into its pin node
+template<ArcDelayTable::Mode MODE, bool IS_ATOMIC>
+void backtraceModeInput( const TimingGraph &graph, TimingStore &store, const ArcDelayTable &delay_table, const Cell &cur_cell, 
+	                 const unsigned &gate_id, const unsigned &input_pin_id );
+
+// fold the arcs of a timing sense from an input pin into its running required times
+template<InputTimingTable::TimingSense SENSE, ArcDelayTable::Mode MODE>
+void backtraceSenseArcs( const TimingGraph &graph, const TimingStore &store, const ArcDelayTable &delay_table, const Cell &cur_cell, 
+	                 const unsigned &gate_id, const unsigned &input_pin_id, double input_req_time[] );
 
 //-----------------------------------------------------------------------
 //    Define main functions
 //-----------------------------------------------------------------------
 
-void backtraceSignal( Gate &cur_gate )
+void backtraceSignal( Circuit &circuit, const unsigned &gate_id )
 {
-    assert( cur_gate.GetCellPtr() != NULL && (cur_gate.GetCellPtr())->GetIsNonClocked() );
-    //printf( "name = %s\n", cur_gate.GetCellPtr()->GetName().c_str() );
-    const Cell &cur_cell = *(cur_gate.GetCellPtr());
-    const vector<vector<InputTimingTable> > &timing_vec = cur_cell.FetInputTimingVec();
-    vector<double> input_fastFall_ratime, input_fastRise_ratime;
-    vector<double> input_slowFall_ratime, input_slowRise_ratime;
-    const unsigned input_no = cur_cell.GetInputPinNo();
+    backtraceModeSignal<ArcDelayTable::FAST>( circuit, gate_id );
+    backtraceModeSignal<ArcDelayTable::SLOW>( circuit, gate_id );
 
-    for( unsigned i=0; i<input_no; ++i )
-    {
-	PinNode *input_pnode_ptr = cur_gate.GetInputPinNode(i);
+    return;
+}
 
-	if( input_pnode_ptr == NULL || input_pnode_ptr->GetFaninPtr() == NULL )
-	    continue;
+void backtraceFastSignal( Circuit &circuit, const unsigned &gate_id )
+{
+    backtraceModeSignal<ArcDelayTable::FAST>( circuit, gate_id );
 
-	PinNode &input_pnode = *(input_pnode_ptr);
-
-	for( unsigned j=0; j<cur_cell.GetOutputPinNo(); ++j )
-	{
-	    GOutPin &output_pin = cur_gate.FetGOutPin(j);
-
-	    if( output_pin.GetFanoutPtr() == NULL )
-		continue;
-
-	    PinNode &output_pnode = *(output_pin.GetFanoutPtr());
-
-	    if( output_pnode.GetFanoutPtrNo() == 0 )
-		continue;
-
-	    const InputTimingTable &timing = timing_vec[i][j];
-
-	    switch( timing.PinTimingSense )
-	    {
-		case InputTimingTable::NEGATIVE_UNATE:
-		    {
-			assert( output_pin.GetFastDelayDataPtr(i) != NULL && output_pin.GetSlowDelayDataPtr(i) != NULL );
-			assert( output_pin.GetFastDelayDataPtr(i)->GetType() == DelayData::UNATE );
-			assert( output_pin.GetSlowDelayDataPtr(i)->GetType() == DelayData::UNATE );
-			UnateDelayData *delay_ptr = static_cast<UnateDelayData*>(output_pin.GetFastDelayDataPtr(i));
-			input_fastFall_ratime.push_back( output_pnode.GetFastRiseReqTime() - delay_ptr->DelayFromInputFall );
-			input_fastRise_ratime.push_back( output_pnode.GetFastFallReqTime() - delay_ptr->DelayFromInputRise );
-			delay_ptr = static_cast<UnateDelayData*>(output_pin.GetSlowDelayDataPtr(i));
-			input_slowFall_ratime.push_back( output_pnode.GetSlowRiseReqTime() - delay_ptr->DelayFromInputFall );
-			input_slowRise_ratime.push_back( output_pnode.GetSlowFallReqTime() - delay_ptr->DelayFromInputRise );
-			break;
-		    }
-		case InputTimingTable::POSITIVE_UNATE:
-		    {
-			assert( output_pin.GetFastDelayDataPtr(i) != NULL && output_pin.GetSlowDelayDataPtr(i) != NULL );
-			assert( output_pin.GetFastDelayDataPtr(i)->GetType() == DelayData::UNATE );
-			assert( output_pin.GetSlowDelayDataPtr(i)->GetType() == DelayData::UNATE );
-			UnateDelayData *delay_ptr = static_cast<UnateDelayData*>(output_pin.GetFastDelayDataPtr(i));
-			input_fastFall_ratime.push_back( output_pnode.GetFastFallReqTime() - delay_ptr->DelayFromInputFall );
-			input_fastRise_ratime.push_back( output_pnode.GetFastRiseReqTime() - delay_ptr->DelayFromInputRise );
-			delay_ptr = static_cast<UnateDelayData*>(output_pin.GetSlowDelayDataPtr(i));
-			input_slowFall_ratime.push_back( output_pnode.GetSlowFallReqTime() - delay_ptr->DelayFromInputFall );
-			input_slowRise_ratime.push_back( output_pnode.GetSlowRiseReqTime() - delay_ptr->DelayFromInputRise );
-			break;
-		    }
-		case InputTimingTable::InputTimingTable::NON_UNATE:
-		    {
-			assert( output_pin.GetFastDelayDataPtr(i) != NULL && output_pin.GetSlowDelayDataPtr(i) != NULL );
-			assert( output_pin.GetFastDelayDataPtr(i)->GetType() == DelayData::NON_UNATE );
-			assert( output_pin.GetSlowDelayDataPtr(i)->GetType() == DelayData::NON_UNATE );
-			NonUnateDelayData *delay_ptr = static_cast<NonUnateDelayData*>(output_pin.GetFastDelayDataPtr(i));
-
-			input_fastFall_ratime.push_back( output_pnode.GetFastRiseReqTime() - 
-				                         delay_ptr->InputFallOutputRiseDelay );
-			input_fastRise_ratime.push_back( output_pnode.GetFastFallReqTime() - 
-				                         delay_ptr->InputRiseOutputFallDelay );
-			input_fastFall_ratime.push_back( output_pnode.GetFastFallReqTime() - 
-				                         delay_ptr->InputFallOutputFallDelay );
-			input_fastRise_ratime.push_back( output_pnode.GetFastRiseReqTime() - 
-				                         delay_ptr->InputRiseOutputRiseDelay );
-
-                        delay_ptr = static_cast<NonUnateDelayData*>(output_pin.GetSlowDelayDataPtr(i));
-
-			input_slowFall_ratime.push_back( output_pnode.GetSlowRiseReqTime() - 
-				                         delay_ptr->InputFallOutputRiseDelay );
-			input_slowRise_ratime.push_back( output_pnode.GetSlowFallReqTime() - 
-				                         delay_ptr->InputRiseOutputFallDelay );
-			input_slowFall_ratime.push_back( output_pnode.GetSlowFallReqTime() - 
-				                         delay_ptr->InputFallOutputFallDelay );
-			input_slowRise_ratime.push_back( output_pnode.GetSlowRiseReqTime() - 
-				                         delay_ptr->InputRiseOutputRiseDelay );
-			break;
-		    }
-		default:
-		    assert(0);
-		    break;
-	    }
-	} // end output
-
-	// special case may happened at PI
-	if( (input_pnode.GetFaninPtr())->GetType() == Element::GOUT_PIN && input_pnode.GetFanoutNo() > 1 )
-	{
-            input_fastFall_ratime.push_back( input_pnode.GetFastFallReqTime() );
-	    input_fastRise_ratime.push_back( input_pnode.GetFastRiseReqTime() );
-            input_slowFall_ratime.push_back( input_pnode.GetSlowFallReqTime() );
-	    input_slowRise_ratime.push_back( input_pnode.GetSlowRiseReqTime() );
-	}
-
-	assert( input_fastFall_ratime.size()>0 ); // at least one output has a signal
-	input_pnode.SetFastFallReqTime( *max_element(input_fastFall_ratime.begin(), input_fastFall_ratime.end()) );
-	input_pnode.SetFastRiseReqTime( *max_element(input_fastRise_ratime.begin(), input_fastRise_ratime.end()) );
-	input_pnode.SetSlowFallReqTime( *min_element(input_slowFall_ratime.begin(), input_slowFall_ratime.end()) );
-	input_pnode.SetSlowRiseReqTime( *min_element(input_slowRise_ratime.begin(), input_slowRise_ratime.end()) );
-
-	input_fastFall_ratime.clear();
-	input_fastRise_ratime.clear();
-	input_slowFall_ratime.clear();
-	input_slowRise_ratime.clear();
-    } // end input
+    return;
+}
+
+void backtraceSlowSignal( Circuit &circuit, const unsigned &gate_id )
+{
+    backtraceModeSignal<ArcDelayTable::SLOW>( circuit, gate_id );
 
     return;
 }
 
-void backtraceFastSignal( Gate &cur_gate )
+// the same values as backtraceSignal() gives this input, and nothing if the gate is not combinational
+void backtraceInputSignal( Circuit &circuit, const unsigned &input_id )
 {
-    assert( cur_gate.GetCellPtr() != NULL && (cur_gate.GetCellPtr())->GetIsNonClocked() );
-    const Cell &cur_cell = *(cur_gate.GetCellPtr());
-    const vector<vector<InputTimingTable> > &timing_vec = cur_cell.FetInputTimingVec();
-    vector<double> input_fall_ratime, input_rise_ratime;
-    const unsigned input_no = cur_cell.GetInputPinNo();
+    backtraceInputPinNode<false>( circuit, input_id );
 
-    for( unsigned i=0; i<input_no; ++i )
-    {
-	PinNode *input_pnode_ptr = cur_gate.GetInputPinNode(i);
+    return;
+}
 
-	if( input_pnode_ptr == NULL || input_pnode_ptr->GetFaninPtr() == NULL )
-	    continue;
+// the same as backtraceInputSignal(), while other threads may set the same pin node
+void backtraceSharedInputSignal( Circuit &circuit, const unsigned &input_id )
+{
+    backtraceInputPinNode<true>( circuit, input_id );
 
-	PinNode &input_pnode = *(input_pnode_ptr);
-
-	for( unsigned j=0; j<cur_cell.GetOutputPinNo(); ++j )
-	{
-	    GOutPin &output_pin = cur_gate.FetGOutPin(j);
-
-	    if( output_pin.GetFanoutPtr() == NULL )
-		continue;
-
-	    PinNode &output_pnode = *(output_pin.GetFanoutPtr());
-
-	    if( output_pnode.GetFanoutPtrNo() == 0 )
-		continue;
-
-	    const InputTimingTable &timing = timing_vec[i][j];
-
-	    switch( timing.PinTimingSense )
-	    {
-		case InputTimingTable::NEGATIVE_UNATE:
-		    {
-			assert( output_pin.GetFastDelayDataPtr(i) != NULL );
-			assert( output_pin.GetFastDelayDataPtr(i)->GetType() == DelayData::UNATE );
-			UnateDelayData *delay_ptr = static_cast<UnateDelayData*>(output_pin.GetFastDelayDataPtr(i));
-			input_fall_ratime.push_back( output_pnode.GetFastRiseReqTime() - delay_ptr->DelayFromInputFall );
-			input_rise_ratime.push_back( output_pnode.GetFastFallReqTime() - delay_ptr->DelayFromInputRise );
-			break;
-		    }
-		case InputTimingTable::POSITIVE_UNATE:
-		    {
-			assert( output_pin.GetFastDelayDataPtr(i) != NULL );
-			assert( output_pin.GetFastDelayDataPtr(i)->GetType() == DelayData::UNATE );
-			UnateDelayData *delay_ptr = static_cast<UnateDelayData*>(output_pin.GetFastDelayDataPtr(i));
-			input_fall_ratime.push_back( output_pnode.GetFastFallReqTime() - delay_ptr->DelayFromInputFall );
-			input_rise_ratime.push_back( output_pnode.GetFastRiseReqTime() - delay_ptr->DelayFromInputRise );
-			break;
-		    }
-		case InputTimingTable::InputTimingTable::NON_UNATE:
-		    {
-			assert( output_pin.GetFastDelayDataPtr(i) != NULL );
-			assert( output_pin.GetFastDelayDataPtr(i)->GetType() == DelayData::NON_UNATE );
-			NonUnateDelayData *delay_ptr = static_cast<NonUnateDelayData*>(output_pin.GetFastDelayDataPtr(i));
-
-			input_fall_ratime.push_back( output_pnode.GetFastRiseReqTime() - 
-				                     delay_ptr->InputFallOutputRiseDelay );
-
-			input_rise_ratime.push_back( output_pnode.GetFastFallReqTime() - 
-				                     delay_ptr->InputRiseOutputFallDelay );
-
-			input_fall_ratime.push_back( output_pnode.GetFastFallReqTime() - 
-				                     delay_ptr->InputFallOutputFallDelay );
-
-			input_rise_ratime.push_back( output_pnode.GetFastRiseReqTime() - 
-				                     delay_ptr->InputRiseOutputRiseDelay );
-
-			break;
-		    }
-		default:
-		    assert(0);
-		    break;
-	    }
-	} // end output
-
-	// special case may happened at PI
-	if( (input_pnode.GetFaninPtr())->GetType() == Element::GOUT_PIN && input_pnode.GetFanoutNo() > 1 )
-	{
-            input_fall_ratime.push_back( input_pnode.GetFastFallReqTime() );
-	    input_rise_ratime.push_back( input_pnode.GetFastRiseReqTime() );
-	}
-
-	input_pnode.SetFastFallReqTime( *max_element(input_fall_ratime.begin(), input_fall_ratime.end()) );
-	input_pnode.SetFastRiseReqTime( *max_element(input_rise_ratime.begin(), input_rise_ratime.end()) );
-
-	input_fall_ratime.clear();
-	input_rise_ratime.clear();
-    } // end input
+    return;
+}
+
+//-----------------------------------------------------------------------
+//    Define auxiliary functions 
+//-----------------------------------------------------------------------
+
+template<bool IS_ATOMIC>
+void backtraceInputPinNode( Circuit &circuit, const unsigned &input_id )
+{
+    const TimingGraph &graph = circuit.GetTimingGraph();
+    const unsigned gate_id = graph.GetInputGateId(input_id);
+    const Cell *cell_ptr = graph.GetGatePtr(gate_id)->GetCellPtr();
+
+    if( cell_ptr == NULL || !cell_ptr->GetIsNonClocked() ) // PO or flip-flop
+	return;
+
+    const ArcDelayTable &delay_table = circuit.FetArcDelayTable();
+    TimingStore &store = circuit.FetTimingStore();
+    const unsigned input_pin_id = input_id - graph.GetInputBegin(gate_id);
+
+    backtraceModeInput<ArcDelayTable::FAST, IS_ATOMIC>( graph, store, delay_table, *cell_ptr, gate_id, input_pin_id );
+    backtraceModeInput<ArcDelayTable::SLOW, IS_ATOMIC>( graph, store, delay_table, *cell_ptr, gate_id, input_pin_id );
 
     return;
 }
 
-void backtraceSlowSignal( Gate &cur_gate )
+template<ArcDelayTable::Mode MODE>
+void backtraceModeSignal( Circuit &circuit, const unsigned &gate_id )
 {
+    const TimingGraph &graph = circuit.GetTimingGraph();
+    const ArcDelayTable &delay_table = circuit.FetArcDelayTable();
+    TimingStore &store = circuit.FetTimingStore();
+    Gate &cur_gate = *(graph.GetGatePtr(gate_id));
     assert( cur_gate.GetCellPtr() != NULL && (cur_gate.GetCellPtr())->GetIsNonClocked() ); // not PI
     const Cell &cur_cell = *(cur_gate.GetCellPtr());
-    const vector<vector<InputTimingTable> > &timing_vec = cur_cell.FetInputTimingVec();
-    vector<double> input_fall_ratime, input_rise_ratime;
     const unsigned input_no = cur_cell.GetInputPinNo();
 
     for( unsigned i=0; i<input_no; ++i )
+	backtraceModeInput<MODE, false>( graph, store, delay_table, cur_cell, gate_id, i );
+
+    return;
+}
+
+template<ArcDelayTable::Mode MODE, bool IS_ATOMIC>
+void backtraceModeInput( const TimingGraph &graph, TimingStore &store, const ArcDelayTable &delay_table, const Cell &cur_cell, 
+	                 const unsigned &gate_id, const unsigned &input_pin_id )
+{
+    const unsigned input_pnode_id = graph.GetInputPinNodeId( graph.GetInputBegin(gate_id)+input_pin_id );
+
+    if( input_pnode_id == TimingGraph::NO_ID || graph.GetFanin(input_pnode_id) == TimingGraph::NO_ID )
+	return;
+
+    // running extrema over all outputs
+    double input_req_time[EDGE_NO] = {getInitReqTime<MODE>(), getInitReqTime<MODE>()};
+
+    backtraceSenseArcs<InputTimingTable::POSITIVE_UNATE, MODE>( graph, store, delay_table, cur_cell, gate_id, input_pin_id, input_req_time );
+    backtraceSenseArcs<InputTimingTable::NEGATIVE_UNATE, MODE>( graph, store, delay_table, cur_cell, gate_id, input_pin_id, input_req_time );
+    backtraceSenseArcs<InputTimingTable::NON_UNATE, MODE>( graph, store, delay_table, cur_cell, gate_id, input_pin_id, input_req_time );
+
+    // fold with the existing required time, which also covers the special case at PI 
+    // where the input pin node is driven directly and has other fanouts
+    const TimingStore::Split fall_split = getSplit<MODE, FALL>(), rise_split = getSplit<MODE, RISE>();
+
+    if constexpr( IS_ATOMIC )
+    {
+	store.AtomicTightenReqTime( fall_split, input_pnode_id, input_req_time[FALL] );
+	store.AtomicTightenReqTime( rise_split, input_pnode_id, input_req_time[RISE] );
+    }
+    else
+    {
+	store.SetReqTime( fall_split, input_pnode_id, foldReqTime<MODE>(store.GetReqTime(fall_split, input_pnode_id), input_req_time[FALL]) );
+	store.SetReqTime( rise_split, input_pnode_id, foldReqTime<MODE>(store.GetReqTime(rise_split, input_pnode_id), input_req_time[RISE]) );
+    }
+
+    return;
+}
+
+template<InputTimingTable::TimingSense SENSE, ArcDelayTable::Mode MODE>
+void backtraceSenseArcs( const TimingGraph &graph, const TimingStore &store, const ArcDelayTable &delay_table, const Cell &cur_cell, 
+	                 const unsigned &gate_id, const unsigned &input_pin_id, double input_req_time[] )
+{
+    const vector<unsigned> &output_pin_id_vec = cur_cell.FetSenseOutputIdVec(input_pin_id, SENSE);
+    const double *delay_arr = delay_table.FetDelayArray(MODE);
+
+    for( unsigned k=0; k<output_pin_id_vec.size(); ++k )
     {
-	PinNode *input_pnode_ptr = cur_gate.GetInputPinNode(i);
+	const unsigned output_id = graph.GetOutputBegin(gate_id) + output_pin_id_vec[k];
+	const unsigned output_pnode_id = graph.GetOutputPinNodeId(output_id);
 
-	if( input_pnode_ptr == NULL || input_pnode_ptr->GetFaninPtr() == NULL )
+	if( output_pnode_id == TimingGraph::NO_ID || graph.GetFanoutNo(output_pnode_id) == 0 )
 	    continue;
 
-	PinNode &input_pnode = *(input_pnode_ptr);
-
-	for( unsigned j=0; j<cur_cell.GetOutputPinNo(); ++j )
-	{
-	    GOutPin &output_pin = cur_gate.FetGOutPin(j);
-
-	    if( output_pin.GetFanoutPtr() == NULL )
-		continue;
-
-	    PinNode &output_pnode = *(output_pin.GetFanoutPtr());
-
-	    if( output_pnode.GetFanoutPtrNo() == 0 )
-		continue;
-
-	    const InputTimingTable &timing = timing_vec[i][j];
-
-	    switch( timing.PinTimingSense )
-	    {
-		case InputTimingTable::NEGATIVE_UNATE:
-		    {
-			assert( output_pin.GetSlowDelayDataPtr(i) != NULL );
-			assert( output_pin.GetSlowDelayDataPtr(i)->GetType() == DelayData::UNATE );
-			UnateDelayData *delay_ptr = static_cast<UnateDelayData*>(output_pin.GetSlowDelayDataPtr(i));
-			input_fall_ratime.push_back( output_pnode.GetSlowRiseReqTime() - delay_ptr->DelayFromInputFall );
-			input_rise_ratime.push_back( output_pnode.GetSlowFallReqTime() - delay_ptr->DelayFromInputRise );
-			break;
-		    }
-		case InputTimingTable::POSITIVE_UNATE:
-		    {
-			assert( output_pin.GetSlowDelayDataPtr(i) != NULL );
-			assert( output_pin.GetSlowDelayDataPtr(i)->GetType() == DelayData::UNATE );
-			UnateDelayData *delay_ptr = static_cast<UnateDelayData*>(output_pin.GetSlowDelayDataPtr(i));
-			input_fall_ratime.push_back( output_pnode.GetSlowFallReqTime() - delay_ptr->DelayFromInputFall );
-			input_rise_ratime.push_back( output_pnode.GetSlowRiseReqTime() - delay_ptr->DelayFromInputRise );
-			break;
-		    }
-		case InputTimingTable::InputTimingTable::NON_UNATE:
-		    {
-			assert( output_pin.GetSlowDelayDataPtr(i) != NULL );
-			assert( output_pin.GetSlowDelayDataPtr(i)->GetType() == DelayData::NON_UNATE );
-			NonUnateDelayData *delay_ptr = static_cast<NonUnateDelayData*>(output_pin.GetSlowDelayDataPtr(i));
-
-			input_fall_ratime.push_back( output_pnode.GetSlowRiseReqTime() - 
-				                     delay_ptr->InputFallOutputRiseDelay );
-
-			input_rise_ratime.push_back( output_pnode.GetSlowFallReqTime() - 
-				                     delay_ptr->InputRiseOutputFallDelay );
-
-			input_fall_ratime.push_back( output_pnode.GetSlowFallReqTime() - 
-				                     delay_ptr->InputFallOutputFallDelay );
-
-			input_rise_ratime.push_back( output_pnode.GetSlowRiseReqTime() - 
-				                     delay_ptr->InputRiseOutputRiseDelay );
-
-			break;
-		    }
-		default:
-		    assert(0);
-		    break;
-	    }
-	} // end output
-
-	// special case may happened at PI
-	if( (input_pnode.GetFaninPtr())->GetType() == Element::GOUT_PIN && input_pnode.GetFanoutNo() > 1 )
-	{
-            input_fall_ratime.push_back( input_pnode.GetSlowFallReqTime() );
-	    input_rise_ratime.push_back( input_pnode.GetSlowRiseReqTime() );
-	}
-
-	input_pnode.SetSlowFallReqTime( *min_element(input_fall_ratime.begin(), input_fall_ratime.end()) );
-	input_pnode.SetSlowRiseReqTime( *min_element(input_rise_ratime.begin(), input_rise_ratime.end()) );
-
-	input_fall_ratime.clear();
-	input_rise_ratime.clear();
-    } // end input
+	const double output_req_time[EDGE_NO] = {store.GetReqTime(getSplit<MODE, FALL>(), output_pnode_id), 
+	                                         store.GetReqTime(getSplit<MODE, RISE>(), output_pnode_id)};
+
+	backtraceArc<SENSE, MODE>( output_req_time, delay_arr+delay_table.GetSlot(output_id, input_pin_id), input_req_time );
+    } // end output
 
     return;
 }
@@ -1,12 +1,15 @@
 /************************************************************************
  *   Inject circuit pin-node loads and Elmore delays in parallel mode.
- *   Note that no fanout RC tree is left after injecting wiring effects.
+ *   Note that no fanout RC tree is left after injecting wiring effects,
+ *   except the ones kept with node names for editing parasitics, which
+ *   are flat already when injected again.
  *
  *   Author      : Kuan-Hsien Ho
 ************************************************************************/
 
+#include <algorithm>
+#include <functional>
 #include <iostream>
-#include <list>
 #include <utility>
 
 #include "Circuit.h"
@@ -21,19 +24,19 @@ using namespace std;
 
 void injectWiringEffects( Circuit &circuit );
 
+void injectWiringEffects( Circuit &circuit, ThreadPool &thread_pool );
+
+void injectWiringEffects( PinNode *pin_node_ptr );
+
 //-----------------------------------------------------------------------
 //    Declare auxiliary functions 
 //-----------------------------------------------------------------------
 
-void accumulateLoads( const vector<RCTreeNode> &fanout_rc_tree, const vector<unsigned> &reverse_vec, vector<double> &fall_cap_table, vector<double> &rise_cap_table );
+void accumulateLoads( const RCTree &rc_tree, vector<double> &fall_cap_table, vector<double> &rise_cap_table );
 
-void adjustLinkingAndGetReverseOrder( vector<RCTreeNode> &fanout_rc_tree, vector<unsigned> &reverse_vec );
-
-void computeElmoreDelays( const vector<unsigned> &reverse_vec, vector<RCTreeNode> &fanout_rc_tree );
-
-void injectWiringEffects( PinNode *pin_node_ptr );
+void computeElmoreDelays( const RCTree &rc_tree, PinNode &root_pnode );
 
-bool is_topologically_ordered( vector<RCTreeNode> &fanout_rc_tree, const vector<unsigned> &reverse_vec );
+bool is_topologically_ordered( const RCTree &rc_tree );
 
 void resistShortCircuit( PinNode &cur_pnode );
 
@@ -51,85 +54,71 @@ void injectWiringEffects( Circuit &circuit )
     return;
 }
 
-//-----------------------------------------------------------------------
-//    Define auxiliary functions 
-//-----------------------------------------------------------------------
-
-void accumulateLoads( const vector<RCTreeNode> &fanout_rc_tree, const vector<unsigned> &reverse_vec, vector<double> &fall_cap_table, vector<double> &rise_cap_table )
+// a wire writes only its own pin nodes, tap gate input pins and driving gate output pin, so wires are independent;
+// wires are dealt in decreasing RC-tree size so that a few huge clock wires do not end up in the tail
+void injectWiringEffects( Circuit &circuit, ThreadPool &thread_pool )
 {
-    // accumulate loads in reverse order
-    for( unsigned i=0; i<fanout_rc_tree.size(); ++i )
+    if( thread_pool.GetThreadNo() == 1 )
     {
-        const unsigned cur_id = reverse_vec[i];
-	const list<pair<unsigned, double> > &fanout_id_res_list = fanout_rc_tree[cur_id].FetFanoutIdResList();
-	list<pair<unsigned, double> >::const_iterator listIter = fanout_id_res_list.begin();
+	injectWiringEffects( circuit );
+	return;
+    }
 
-	for( ; listIter!=fanout_id_res_list.end(); ++listIter )
-	{
-	    const unsigned fanout_id = (*listIter).first;
+    vector<pair<unsigned, unsigned> > size_id_vec; // (RC-tree size, pin-node id) of wires
 
-	    fall_cap_table[cur_id] += fall_cap_table[fanout_id];
-	    rise_cap_table[cur_id] += rise_cap_table[fanout_id];
-	}
+    for( unsigned i=0; i<circuit.GetPinNodeNo(); ++i )
+    {
+	PinNode *pin_node_ptr = circuit.GetPinNodePtr(i);
+	const RCTree *rc_tree_ptr = pin_node_ptr->GetFanoutRCTreePtr();
+	const unsigned rc_tree_size = (rc_tree_ptr == NULL)? 0: rc_tree_ptr->GetNodeNo();
+
+	if( rc_tree_size > 0 )
+	    size_id_vec.push_back( pair<unsigned, unsigned>(rc_tree_size, i) );
+	else
+	    injectWiringEffects( pin_node_ptr ); // no wire, or reduced while loading
     }
 
+    sort( size_id_vec.begin(), size_id_vec.end(), greater<pair<unsigned, unsigned> >() );
+    vector<unsigned> task_vec( size_id_vec.size() );
+
+    for( unsigned i=0; i<size_id_vec.size(); ++i )
+	task_vec[i] = size_id_vec[i].second;
+
+    thread_pool.Run( task_vec, [&circuit](unsigned, unsigned pin_node_id) { 
+	    injectWiringEffects( circuit.GetPinNodePtr(pin_node_id) ); } );
+
     return;
 }
 
-// decompose fanin and fanout sets from the original fanout list for each RCTreeNode, and 
-// find a reverse traversal order, reverse_vec, of the given tree, i.e., from leaves to root in topological
-void adjustLinkingAndGetReverseOrder( vector<RCTreeNode> &fanout_rc_tree, vector<unsigned> &reverse_vec )
-{
-    assert( fanout_rc_tree.size() > 1 ); // at least a root and a leaf
-    const int node_no = static_cast<int>(fanout_rc_tree.size());
-    reverse_vec.assign(node_no, 0);
-    vector<bool> unreached_table(node_no, true);
-
-    unreached_table[0] = false; // traverse the root
-    int next_id = node_no-2;    // position to be inserted
+//-----------------------------------------------------------------------
+//    Define auxiliary functions 
+//-----------------------------------------------------------------------
 
-    for( int i=node_no-1; i>=0; --i )
+// accumulate loads from leaves to root, i.e., in reverse topological order
+void accumulateLoads( const RCTree &rc_tree, vector<double> &fall_cap_table, vector<double> &rise_cap_table )
+{
+    for( unsigned i=rc_tree.GetNodeNo()-1; i>0; --i )
     {
-	const unsigned cur_id = reverse_vec[i];
-	list<pair<unsigned, double> > &adjacent_list = fanout_rc_tree[cur_id].FetFanoutIdResList();
-	list<pair<unsigned, double> >::iterator listIter = adjacent_list.begin();
+	const unsigned fanin_pos = rc_tree.GetFaninPos(i);
 
-	for( ; listIter!=adjacent_list.end(); )
-	{
-	    const unsigned adj_id = (*listIter).first;
-
-	    if( unreached_table[adj_id] )
-	    {
-		reverse_vec[next_id--] = adj_id;
-                unreached_table[adj_id] = false;
-		++listIter;
-	    }
-	    else
-	    {
-		fanout_rc_tree[cur_id].SetFaninIdRes((*listIter));
-		listIter = adjacent_list.erase(listIter);
-	    }
-	}
+	fall_cap_table[fanin_pos] += fall_cap_table[i];
+	rise_cap_table[fanin_pos] += rise_cap_table[i];
     }
 
-    assert( is_topologically_ordered(fanout_rc_tree, reverse_vec) );
-
     return;
 }
 
-void computeElmoreDelays( const vector<unsigned> &reverse_vec, vector<RCTreeNode> &fanout_rc_tree )
+void computeElmoreDelays( const RCTree &rc_tree, PinNode &root_pnode )
 {
-    const unsigned node_no = fanout_rc_tree.size();
-    RCTreeNode &root_node = fanout_rc_tree[0];
-    PinNode &root_pnode = *(root_node.GetPinNodePtr());
+    const unsigned node_no = rc_tree.GetNodeNo();
     const unsigned leaf_no = root_pnode.GetFanoutPinNodeNo();
     vector<double> fall_cap_table(node_no);
     vector<double> rise_cap_table(node_no);
 
-    // initialize 
+    // initialize
     for( unsigned i=0; i<node_no; ++i )
     {
-        fall_cap_table[i] = fanout_rc_tree[i].GetCap(); // id is one-by-one mapping
+        fall_cap_table[i] = rc_tree.GetCap(i);
 	rise_cap_table[i] = fall_cap_table[i];
     }
 
@@ -139,11 +128,12 @@ void computeElmoreDelays( const vector<unsigned> &reverse_vec, vector<RCTreeNode
     // inject gate input capacitance to tap nodes
     for( unsigned i=1; i<=leaf_no; ++i )
     {
-	const unsigned fanout_no = (fanout_rc_tree[i].GetPinNodePtr())->GetFanoutNo();
+	PinNode &tap_pnode = *(static_cast<PinNode*>(root_pnode.GetFanoutPtr(i-1)));
+	const unsigned fanout_no = tap_pnode.GetFanoutNo();
 
         for( unsigned j=0; j<fanout_no; ++j ) // consider if a pin node drives multiple gates although it may not be possible
 	{
-	    const GInPin *gInPin_ptr = static_cast<GInPin*>((fanout_rc_tree[i].GetPinNodePtr())->GetFanoutPtr(j));
+	    const GInPin *gInPin_ptr = static_cast<GInPin*>(tap_pnode.GetFanoutPtr(j));
 	    const unsigned cell_pin_id = gInPin_ptr->GetPinId();
 	    const Gate *gate_ptr = gInPin_ptr->GetGatePtr();
 
@@ -154,11 +144,16 @@ void computeElmoreDelays( const vector<unsigned> &reverse_vec, vector<RCTreeNode
 	    }
 	}
 
-	fall_cap_table[i] += pin_fall_cap_table[i];
-	rise_cap_table[i] += pin_rise_cap_table[i];
+	const unsigned pos = rc_tree.GetLeafPos(i);
+
+	if( pos != RCTree::NO_POS )
+	{
+	    fall_cap_table[pos] += pin_fall_cap_table[i];
+	    rise_cap_table[pos] += pin_rise_cap_table[i];
+	}
     }
 
-    accumulateLoads( fanout_rc_tree, reverse_vec, fall_cap_table, rise_cap_table ); // accumulate loads in reverse order
+    accumulateLoads( rc_tree, fall_cap_table, rise_cap_table );
 
     { // inject accumulated loadings in gate output pin
 	GOutPin *gOutPin_ptr = static_cast<GOutPin*>(root_pnode.GetFaninPtr());
@@ -184,94 +179,75 @@ void computeElmoreDelays( const vector<unsigned> &reverse_vec, vector<RCTreeNode
     vector<double> fall_delay_table(node_no, 0.0);
     vector<double> rise_delay_table(node_no, 0.0);
 
-    { // accumulate delays from root to leaves and update fall_cap_table & rise_cap_table simultaneously
-	{ // root node
-	    const list<pair<unsigned, double> > &fanout_id_res_list = root_node.FetFanoutIdResList();
-	    list<pair<unsigned, double> >::const_iterator listIter = fanout_id_res_list.begin();
-
-	    for( ; listIter!=fanout_id_res_list.end(); ++listIter )
-	    {
-		const unsigned fanout_id = (*listIter).first;
-
-		fall_delay_table[fanout_id] = ((*listIter).second * fall_cap_table[fanout_id]);
-                rise_delay_table[fanout_id] = ((*listIter).second * rise_cap_table[fanout_id]);
-	    }
+    { // accumulate delays from root to leaves and replace fall_cap_table & rise_cap_table for slew computation
+	unsigned i = 1;
 
-	    fall_cap_table[0] = 0.0; // since local accumulated delay is zero
-	    rise_cap_table[0] = 0.0;
+	for( ; i<node_no && rc_tree.GetFaninPos(i)==0; ++i ) // fanout nodes of root
+	{
+	    fall_delay_table[i] = rc_tree.GetRes(i) * fall_cap_table[i];
+	    rise_delay_table[i] = rc_tree.GetRes(i) * rise_cap_table[i];
+	    fall_cap_table[i] = rc_tree.GetCap(i) * fall_delay_table[i];
+	    rise_cap_table[i] = rc_tree.GetCap(i) * rise_delay_table[i];
 	}
 
-	// other nodes
-	for( int i=static_cast<int>(node_no)-2; i>=0; --i )
+	for( ; i<node_no; ++i ) // other nodes
 	{
-	    const unsigned cur_id = reverse_vec[i];
-	    const RCTreeNode &cur_node = fanout_rc_tree[cur_id];
-	    const list<pair<unsigned, double> > &fanout_id_res_list = cur_node.FetFanoutIdResList();
-	    list<pair<unsigned, double> >::const_iterator listIter = fanout_id_res_list.begin();
+	    const unsigned fanin_pos = rc_tree.GetFaninPos(i);
 
-	    for( ; listIter!=fanout_id_res_list.end(); ++listIter )
-	    {
-		const unsigned fanout_id = (*listIter).first;
+	    fall_delay_table[i] = (rc_tree.GetRes(i) * fall_cap_table[i]) + fall_delay_table[fanin_pos];
+	    rise_delay_table[i] = (rc_tree.GetRes(i) * rise_cap_table[i]) + rise_delay_table[fanin_pos];
+	    fall_cap_table[i] = rc_tree.GetCap(i) * fall_delay_table[i];
+	    rise_cap_table[i] = rc_tree.GetCap(i) * rise_delay_table[i];
+	}
 
-		fall_delay_table[fanout_id] = ((*listIter).second * fall_cap_table[fanout_id]) + fall_delay_table[cur_id];
-		rise_delay_table[fanout_id] = ((*listIter).second * rise_cap_table[fanout_id]) + rise_delay_table[cur_id];
-	    }
+	fall_cap_table[0] = 0.0; // since local accumulated delay is zero
+	rise_cap_table[0] = 0.0;
 
-	    if( cur_id > leaf_no )
-	    {
-		fall_cap_table[cur_id] = cur_node.GetCap() * fall_delay_table[cur_id]; // replace for slew computation
-		rise_cap_table[cur_id] = cur_node.GetCap() * rise_delay_table[cur_id];
-	    }
-	    else
+	for( unsigned j=1; j<=leaf_no; ++j ) // tap nodes also carry gate input capacitance
+	{
+	    const unsigned pos = rc_tree.GetLeafPos(j);
+
+	    if( pos != RCTree::NO_POS )
 	    {
-		fall_cap_table[cur_id] = (cur_node.GetCap()+pin_fall_cap_table[cur_id]) * fall_delay_table[cur_id];
-		rise_cap_table[cur_id] = (cur_node.GetCap()+pin_rise_cap_table[cur_id]) * rise_delay_table[cur_id];
+		fall_cap_table[pos] = (rc_tree.GetCap(pos)+pin_fall_cap_table[j]) * fall_delay_table[pos];
+		rise_cap_table[pos] = (rc_tree.GetCap(pos)+pin_rise_cap_table[j]) * rise_delay_table[pos];
 	    }
 	}
     }
 
-    accumulateLoads( fanout_rc_tree, reverse_vec, fall_cap_table, rise_cap_table ); // accumulate loads in reverse order
-    vector<double> fall_beta_table(node_no);
-    vector<double> rise_beta_table(node_no);
+    accumulateLoads( rc_tree, fall_cap_table, rise_cap_table );
+    vector<double> fall_beta_table(node_no, 0.0);
+    vector<double> rise_beta_table(node_no, 0.0);
 
     {
-	{ // root node
-	    const list<pair<unsigned, double> > &fanout_id_res_list = root_node.FetFanoutIdResList();
-	    list<pair<unsigned, double> >::const_iterator listIter = fanout_id_res_list.begin();
+	unsigned i = 1;
 
-	    for( ; listIter!=fanout_id_res_list.end(); ++listIter )
-	    {
-		const unsigned fanout_id = (*listIter).first;
-
-		fall_beta_table[fanout_id] = ((*listIter).second * fall_cap_table[fanout_id]);
-                rise_beta_table[fanout_id] = ((*listIter).second * rise_cap_table[fanout_id]);
-	    }
+	for( ; i<node_no && rc_tree.GetFaninPos(i)==0; ++i ) // fanout nodes of root
+	{
+	    fall_beta_table[i] = rc_tree.GetRes(i) * fall_cap_table[i];
+	    rise_beta_table[i] = rc_tree.GetRes(i) * rise_cap_table[i];
 	}
 
-	// other nodes
-	for( int i=static_cast<int>(node_no)-2; i>=0; --i )
+	for( ; i<node_no; ++i ) // other nodes
 	{
-	    const unsigned cur_id = reverse_vec[i];
-	    const RCTreeNode &cur_node = fanout_rc_tree[cur_id];
-	    const list<pair<unsigned, double> > &fanout_id_res_list = cur_node.FetFanoutIdResList();
-	    list<pair<unsigned, double> >::const_iterator listIter = fanout_id_res_list.begin();
-
-	    for( ; listIter!=fanout_id_res_list.end(); ++listIter )
-	    {
-		const unsigned fanout_id = (*listIter).first;
+	    const unsigned fanin_pos = rc_tree.GetFaninPos(i);
 
-		fall_beta_table[fanout_id] = ((*listIter).second * fall_cap_table[fanout_id]) + fall_beta_table[cur_id];
-		rise_beta_table[fanout_id] = ((*listIter).second * rise_cap_table[fanout_id]) + rise_beta_table[cur_id];
-	    }
+	    fall_beta_table[i] = (rc_tree.GetRes(i) * fall_cap_table[i]) + fall_beta_table[fanin_pos];
+	    rise_beta_table[i] = (rc_tree.GetRes(i) * rise_cap_table[i]) + rise_beta_table[fanin_pos];
 	}
     }
 
     // inject Elmore delay and beta square values to pin nodes
     for( unsigned i=1; i<=leaf_no; ++i )
     {
-        PinNode &cur_pin_node = fanout_rc_tree[i].FetPinNode();
-	double cur_fall_delay = fall_delay_table[i];
-	double cur_rise_delay = rise_delay_table[i];
+        PinNode &cur_pin_node = *(static_cast<PinNode*>(root_pnode.GetFanoutPtr(i-1)));
+	const unsigned pos = rc_tree.GetLeafPos(i);
+
+	if( pos == RCTree::NO_POS ) // not connected, keep zero delay
+	    continue;
+
+	double cur_fall_delay = fall_delay_table[pos];
+	double cur_rise_delay = rise_delay_table[pos];
 
 	for( unsigned j=0; j<cur_pin_node.GetFanoutNo(); ++j )
 	{
@@ -280,113 +256,60 @@ void computeElmoreDelays( const vector<unsigned> &reverse_vec, vector<RCTreeNode
 	    gin_pin.SetFallArrDelay(cur_fall_delay);
 	    gin_pin.SetRiseArrDelay(cur_rise_delay);
 	}
-	
-	assert( DGE( (cur_fall_delay * cur_fall_delay) - (2 * fall_beta_table[i]), 0.0 ) );
-	assert( DGE( (cur_rise_delay * cur_rise_delay) - (2 * rise_beta_table[i]), 0.0 ) );
-	cur_pin_node.SetFallSlewHatSq( (2 * fall_beta_table[i]) - (cur_fall_delay * cur_fall_delay) );
-	cur_pin_node.SetRiseSlewHatSq( (2 * rise_beta_table[i]) - (cur_rise_delay * cur_rise_delay) );
+
+	assert( DGE( (2 * fall_beta_table[pos]) - (cur_fall_delay * cur_fall_delay), 0.0 ) );
+	assert( DGE( (2 * rise_beta_table[pos]) - (cur_rise_delay * cur_rise_delay), 0.0 ) );
+	cur_pin_node.SetFallSlewHatSq( (2 * fall_beta_table[pos]) - (cur_fall_delay * cur_fall_delay) );
+	cur_pin_node.SetRiseSlewHatSq( (2 * rise_beta_table[pos]) - (cur_rise_delay * cur_rise_delay) );
     }
 
     return;
 }
 
-inline void injectWiringEffects( PinNode *pin_node_ptr )
+// a wire reduced while loading (see Circuit::LoadWire) has no RC tree left but has leaf pin nodes, and is skipped
+void injectWiringEffects( PinNode *pin_node_ptr )
 {
-    vector<RCTreeNode> &fanout_rc_tree = pin_node_ptr->FetFanoutRCTree();
+    RCTree *rc_tree_ptr = pin_node_ptr->GetFanoutRCTreePtr();
 
-    if( fanout_rc_tree.size() > 0 )
+    if( rc_tree_ptr != NULL )
     {
 	assert( pin_node_ptr->GetFanoutPinNodeNo() > 0 );
-	vector<unsigned> reverse_vec;
 
-	adjustLinkingAndGetReverseOrder( fanout_rc_tree, reverse_vec ); // adjust fanin and fanouts and set a reverse vector
-	computeElmoreDelays( reverse_vec, fanout_rc_tree );
-	vector<RCTreeNode>().swap( fanout_rc_tree ); // free memory
+	if( !rc_tree_ptr->IsFlat() )
+	    rc_tree_ptr->Flatten( pin_node_ptr->GetFanoutPinNodeNo() ); // orient resistors from the root
+
+	assert( is_topologically_ordered(*rc_tree_ptr) );
+	computeElmoreDelays( *rc_tree_ptr, *pin_node_ptr );
+
+	if( !rc_tree_ptr->HasNodeNames() )
+	    pin_node_ptr->ClearFanoutRCTree(); // free memory
     }
-    else
-    {
-	assert( pin_node_ptr->GetFanoutPinNodeNo() == 0 );
+    else if( pin_node_ptr->GetFanoutPinNodeNo() == 0 )
 	resistShortCircuit( *pin_node_ptr );
-    }
 
     return;
 }
 
-// true if it satisfies both forward topological and backward topological orders
-bool is_topologically_ordered( vector<RCTreeNode> &fanout_rc_tree, const vector<unsigned> &reverse_vec )
+// true if every node is behind its fanin node, fanout nodes of a node are consecutive, and every tap is reached
+bool is_topologically_ordered( const RCTree &rc_tree )
 {
-    assert( fanout_rc_tree.size() == reverse_vec.size() );
-    const unsigned node_no = reverse_vec.size();
-
-    { // forward test
-	vector<bool> nontraversed_table( node_no, true );
+    const unsigned node_no = rc_tree.GetNodeNo();
+    assert( node_no > 1 ); // at least a root and a leaf
 
-        for( int i=static_cast<int>(node_no)-1; i>=0; --i )
-	{
-            const unsigned cur_id = reverse_vec[i];
-
-	    if( i == static_cast<int>(node_no)-1 )
-	    {
-		if( cur_id != 0 )
-		    return false;
-
-		assert( fanout_rc_tree[cur_id].GetPinNodePtr() != NULL );
-		assert( fanout_rc_tree[cur_id].FetFanoutIdResList().size() > 0 ); // root must have fanout
-	    }
-	    else
-	    {
-                 const unsigned fanin_id = fanout_rc_tree[cur_id].GetFaninId();
-                 
-		 if( nontraversed_table[fanin_id] )
-		     return false;
-
-		 const list<pair<unsigned, double> > &fanout_id_res_list = fanout_rc_tree[cur_id].FetFanoutIdResList();
-		 list<pair<unsigned, double> >::const_iterator listIter = fanout_id_res_list.begin();
-
-		 for( ; listIter!=fanout_id_res_list.end(); ++listIter )
-		 {
-		     const unsigned fanout_id = (*listIter).first;
-		     assert( DGE( (*listIter).second, 0.0 ) );
-
-                     if( !(nontraversed_table[fanout_id]) )
-			 return false;
-		 }
-
-		 // tree leaf must be connected to pin-node, but
-		 // be careful, a tree node connected to pin node may not be in tree leaf
-		 assert( fanout_id_res_list.size() > 0 || fanout_rc_tree[cur_id].GetPinNodePtr() != NULL );
-	    }
+    for( unsigned i=1; i<node_no; ++i )
+    {
+	if( rc_tree.GetFaninPos(i) >= i || rc_tree.GetFaninPos(i) < rc_tree.GetFaninPos(i-1) )
+	    return false;
 
-	    assert( DGE( fanout_rc_tree[cur_id].GetCap(), 0.0 ) ); // every node has a specified capacitance
-	    nontraversed_table[cur_id] = false;
-	}
+	assert( DGE( rc_tree.GetRes(i), 0.0 ) );
     }
 
-    { // backward test
-	vector<bool> nontraversed_table( node_no, true );
-
-	for( unsigned i=0; i<reverse_vec.size()-1; ++i )
-	{
-	    const unsigned cur_id = reverse_vec[i];
-	    const unsigned fanin_id = fanout_rc_tree[cur_id].GetFaninId();
-
-	    if( !(nontraversed_table[fanin_id]) )
-		return false;
-
-	    const list<pair<unsigned, double> > &fanout_id_res_list = fanout_rc_tree[cur_id].FetFanoutIdResList();
-	    list<pair<unsigned, double> >::const_iterator listIter = fanout_id_res_list.begin();
-
-	    for( ; listIter!=fanout_id_res_list.end(); ++listIter )
-	    {
-		const unsigned fanout_id = (*listIter).first;
-
-		if( nontraversed_table[fanout_id] )
-		    return false;
-	    }
+    for( unsigned i=0; i<node_no; ++i )
+	assert( DGE( rc_tree.GetCap(i), 0.0 ) ); // every node has a specified capacitance
 
-	    nontraversed_table[cur_id] = false;
-	}
-    }
+    for( unsigned i=1; i<=rc_tree.GetLeafNo(); ++i )
+	if( rc_tree.GetLeafPos(i) == RCTree::NO_POS )
+	    return false;
 
     return true;
 }
@@ -399,8 +322,6 @@ inline void resistShortCircuit( PinNode &cur_pnode )
 	    static_cast<GOutPin*>(fanin_ptr)->GetGatePtr()->GetCellPtr() == NULL )
 	return;
 
-    //printf( "it is %s\n", cur_pnode.GetName().c_str() );
-
     double fall_load = 0.0, rise_load=0.0;
 
     for( unsigned i=0; i<cur_pnode.GetFanoutPtrNo(); ++i )
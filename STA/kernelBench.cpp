@@ -0,0 +1,247 @@
+/************************************************************************
+ *   Micro-benchmark of gate and wire lane kernels. Random gates, each
+ *   with some input arcs of mixed timing senses to one output, are
+ *   propagated by the scalar and the AVX2 lane kernels. Reports million
+ *   gates (or wire taps) per second for the best of several passes, and
+ *   checks that both kernels give bitwise identical values.
+ *
+ *   Usage: KernelBench [gate number] [arc number per gate] [pass number]
+ *
+ *   Author      : Kuan-Hsien Ho
+************************************************************************/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "ArcDelayTable.h"
+#include "Cell.h"
+#include "GateKernel.h"
+#include "TimingStore.h"
+
+using namespace std;
+
+//-----------------------------------------------------------------------
+//    Declare auxiliary functions
+//-----------------------------------------------------------------------
+
+struct BenchArc
+{
+    InputTimingTable Timing;
+    double InputArrival[TimingStore::SPLIT_NO];
+    double InputSlew[TimingStore::SPLIT_NO];
+    unsigned Slot; // first slot in the delay arrays
+};
+
+struct BenchGate
+{
+    unsigned ArcBegin; // arcs of the gate, with the same order of timing senses
+    unsigned ArcEnd;
+    double Load[EDGE_NO];
+};
+
+void generateGates( const unsigned &gate_no, const unsigned &arc_no, vector<BenchGate> &gate_vec, vector<BenchArc> &arc_vec, unsigned &slot_no );
+
+double runGatePass( const vector<BenchGate> &gate_vec, const vector<BenchArc> &arc_vec, const bool &is_avx2,
+	            vector<double> delay_vec[], vector<double> &result_vec ); // return seconds
+
+double runWirePass( const vector<BenchArc> &arc_vec, const bool &is_avx2, vector<double> &result_vec ); // return seconds
+
+//-----------------------------------------------------------------------
+//    Main function
+//-----------------------------------------------------------------------
+
+int main(int argc, char **argv)
+{
+    if( argc > 4 )
+    {
+	printf( "Usage: %s [gate number] [arc number per gate] [pass number]\n", argv[0] );
+	printf( "  Exiting...\n" );
+	exit(-1);
+    }
+
+    const unsigned gate_no = (argc > 1)? atoi(argv[1]): 10000; // small enough to stay in cache
+    const unsigned arc_no = (argc > 2)? atoi(argv[2]): 3;
+    const int pass_no = (argc > 3)? atoi(argv[3]): 100;
+    vector<BenchGate> gate_vec;
+    vector<BenchArc> arc_vec;
+    unsigned slot_no = 0;
+
+    generateGates( gate_no, arc_no, gate_vec, arc_vec, slot_no );
+    printf( "%u gates of %u arcs, best of %d passes, AVX2 %s\n", gate_no, arc_no, pass_no,
+	    getIsAvx2Supported()? "supported": "not supported" );
+
+    const unsigned kernel_no = getIsAvx2Supported()? 2: 1;
+    const char *kernel_name_arr[2] = {"scalar", "avx2"};
+    vector<double> delay_vec_arr[2][ArcDelayTable::MODE_NO], gate_result_vec_arr[2], wire_result_vec_arr[2];
+
+    for( unsigned k=0; k<kernel_no; ++k )
+    {
+	double gate_best = 0.0, wire_best = 0.0;
+
+	for( unsigned m=0; m<ArcDelayTable::MODE_NO; ++m )
+	    delay_vec_arr[k][m].assign( slot_no, 0.0 );
+
+	for( int p=0; p<pass_no; ++p )
+	{
+	    const double gate_sec = runGatePass( gate_vec, arc_vec, (k == 1), delay_vec_arr[k], gate_result_vec_arr[k] );
+	    const double wire_sec = runWirePass( arc_vec, (k == 1), wire_result_vec_arr[k] );
+
+	    if( p == 0 || gate_sec < gate_best )
+		gate_best = gate_sec;
+
+	    if( p == 0 || wire_sec < wire_best )
+		wire_best = wire_sec;
+	}
+
+	printf( "  %-7s: %8.2lf Mgates/s, %8.2lf Mtaps/s\n", kernel_name_arr[k], gate_vec.size() / gate_best / 1e6, arc_vec.size() / wire_best / 1e6 );
+    }
+
+    if( kernel_no == 2 )
+    {
+	bool is_same = ( gate_result_vec_arr[0].size() == gate_result_vec_arr[1].size() && wire_result_vec_arr[0].size() == wire_result_vec_arr[1].size() );
+
+	for( unsigned m=0; m<ArcDelayTable::MODE_NO; ++m )
+	    is_same = is_same && !memcmp( delay_vec_arr[0][m].data(), delay_vec_arr[1][m].data(), slot_no*sizeof(double) );
+
+	is_same = is_same && !memcmp( gate_result_vec_arr[0].data(), gate_result_vec_arr[1].data(), gate_result_vec_arr[0].size()*sizeof(double) );
+	is_same = is_same && !memcmp( wire_result_vec_arr[0].data(), wire_result_vec_arr[1].data(), wire_result_vec_arr[0].size()*sizeof(double) );
+	printf( "  results: %s\n", is_same? "bitwise identical": "DIFFERENT" );
+
+	if( !is_same )
+	    exit(-1);
+    }
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------
+//    Define auxiliary functions
+//-----------------------------------------------------------------------
+
+void generateGates( const unsigned &gate_no, const unsigned &arc_no, vector<BenchGate> &gate_vec, vector<BenchArc> &arc_vec, unsigned &slot_no )
+{
+    mt19937_64 rng( 2014 );
+    uniform_real_distribution<double> coef( 0.0, 2.0 ), arrival( 0.0, 100.0 ), slew( 1.0, 20.0 );
+    const InputTimingTable::TimingSense sense_arr[4] = {InputTimingTable::NEGATIVE_UNATE, InputTimingTable::NEGATIVE_UNATE,
+	                                                InputTimingTable::POSITIVE_UNATE, InputTimingTable::NON_UNATE};
+
+    gate_vec.resize( gate_no );
+    arc_vec.resize( gate_no * arc_no );
+    slot_no = 0;
+
+    for( unsigned i=0; i<gate_no; ++i )
+    {
+	BenchGate &gate = gate_vec[i];
+	gate.ArcBegin = i * arc_no;
+	gate.ArcEnd = gate.ArcBegin + arc_no;
+	gate.Load[FALL] = coef(rng);
+	gate.Load[RISE] = coef(rng);
+
+	for( unsigned j=gate.ArcBegin; j<gate.ArcEnd; ++j )
+	{
+	    InputTimingTable &timing = arc_vec[j].Timing;
+	    timing.PinTimingSense = sense_arr[(i+j) % 4];
+	    timing.FallSlewX = coef(rng);  timing.FallSlewY = coef(rng);  timing.FallSlewZ = coef(rng) / 4;
+	    timing.FallDelayA = coef(rng); timing.FallDelayB = coef(rng); timing.FallDelayC = coef(rng) / 4;
+	    timing.RiseSlewX = coef(rng);  timing.RiseSlewY = coef(rng);  timing.RiseSlewZ = coef(rng) / 4;
+	    timing.RiseDelayA = coef(rng); timing.RiseDelayB = coef(rng); timing.RiseDelayC = coef(rng) / 4;
+
+	    for( unsigned s=0; s<TimingStore::SPLIT_NO; ++s )
+	    {
+		arc_vec[j].InputArrival[s] = arrival(rng);
+		arc_vec[j].InputSlew[s] = slew(rng);
+	    }
+
+	    arc_vec[j].Slot = slot_no;
+
+	    if( timing.PinTimingSense == InputTimingTable::NON_UNATE )
+		slot_no += ArcDelayTable::NON_UNATE_SLOT_NO;
+	    else
+		slot_no += ArcDelayTable::UNATE_SLOT_NO;
+	}
+    }
+
+    return;
+}
+
+double runGatePass( const vector<BenchGate> &gate_vec, const vector<BenchArc> &arc_vec, const bool &is_avx2,
+	            vector<double> delay_vec[], vector<double> &result_vec )
+{
+    double *fast_delay_arr = delay_vec[ArcDelayTable::FAST].data();
+    double *slow_delay_arr = delay_vec[ArcDelayTable::SLOW].data();
+    result_vec.assign( gate_vec.size() * 2 * TimingStore::SPLIT_NO, 0.0 );
+    const auto begin_time = chrono::steady_clock::now();
+
+    for( unsigned i=0; i<gate_vec.size(); ++i )
+    {
+	double *output_arrival = &result_vec[i * 2 * TimingStore::SPLIT_NO];
+	double *output_slew = output_arrival + TimingStore::SPLIT_NO;
+	output_arrival[TimingStore::FAST_FALL] = output_arrival[TimingStore::FAST_RISE] = getInitArrival<ArcDelayTable::FAST>();
+	output_arrival[TimingStore::SLOW_FALL] = output_arrival[TimingStore::SLOW_RISE] = getInitArrival<ArcDelayTable::SLOW>();
+	output_slew[TimingStore::FAST_FALL] = output_slew[TimingStore::FAST_RISE] = getInitArrival<ArcDelayTable::FAST>();
+	output_slew[TimingStore::SLOW_FALL] = output_slew[TimingStore::SLOW_RISE] = getInitArrival<ArcDelayTable::SLOW>();
+
+	for( unsigned j=gate_vec[i].ArcBegin; j<gate_vec[i].ArcEnd; ++j )
+	{
+	    const BenchArc &arc = arc_vec[j];
+	    double *fast_arc_delay = fast_delay_arr + arc.Slot, *slow_arc_delay = slow_delay_arr + arc.Slot;
+
+	    switch( arc.Timing.PinTimingSense )
+	    {
+		case InputTimingTable::POSITIVE_UNATE:
+		    if( is_avx2 )
+			propagateArcAvx2<InputTimingTable::POSITIVE_UNATE>( arc.Timing, arc.InputArrival, arc.InputSlew, gate_vec[i].Load,
+				                                            fast_arc_delay, slow_arc_delay, output_arrival, output_slew );
+		    else
+			propagateArcLanes<InputTimingTable::POSITIVE_UNATE>( arc.Timing, arc.InputArrival, arc.InputSlew, gate_vec[i].Load,
+				                                             fast_arc_delay, slow_arc_delay, output_arrival, output_slew );
+		    break;
+		case InputTimingTable::NEGATIVE_UNATE:
+		    if( is_avx2 )
+			propagateArcAvx2<InputTimingTable::NEGATIVE_UNATE>( arc.Timing, arc.InputArrival, arc.InputSlew, gate_vec[i].Load,
+				                                            fast_arc_delay, slow_arc_delay, output_arrival, output_slew );
+		    else
+			propagateArcLanes<InputTimingTable::NEGATIVE_UNATE>( arc.Timing, arc.InputArrival, arc.InputSlew, gate_vec[i].Load,
+				                                             fast_arc_delay, slow_arc_delay, output_arrival, output_slew );
+		    break;
+		default:
+		    if( is_avx2 )
+			propagateArcAvx2<InputTimingTable::NON_UNATE>( arc.Timing, arc.InputArrival, arc.InputSlew, gate_vec[i].Load,
+				                                       fast_arc_delay, slow_arc_delay, output_arrival, output_slew );
+		    else
+			propagateArcLanes<InputTimingTable::NON_UNATE>( arc.Timing, arc.InputArrival, arc.InputSlew, gate_vec[i].Load,
+				                                        fast_arc_delay, slow_arc_delay, output_arrival, output_slew );
+		    break;
+	    }
+	}
+    }
+
+    return chrono::duration<double>( chrono::steady_clock::now() - begin_time ).count();
+}
+
+// every arc input is taken as a wire root, and its timing coefficients as wire delays and slew hats
+double runWirePass( const vector<BenchArc> &arc_vec, const bool &is_avx2, vector<double> &result_vec )
+{
+    result_vec.assign( arc_vec.size() * 2 * TimingStore::SPLIT_NO, 0.0 );
+    const auto begin_time = chrono::steady_clock::now();
+
+    for( unsigned i=0; i<arc_vec.size(); ++i )
+    {
+	const BenchArc &arc = arc_vec[i];
+	const double wire_delay[EDGE_NO] = {arc.Timing.FallDelayA, arc.Timing.RiseDelayA};
+	const double slew_hat_sq[EDGE_NO] = {arc.Timing.FallSlewX, arc.Timing.RiseSlewX};
+	double *tap_arrival = &result_vec[i * 2 * TimingStore::SPLIT_NO];
+	double *tap_slew = tap_arrival + TimingStore::SPLIT_NO;
+
+	if( is_avx2 )
+	    propagateWireAvx2( arc.InputArrival, arc.InputSlew, wire_delay, slew_hat_sq, tap_arrival, tap_slew );
+	else
+	    propagateWireLanes( arc.InputArrival, arc.InputSlew, wire_delay, slew_hat_sq, tap_arrival, tap_slew );
+    }
+
+    return chrono::duration<double>( chrono::steady_clock::now() - begin_time ).count();
+}
@@ -6,34 +6,160 @@
 
 #include <cstdlib>
 #include <cstdio>
+#include <cstring>
+#include <string_view>
 
 #include "CellLibrary.h"
 #include "Circuit.h"
+#include "GateKernel.h"
+#include "MappedFile.h"
+#include "NameTable.h"
 #include "process.h"
 #include "util.h"
 
+//-----------------------------------------------------------------------
+//    Declare auxiliary functions
+//-----------------------------------------------------------------------
+
+void exitWithUsage( const char *exe_name );
+
+void loadNameTable( const char *file_name, NameTable &name_table ); // whitespace-separated names
+
+//-----------------------------------------------------------------------
+//    Main function
+//-----------------------------------------------------------------------
+
 int main(int argc, char **argv)
 {
-    if(argc != 4)
+    const char *lib_image_name = NULL;     // binary library image, used instead of parsing the library if up to date
+    const char *save_snapshot_name = NULL; // write the circuit after injecting wiring effects
+    const char *load_snapshot_name = NULL; // read the wired circuit instead of parsing the netlist and wiring
+    bool is_streaming_wires = false;       // reduce each wire while parsing it
+    bool is_keeping_rc_trees = false;      // keep RC trees after injecting wiring effects for editing parasitics
+    const char *kept_wire_file_name = NULL; // roots of the wires whose RC trees are kept, all if NULL
+    unsigned thread_no = 1;                // 0 for the number of hardware threads
+    unsigned chunk_size = 64;              // gates per task of levelized STA
+    bool is_task_graph = false;            // forward STA as a task graph instead of level by level
+    bool is_push_backward = false;         // backward STA pushes required times by atomic min/max instead of pulling
+    bool is_scalar_kernel = false;         // do not use the AVX2 gate kernels even if supported
+    const char *ops_file_name = NULL;      // timing operations after STA
+    const char *file_name_arr[3];          // library, netlist (or constraints if a snapshot is loaded) and output files
+    int file_no = 0;
+
+    for( int i=1; i<argc; ++i )
     {
-	printf( "Usage: %s [library file] [netlist file] [output file]\n", argv[0] );
-	printf( "  Exiting...\n" );
-	exit(-1);
+	if( !strcmp(argv[i], "-lib_image") && i+1 < argc )
+	    lib_image_name = argv[++i];
+	else if( !strcmp(argv[i], "-save_snapshot") && i+1 < argc )
+	    save_snapshot_name = argv[++i];
+	else if( !strcmp(argv[i], "-load_snapshot") && i+1 < argc )
+	    load_snapshot_name = argv[++i];
+	else if( !strcmp(argv[i], "-stream_wires") )
+	    is_streaming_wires = true;
+	else if( !strcmp(argv[i], "-keep_rc") )
+	    is_keeping_rc_trees = true;
+	else if( !strcmp(argv[i], "-keep_rc_wires") && i+1 < argc )
+	{
+	    is_keeping_rc_trees = true;
+	    kept_wire_file_name = argv[++i];
+	}
+	else if( !strcmp(argv[i], "-threads") && i+1 < argc )
+	    thread_no = atoi(argv[++i]);
+	else if( !strcmp(argv[i], "-chunk_size") && i+1 < argc )
+	    chunk_size = atoi(argv[++i]);
+	else if( !strcmp(argv[i], "-task_graph") )
+	    is_task_graph = true;
+	else if( !strcmp(argv[i], "-push_backward") )
+	    is_push_backward = true;
+	else if( !strcmp(argv[i], "-scalar_kernel") )
+	    is_scalar_kernel = true;
+	else if( !strcmp(argv[i], "-ops") && i+1 < argc )
+	    ops_file_name = argv[++i];
+	else if( argv[i][0] != '-' && file_no < 3 )
+	    file_name_arr[file_no++] = argv[i];
+	else
+	    exitWithUsage( argv[0] );
     }
 
-    CellLibrary cell_library( argv[1] ); // declare and initialize cell library
+    if( file_no != 3 || (save_snapshot_name != NULL && load_snapshot_name != NULL) || chunk_size == 0 ||
+	(load_snapshot_name != NULL && is_keeping_rc_trees) ) // a snapshot has no RC tree
+	exitWithUsage( argv[0] );
+
+    if( is_scalar_kernel )
+	setIsAvx2KernelOn( false );
+
+    ThreadPool thread_pool( thread_no );
+    CellLibrary cell_library( file_name_arr[0], lib_image_name ); // declare and initialize cell library
 //    cell_library.PrintCellLibraryData();    
     
-    Circuit circuit( argv[2], cell_library );
-//    circuit.PrintCircuitData();
+    Circuit *circuit_ptr = NULL;
+
+    if( load_snapshot_name != NULL )
+	circuit_ptr = new Circuit( load_snapshot_name, file_name_arr[1], cell_library, file_name_arr[0] ); // wired already
+    else
+    {
+	NameTable kept_wire_table;
+
+	if( kept_wire_file_name != NULL )
+	    loadNameTable( kept_wire_file_name, kept_wire_table );
+
+	circuit_ptr = new Circuit( file_name_arr[1], cell_library, is_streaming_wires, is_keeping_rc_trees, 
+		                   (kept_wire_file_name != NULL)? &kept_wire_table: NULL );
+//	circuit_ptr->PrintCircuitData();
+
+	injectWiringEffects( *circuit_ptr, thread_pool ); // wires left by streaming, or all wires
 
-    injectWiringEffects( circuit );
+	if( save_snapshot_name != NULL )
+	    circuit_ptr->SaveSnapshot( save_snapshot_name, file_name_arr[0] );
+    }
+
+    Circuit &circuit = (*circuit_ptr);
+
+    runSTA( circuit, thread_pool, chunk_size, is_task_graph, is_push_backward );
 
-    runSTA( circuit );
+    if( ops_file_name != NULL )
+	runOperations( circuit, cell_library, ops_file_name );
 
-    circuit.PrintTimingData( argv[3] );
+    circuit.PrintTimingData( file_name_arr[2] );
+    delete circuit_ptr; // frees the arenas of gates and pin nodes
 
     printf( "Memory Usage: %.10lfMB\n", getPeakMemoryUsage() );
 
     return 0;
 }
+
+//-----------------------------------------------------------------------
+//    Define auxiliary functions 
+//-----------------------------------------------------------------------
+
+void exitWithUsage( const char *exe_name )
+{
+    printf( "Usage: %s [options] [library file] [netlist file] [output file]\n", exe_name );
+    printf( "  -lib_image <file>    : load the binary library image, or write it if missing or older than the library\n" );
+    printf( "  -save_snapshot <file>: write the circuit after injecting wiring effects\n" );
+    printf( "  -load_snapshot <file>: read the wired circuit from a snapshot; the netlist file gives the constraints\n" );
+    printf( "                         and the library file must be the one the snapshot is made with\n" );
+    printf( "  -stream_wires        : reduce each wire while parsing, so that only one RC tree is kept in memory\n" );
+    printf( "  -keep_rc             : keep RC trees of all wires after wiring, for editing parasitics and replacing cells\n" );
+    printf( "  -keep_rc_wires <file>: keep RC trees of the wires whose root pin nodes are listed in the file\n" );
+    printf( "  -threads <n>         : number of threads, 0 for all hardware threads (default 1); STA runs in parallel if more than 1\n" );
+    printf( "  -chunk_size <n>      : gates per task of levelized STA (default 64)\n" );
+    printf( "  -task_graph          : run parallel forward STA as a task graph of gates instead of level by level\n" );
+    printf( "  -push_backward       : run parallel backward STA by pushing required times with atomic min/max instead of pulling\n" );
+    printf( "  -scalar_kernel       : use the scalar gate kernels even if the CPU supports AVX2\n" );
+    printf( "  -ops <file>          : run timing operations after STA, and print their reports on screen\n" );
+    printf( "  Exiting...\n" );
+    exit(-1);
+}
+
+void loadNameTable( const char *file_name, NameTable &name_table )
+{
+    MappedFile inf( file_name ); // exit if failed
+    LineTokenizer tokenizer( inf );
+    bool is_new;
+
+    for( std::string_view name = tokenizer.NextWord(); !name.empty(); name = tokenizer.NextWord() )
+	name_table.Grab( name, is_new );
+
+    return;
+}
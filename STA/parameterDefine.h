@@ -1,8 +1,6 @@
 #ifndef PARAMETER_DEFINE_H
 #define PARAMETER_DEFINE_H
 
-#define LINE_LEN 10000
-
 #define MAX_REQ_TIME (1.0e+200) // almost max, std::numeric_limits<double>::max() in <limits> give its limit 1.797693e+308
 
 #define MIN_REQ_TIME (-1.0e+200) 
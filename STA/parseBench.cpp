@@ -0,0 +1,153 @@
+/************************************************************************
+ *   Micro-benchmark of netlist parsing. The netlist is mapped once and
+ *   its res/cap values are parsed by the old atof() path and by the
+ *   shared parseDouble(), after a tokenizing-only pass. Reports MB/s of
+ *   the whole netlist for the best of several passes, and checks that
+ *   both number paths give bitwise identical values.
+ *
+ *   Usage: ParseBench [netlist file] [pass number]
+ *
+ *   Author      : Kuan-Hsien Ho
+************************************************************************/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+
+#include "MappedFile.h"
+#include "NumberParse.h"
+
+using namespace std;
+
+//-----------------------------------------------------------------------
+//    Declare auxiliary functions 
+//-----------------------------------------------------------------------
+
+enum ParseMode
+{
+    TOKENIZE_ONLY, // split lines and tokens, no number is parsed
+    ATOF,          // copy each number to a null-terminated buffer, then atof()
+    FROM_CHARS     // parseDouble(), i.e., std::from_chars in place
+};
+
+double parseAtof( string_view token );
+
+double runPass( const MappedFile &inf, const ParseMode &mode, double &checksum, unsigned &number_no ); // return seconds
+
+//-----------------------------------------------------------------------
+//    Main function
+//-----------------------------------------------------------------------
+
+int main(int argc, char **argv)
+{
+    if( argc != 2 && argc != 3 )
+    {
+	printf( "Usage: %s [netlist file] [pass number]\n", argv[0] );
+	printf( "  Exiting...\n" );
+	exit(-1);
+    }
+
+    const int pass_no = (argc == 3)? atoi(argv[2]): 5;
+    MappedFile inf( argv[1] ); // exit if failed
+    const double mega_byte_no = inf.GetSize() / (1024.0 * 1024.0);
+    const char *mode_name_arr[3] = {"tokenize only", "atof", "from_chars"};
+    double checksum_arr[3] = {0.0, 0.0, 0.0};
+    unsigned number_no = 0;
+
+    printf( "%s: %.1lfMB, best of %d passes\n", argv[1], mega_byte_no, pass_no );
+
+    for( int mode=TOKENIZE_ONLY; mode<=FROM_CHARS; ++mode )
+    {
+	double best_time = 0.0;
+
+	for( int i=0; i<pass_no || i==0; ++i )
+	{
+	    const double cur_time = runPass( inf, static_cast<ParseMode>(mode), checksum_arr[mode], number_no );
+
+	    if( i == 0 || cur_time < best_time )
+		best_time = cur_time;
+	}
+
+	printf( "  %-14s %8.1lf MB/s  (%.3lfs)\n", mode_name_arr[mode], mega_byte_no / best_time, best_time );
+    }
+
+    printf( "  %u res/cap values\n", number_no );
+
+    if( memcmp(&(checksum_arr[ATOF]), &(checksum_arr[FROM_CHARS]), sizeof(double)) != 0 )
+    {
+	printf( "Error: atof and from_chars values differ\n" );
+	return -1;
+    }
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------
+//    Define auxiliary functions 
+//-----------------------------------------------------------------------
+
+// number parsing of LineTokenizer::NextDouble() before parseDouble()
+double parseAtof( string_view token )
+{
+    char buf[64]; // a number token is short; the mapped bytes are not null-terminated
+    const size_t length = (token.size() < sizeof(buf))? token.size(): sizeof(buf)-1;
+
+    memcpy(buf, token.data(), length);
+    buf[length] = '\0';
+
+    return atof(buf);
+}
+
+double runPass( const MappedFile &inf, const ParseMode &mode, double &checksum, unsigned &number_no )
+{
+    const chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    LineTokenizer tokenizer( inf );
+    double sum = 0.0;
+    size_t token_length_sum = 0; // keep tokenizing from being optimized away
+    number_no = 0;
+
+    while( tokenizer.NextLine() )
+    {
+	const string_view word = tokenizer.NextToken();
+	unsigned skip_no = 0; // name tokens before the value
+
+	if( word == "res" )
+	    skip_no = 2;
+	else if( word == "cap" )
+	    skip_no = 1;
+
+	if( skip_no == 0 )
+	{
+	    for( string_view token=tokenizer.NextToken(); !token.empty(); token=tokenizer.NextToken() )
+		token_length_sum += token.size();
+
+	    continue;
+	}
+
+	for( unsigned i=0; i<skip_no; ++i )
+	    token_length_sum += tokenizer.NextToken().size();
+
+	const string_view token = tokenizer.NextToken();
+	++number_no;
+
+	switch( mode )
+	{
+	    case TOKENIZE_ONLY:
+		token_length_sum += token.size();
+		break;
+	    case ATOF:
+		sum += parseAtof( token );
+		break;
+	    case FROM_CHARS:
+		sum += parseDouble( token );
+		break;
+	}
+    }
+
+    const chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    checksum = sum + (token_length_sum == 0? 1.0: 0.0);
+
+    return elapsed.count();
+}
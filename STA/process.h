@@ -10,18 +10,31 @@
 #include "Circuit.h"
 #include "Gate.h"
 #include "PinNode.h"
+#include "ThreadPool.h"
 
-void backtraceSignal( Gate &cur_gate ); // backtraceFastSignal() + backtraceSlowSignal()
+void backtraceSignal( Circuit &circuit, const unsigned &gate_id ); // backtraceFastSignal() + backtraceSlowSignal()
 
-void backtraceFastSignal( Gate &cur_gate );
+void backtraceFastSignal( Circuit &circuit, const unsigned &gate_id );
 
-void backtraceSlowSignal( Gate &cur_gate );
+void backtraceSlowSignal( Circuit &circuit, const unsigned &gate_id );
+
+void backtraceInputSignal( Circuit &circuit, const unsigned &input_id ); // into one gate input pin node, in both modes
+
+void backtraceSharedInputSignal( Circuit &circuit, const unsigned &input_id ); // atomically, into a pin node shared by threads
 
 void injectWiringEffects( Circuit &circuit ); // inject all pin-node loads and Elmore delays 
 
-void propagateSignal( Gate *gate_ptr ); // propagateFastSignal() + propagateSlowSignal()
+void injectWiringEffects( Circuit &circuit, ThreadPool &thread_pool ); // wires in parallel, largest RC tree first
+
+void injectWiringEffects( PinNode *pin_node_ptr ); // inject loads and Elmore delays of the wire driven by a pin node
+
+void propagateSignal( Circuit &circuit, const unsigned &gate_id ); // propagateFastSignal() + propagateSlowSignal()
+
+void propagateSignal( Circuit &circuit, const unsigned &input_pin_id, Gate *gate_ptr ); // clock to Q and QN
+
+void propagateWireSignal( Circuit &circuit, const unsigned &root_id ); // from a gate output pin node to its taps
 
-void propagateSignal( const unsigned &input_pin_id, Gate *gate_ptr ); // clock to Q and QN
+void propagateGateSignal( Circuit &circuit, const unsigned &gate_id ); // through a gate, and then its output wires
 
 void resistDefectPinNodes( Circuit &circuit );
 
@@ -29,10 +42,24 @@ void runComBackwardSTA( Circuit &circuit );
 
 void runComForwardSTA( Circuit &circuit );
 
-void runSTA( Circuit &circuit );
+// after STA, if only required times or the clock period change; backward STA only
+void runConstraintSTA( Circuit &circuit, ThreadPool &thread_pool, const unsigned &chunk_size, const bool &is_push_backward );
+
+void runIncrementalSTA( Circuit &circuit, const std::vector<unsigned> &dirty_gate_id_vec, const std::vector<unsigned> &dirty_root_id_vec,
+	                const std::vector<unsigned> &dirty_req_root_id_vec, const double &tolerance ); // after STA
+
+void runLevelBackwardSTA( Circuit &circuit, ThreadPool &thread_pool, const unsigned &chunk_size, const bool &is_pushing ); // levels in reverse
+
+void runLevelForwardSTA( Circuit &circuit, ThreadPool &thread_pool, const unsigned &chunk_size ); // levels in parallel
+
+void runOperations( Circuit &circuit, const CellLibrary &cell_library, const char *file_name ); // after STA, edits and reports
+
+void runSTA( Circuit &circuit, ThreadPool &thread_pool, const unsigned &chunk_size, const bool &is_task_graph, const bool &is_push_backward );
 
 void runSeqBackwardSTA( Circuit &circuit );
 
 void runSeqForwardSTA( Circuit &circuit );
 
+void runTaskForwardSTA( Circuit &circuit, ThreadPool &thread_pool, const unsigned &chunk_size ); // gates as tasks in parallel
+
 #endif // PROCESS_H
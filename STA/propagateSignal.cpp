@@ -10,8 +10,13 @@
 #include <cstdio>
 #include <vector>
 
+#include "ArcDelayTable.h"
+#include "Circuit.h"
 #include "Gate.h"
+#include "GateKernel.h"
 #include "PinNode.h"
+#include "TimingGraph.h"
+#include "TimingStore.h"
 #include "process.h"
 
 using namespace std;
@@ -20,202 +25,85 @@ using namespace std;
 //    Declare main functions
 //-----------------------------------------------------------------------
 
-void propagateSignal( Gate *gate_ptr ); // propagate both fast and slow signals
+void propagateSignal( Circuit &circuit, const unsigned &gate_id ); // propagate both fast and slow signals, and record arc delays
 
-void propagateSignal( const unsigned &input_pin_id, Gate *gate_ptr ); // clock to Q with early-mode and late-mode
+void propagateSignal( Circuit &circuit, const unsigned &input_pin_id, Gate *gate_ptr ); // clock to Q with early-mode and late-mode
+
+void propagateWireSignal( Circuit &circuit, const unsigned &root_id ); // from a gate output pin node to its taps
+
+void propagateGateSignal( Circuit &circuit, const unsigned &gate_id ); // through a gate, and then its output wires
 
 //-----------------------------------------------------------------------
 //    Declare auxiliary functions 
 //-----------------------------------------------------------------------
 
-double computeGateOutputFall( const InputTimingTable &timing, const double &input_arrival, const double &input_slew, const double &load, vector<double> &output_arrival, vector<double> &output_slew );
-
-double computeGateOutputRise( const InputTimingTable &timing, const double &input_arrival, const double &input_slew, const double &load, vector<double> &output_arrival, vector<double> &output_slew );
+// fold the arcs of a timing sense to an output pin into the running output extrema of all lanes, i.e., timing store splits
+template<InputTimingTable::TimingSense SENSE>
+void propagateSenseArcs( const TimingGraph &graph, TimingStore &store, ArcDelayTable &delay_table, const Cell &cur_cell, 
+	                 const unsigned &gate_id, const unsigned &output_pin_id, const double load[], const bool &is_avx2, 
+			 double output_arrival[], double output_slew[] );
 
 //-----------------------------------------------------------------------
 //    Define main functions
 //-----------------------------------------------------------------------
 
-void propagateSignal( Gate *gate_ptr )
+void propagateSignal( Circuit &circuit, const unsigned &gate_id )
 {
+    const TimingGraph &graph = circuit.GetTimingGraph();
+    TimingStore &store = circuit.FetTimingStore();
+    ArcDelayTable &delay_table = circuit.FetArcDelayTable();
+    Gate *gate_ptr = graph.GetGatePtr(gate_id);
     assert( gate_ptr->GetCellPtr()->GetIsNonClocked() );
     const Cell &cur_cell = *(gate_ptr->GetCellPtr());
-    const vector<vector<InputTimingTable> > &timing_vec = cur_cell.FetInputTimingVec();
-    const unsigned input_no = cur_cell.GetInputPinNo();
-
-    // index corresponds to input pin index, so resize directly
-    vector<double> input_fastFall_arrival(input_no), input_fastRise_arrival(input_no);
-    vector<double> input_fastFall_slew(input_no), input_fastRise_slew(input_no);
-    vector<double> input_slowFall_arrival(input_no), input_slowRise_arrival(input_no);
-    vector<double> input_slowFall_slew(input_no), input_slowRise_slew(input_no);
-
-    for( unsigned i=0; i<input_no; ++i )
-    {
-	PinNode *cur_pnode_ptr = gate_ptr->GetInputPinNode(i);
-
-	if( cur_pnode_ptr == NULL || cur_pnode_ptr->GetFaninPtr() == NULL )
-	    continue;
-
-	PinNode &cur_pnode = *(cur_pnode_ptr);
-	input_fastFall_arrival[i] = cur_pnode.GetFastFallArrTime();
-	input_fastRise_arrival[i] = cur_pnode.GetFastRiseArrTime();
-	input_fastFall_slew[i]    = cur_pnode.GetFastFallSlew();
-	input_fastRise_slew[i]    = cur_pnode.GetFastRiseSlew();
-	input_slowFall_arrival[i] = cur_pnode.GetSlowFallArrTime();
-	input_slowRise_arrival[i] = cur_pnode.GetSlowRiseArrTime();
-	input_slowFall_slew[i]    = cur_pnode.GetSlowFallSlew();
-	input_slowRise_slew[i]    = cur_pnode.GetSlowRiseSlew();
-    }
-
-    // use push back to insert due to non-uncate case
-    vector<double> output_fastFall_arrival, output_fastRise_arrival; // accumulated delay
-    vector<double> output_fastFall_slew, output_fastRise_slew;
-    vector<double> output_slowFall_arrival, output_slowRise_arrival; // accumulated delay
-    vector<double> output_slowFall_slew, output_slowRise_slew;
-
-    output_fastFall_arrival.reserve(input_no);
-    output_fastRise_arrival.reserve(input_no);
-    output_fastFall_slew.reserve(input_no);
-    output_fastRise_slew.reserve(input_no);
-    output_slowFall_arrival.reserve(input_no);
-    output_slowRise_arrival.reserve(input_no);
-    output_slowFall_slew.reserve(input_no);
-    output_slowRise_slew.reserve(input_no);
-
     const unsigned output_no = cur_cell.GetOutputPinNo();
+    const bool is_avx2 = getIsAvx2KernelOn();
 
     // consider every output 
     for( unsigned i=0; i<output_no; ++i )
     {
-	GOutPin &gout_pin = gate_ptr->FetGOutPin(i);
+	const unsigned output_pnode_id = graph.GetOutputPinNodeId( graph.GetOutputBegin(gate_id)+i );
 
-	if( gout_pin.GetFanoutPtr() == NULL )
+	if( output_pnode_id == TimingGraph::NO_ID || graph.GetFanoutNo(output_pnode_id) == 0 )
 	    continue;
 
-	PinNode &output_pnode = *(gout_pin.GetFanoutPtr());
+	const double load[EDGE_NO] = {gate_ptr->GetOutputFallLoad(i), gate_ptr->GetOutputRiseLoad(i)};
 
-	if( output_pnode.GetFanoutPtrNo() == 0 )
-	    continue;
+	// running extrema over all inputs
+	double output_arrival[TimingStore::SPLIT_NO] = {getInitArrival<ArcDelayTable::FAST>(), getInitArrival<ArcDelayTable::FAST>(),
+	                                                getInitArrival<ArcDelayTable::SLOW>(), getInitArrival<ArcDelayTable::SLOW>()};
+	double output_slew[TimingStore::SPLIT_NO] = {getInitArrival<ArcDelayTable::FAST>(), getInitArrival<ArcDelayTable::FAST>(),
+	                                             getInitArrival<ArcDelayTable::SLOW>(), getInitArrival<ArcDelayTable::SLOW>()};
+
+	propagateSenseArcs<InputTimingTable::POSITIVE_UNATE>( graph, store, delay_table, cur_cell, gate_id, i, load, is_avx2, output_arrival, output_slew );
+	propagateSenseArcs<InputTimingTable::NEGATIVE_UNATE>( graph, store, delay_table, cur_cell, gate_id, i, load, is_avx2, output_arrival, output_slew );
+	propagateSenseArcs<InputTimingTable::NON_UNATE>( graph, store, delay_table, cur_cell, gate_id, i, load, is_avx2, output_arrival, output_slew );
 
-	const double fall_load = gate_ptr->GetOutputFallLoad(i);
-	const double rise_load = gate_ptr->GetOutputRiseLoad(i);
-	gout_pin.InitFastDelayDataPtrVec(input_no);
-	gout_pin.InitSlowDelayDataPtrVec(input_no);
+	assert( output_arrival[TimingStore::FAST_FALL] != getInitArrival<ArcDelayTable::FAST>() ); // at least one input has a signal
 
-        for( unsigned j=0; j<input_no; ++j )
+	for( unsigned s=0; s<TimingStore::SPLIT_NO; ++s )
 	{
-	    PinNode *cur_pnode_ptr = gate_ptr->GetInputPinNode(j);
-
-	    if( cur_pnode_ptr == NULL || cur_pnode_ptr->GetFaninPtr() == NULL )
-		continue;
-
-            const InputTimingTable &timing = timing_vec[j][i];
-
-	    switch( timing.PinTimingSense )
-	    {
-		case InputTimingTable::NEGATIVE_UNATE:
-		    {
-			UnateDelayData *delay_ptr = new UnateDelayData();
-			delay_ptr->DelayFromInputRise = computeGateOutputFall( timing, input_fastRise_arrival[j], 
-				input_fastRise_slew[j], fall_load, output_fastFall_arrival, output_fastFall_slew );
-			delay_ptr->DelayFromInputFall = computeGateOutputRise( timing, input_fastFall_arrival[j], 
-				input_fastFall_slew[j], rise_load, output_fastRise_arrival, output_fastRise_slew );
-			gout_pin.SetFastDelayDataPtr(j, delay_ptr);
-
-			delay_ptr = new UnateDelayData();
-			delay_ptr->DelayFromInputRise = computeGateOutputFall( timing, input_slowRise_arrival[j], 
-				input_slowRise_slew[j], fall_load, output_slowFall_arrival, output_slowFall_slew );
-			delay_ptr->DelayFromInputFall = computeGateOutputRise( timing, input_slowFall_arrival[j], 
-				input_slowFall_slew[j], rise_load, output_slowRise_arrival, output_slowRise_slew );
-			gout_pin.SetSlowDelayDataPtr(j, delay_ptr);
-			break;
-		    }
-		case InputTimingTable::POSITIVE_UNATE:
-		    {
-			UnateDelayData *delay_ptr = new UnateDelayData();
-			delay_ptr->DelayFromInputFall = computeGateOutputFall( timing, input_fastFall_arrival[j], 
-				input_fastFall_slew[j], fall_load, output_fastFall_arrival, output_fastFall_slew );
-			delay_ptr->DelayFromInputRise = computeGateOutputRise( timing, input_fastRise_arrival[j], 
-				input_fastRise_slew[j], rise_load, output_fastRise_arrival, output_fastRise_slew );
-			gout_pin.SetFastDelayDataPtr(j, delay_ptr);
-
-			delay_ptr = new UnateDelayData();
-			delay_ptr->DelayFromInputFall = computeGateOutputFall( timing, input_slowFall_arrival[j], 
-				input_slowFall_slew[j], fall_load, output_slowFall_arrival, output_slowFall_slew );
-			delay_ptr->DelayFromInputRise = computeGateOutputRise( timing, input_slowRise_arrival[j], 
-				input_slowRise_slew[j], rise_load, output_slowRise_arrival, output_slowRise_slew );
-			gout_pin.SetSlowDelayDataPtr(j, delay_ptr);
-			break;
-		    }
-		case InputTimingTable::NON_UNATE:
-		    {
-			NonUnateDelayData *delay_ptr = new NonUnateDelayData();
-			delay_ptr->InputRiseOutputFallDelay = computeGateOutputFall( timing, input_fastRise_arrival[j], 
-				input_fastRise_slew[j], fall_load, output_fastFall_arrival, output_fastFall_slew );
-			delay_ptr->InputFallOutputRiseDelay = computeGateOutputRise( timing, input_fastFall_arrival[j], 
-				input_fastFall_slew[j], rise_load, output_fastRise_arrival, output_fastRise_slew );
-			delay_ptr->InputFallOutputFallDelay = computeGateOutputFall( timing, input_fastFall_arrival[j], 
-				input_fastFall_slew[j], fall_load, output_fastFall_arrival, output_fastFall_slew );
-			delay_ptr->InputRiseOutputRiseDelay = computeGateOutputRise( timing, input_fastRise_arrival[j], 
-				input_fastRise_slew[j], rise_load, output_fastRise_arrival, output_fastRise_slew );
-                        gout_pin.SetFastDelayDataPtr(j, delay_ptr);
-
-			delay_ptr = new NonUnateDelayData();
-			delay_ptr->InputRiseOutputFallDelay = computeGateOutputFall( timing, input_slowRise_arrival[j], 
-				input_slowRise_slew[j], fall_load, output_slowFall_arrival, output_slowFall_slew );
-			delay_ptr->InputFallOutputRiseDelay = computeGateOutputRise( timing, input_slowFall_arrival[j], 
-				input_slowFall_slew[j], rise_load, output_slowRise_arrival, output_slowRise_slew );
-			delay_ptr->InputFallOutputFallDelay = computeGateOutputFall( timing, input_slowFall_arrival[j], 
-				input_slowFall_slew[j], fall_load, output_slowFall_arrival, output_slowFall_slew );
-			delay_ptr->InputRiseOutputRiseDelay = computeGateOutputRise( timing, input_slowRise_arrival[j], 
-				input_slowRise_slew[j], rise_load, output_slowRise_arrival, output_slowRise_slew );
-                        gout_pin.SetSlowDelayDataPtr(j, delay_ptr);
-			break;
-		    }
-		default:
-		    assert(0);
-		    break;
-
-	    } // end switch
-	} // end input
-
-	assert( output_fastFall_arrival.size()>0 );
-	output_pnode.SetFastFallArrTime( *min_element(output_fastFall_arrival.begin(), output_fastFall_arrival.end()) ); 
-	output_pnode.SetFastFallSlew( *min_element(output_fastFall_slew.begin(), output_fastFall_slew.end()) );
-	output_pnode.SetFastRiseArrTime( *min_element(output_fastRise_arrival.begin(), output_fastRise_arrival.end()) );
-	output_pnode.SetFastRiseSlew( *min_element(output_fastRise_slew.begin(), output_fastRise_slew.end()) );
-	output_pnode.SetSlowFallArrTime( *max_element(output_slowFall_arrival.begin(), output_slowFall_arrival.end()) ); 
-	output_pnode.SetSlowFallSlew( *max_element(output_slowFall_slew.begin(), output_slowFall_slew.end()) );
-	output_pnode.SetSlowRiseArrTime( *max_element(output_slowRise_arrival.begin(), output_slowRise_arrival.end()) );
-	output_pnode.SetSlowRiseSlew( *max_element(output_slowRise_slew.begin(), output_slowRise_slew.end()) );
-
-	output_fastFall_arrival.clear();
-	output_fastRise_arrival.clear();
-	output_fastFall_slew.clear();
-	output_fastRise_slew.clear();
-	output_slowFall_arrival.clear();
-	output_slowRise_arrival.clear();
-	output_slowFall_slew.clear();
-	output_slowRise_slew.clear();
+	    const TimingStore::Split split = static_cast<TimingStore::Split>(s);
+	    store.SetArrTime( split, output_pnode_id, output_arrival[s] );
+	    store.SetSlew( split, output_pnode_id, output_slew[s] );
+	}
     } // end consider an output
 
     return;
 }
 
 // propagate a specified input pin signal to outputs, e.g., clock to Q and QN
-void propagateSignal( const unsigned &input_pin_id, Gate *gate_ptr )
+void propagateSignal( Circuit &circuit, const unsigned &input_pin_id, Gate *gate_ptr )
 {
     assert( gate_ptr->GetCellPtr() != NULL && !(gate_ptr->GetCellPtr()->GetIsNonClocked()) );
+    TimingStore &store = circuit.FetTimingStore();
     const Cell &cur_cell = *(gate_ptr->GetCellPtr());
     const vector<vector<InputTimingTable> > &timing_vec = cur_cell.FetInputTimingVec();
-    PinNode &cur_pnode = *(gate_ptr->GetInputPinNode(input_pin_id));
-
-    // use push back to insert due to non-uncate case
-    vector<double> output_fastFall_arrival, output_fastRise_arrival; // accumulated delay
-    vector<double> output_fastFall_slew, output_fastRise_slew;
-    vector<double> output_slowFall_arrival, output_slowRise_arrival; // accumulated delay
-    vector<double> output_slowFall_slew, output_slowRise_slew;
+    const unsigned input_id = gate_ptr->GetInputPinNode(input_pin_id)->GetId();
     const unsigned output_no = cur_cell.GetOutputPinNo();
+    const double input_fast_arrival[EDGE_NO] = {store.GetArrTime(TimingStore::FAST_FALL, input_id), store.GetArrTime(TimingStore::FAST_RISE, input_id)};
+    const double input_fast_slew[EDGE_NO] = {store.GetSlew(TimingStore::FAST_FALL, input_id), store.GetSlew(TimingStore::FAST_RISE, input_id)};
+    const double input_slow_arrival[EDGE_NO] = {store.GetArrTime(TimingStore::SLOW_FALL, input_id), store.GetArrTime(TimingStore::SLOW_RISE, input_id)};
+    const double input_slow_slew[EDGE_NO] = {store.GetSlew(TimingStore::SLOW_FALL, input_id), store.GetSlew(TimingStore::SLOW_RISE, input_id)};
 
     // consider every output 
     for( unsigned i=0; i<output_no; ++i )
@@ -228,104 +116,154 @@ void propagateSignal( const unsigned &input_pin_id, Gate *gate_ptr )
 	if( output_pnode.GetFanoutPtrNo() == 0 )
 	    continue;
 
-	const double fall_load = gate_ptr->GetOutputFallLoad(i);
-	const double rise_load = gate_ptr->GetOutputRiseLoad(i);
+	const double load[EDGE_NO] = {gate_ptr->GetOutputFallLoad(i), gate_ptr->GetOutputRiseLoad(i)};
 	const InputTimingTable &timing = timing_vec[input_pin_id][i];
+	double arc_delay[ArcDelayTable::NON_UNATE_SLOT_NO]; // not recorded
+
+	// running extrema over both transitions of a non-unate arc
+	double output_fast_arrival[EDGE_NO] = {getInitArrival<ArcDelayTable::FAST>(), getInitArrival<ArcDelayTable::FAST>()};
+	double output_fast_slew[EDGE_NO] = {getInitArrival<ArcDelayTable::FAST>(), getInitArrival<ArcDelayTable::FAST>()};
+	double output_slow_arrival[EDGE_NO] = {getInitArrival<ArcDelayTable::SLOW>(), getInitArrival<ArcDelayTable::SLOW>()};
+	double output_slow_slew[EDGE_NO] = {getInitArrival<ArcDelayTable::SLOW>(), getInitArrival<ArcDelayTable::SLOW>()};
 
 	if( timing.PinTimingSense == InputTimingTable::NON_UNATE )
 	{
-	    computeGateOutputFall( timing, cur_pnode.GetFastRiseArrTime(), cur_pnode.GetFastRiseSlew(), fall_load, 
-		                   output_fastFall_arrival, output_fastFall_slew );
-	    computeGateOutputRise( timing, cur_pnode.GetFastFallArrTime(), cur_pnode.GetFastFallSlew(), rise_load, 
-		                   output_fastRise_arrival, output_fastRise_slew );
-
-	    computeGateOutputFall( timing, cur_pnode.GetSlowRiseArrTime(), cur_pnode.GetSlowRiseSlew(), fall_load, 
-		                   output_slowFall_arrival, output_slowFall_slew );
-	    computeGateOutputRise( timing, cur_pnode.GetSlowFallArrTime(), cur_pnode.GetSlowFallSlew(), rise_load, 
-		                   output_slowRise_arrival, output_slowRise_slew );
-
-	    computeGateOutputFall( timing, cur_pnode.GetFastFallArrTime(), cur_pnode.GetFastFallSlew(), fall_load, 
-		                   output_fastFall_arrival, output_fastFall_slew );
-	    computeGateOutputRise( timing, cur_pnode.GetFastRiseArrTime(), cur_pnode.GetFastRiseSlew(), rise_load, 
-		                   output_fastRise_arrival, output_fastRise_slew );
-
-	    computeGateOutputFall( timing, cur_pnode.GetSlowFallArrTime(), cur_pnode.GetSlowFallSlew(), fall_load, 
-		                   output_slowFall_arrival, output_slowFall_slew );
-	    computeGateOutputRise( timing, cur_pnode.GetSlowRiseArrTime(), cur_pnode.GetSlowRiseSlew(), rise_load, 
-		                   output_slowRise_arrival, output_slowRise_slew );
+	    propagateArc<InputTimingTable::NON_UNATE, ArcDelayTable::FAST>( timing, input_fast_arrival, input_fast_slew, load, 
+		                                                            arc_delay, output_fast_arrival, output_fast_slew );
+	    propagateArc<InputTimingTable::NON_UNATE, ArcDelayTable::SLOW>( timing, input_slow_arrival, input_slow_slew, load, 
+		                                                            arc_delay, output_slow_arrival, output_slow_slew );
 	}
 	else if( timing.PinTimingSense == InputTimingTable::NEGATIVE_UNATE )
 	{
-	    computeGateOutputFall( timing, cur_pnode.GetFastRiseArrTime(), cur_pnode.GetFastRiseSlew(), fall_load, 
-		                   output_fastFall_arrival, output_fastFall_slew );
-	    computeGateOutputRise( timing, cur_pnode.GetFastFallArrTime(), cur_pnode.GetFastFallSlew(), rise_load, 
-		                   output_fastRise_arrival, output_fastRise_slew );
-
-	    computeGateOutputFall( timing, cur_pnode.GetSlowRiseArrTime(), cur_pnode.GetSlowRiseSlew(), fall_load, 
-		                   output_slowFall_arrival, output_slowFall_slew );
-	    computeGateOutputRise( timing, cur_pnode.GetSlowFallArrTime(), cur_pnode.GetSlowFallSlew(), rise_load, 
-		                   output_slowRise_arrival, output_slowRise_slew );
+	    propagateArc<InputTimingTable::NEGATIVE_UNATE, ArcDelayTable::FAST>( timing, input_fast_arrival, input_fast_slew, load, 
+		                                                                 arc_delay, output_fast_arrival, output_fast_slew );
+	    propagateArc<InputTimingTable::NEGATIVE_UNATE, ArcDelayTable::SLOW>( timing, input_slow_arrival, input_slow_slew, load, 
+		                                                                 arc_delay, output_slow_arrival, output_slow_slew );
 	}
 	else
 	{
 	    assert( timing.PinTimingSense == InputTimingTable::POSITIVE_UNATE );
-	    computeGateOutputFall( timing, cur_pnode.GetFastFallArrTime(), cur_pnode.GetFastFallSlew(), fall_load, 
-		                   output_fastFall_arrival, output_fastFall_slew );
-	    computeGateOutputRise( timing, cur_pnode.GetFastRiseArrTime(), cur_pnode.GetFastRiseSlew(), rise_load, 
-		                   output_fastRise_arrival, output_fastRise_slew );
-
-	    computeGateOutputFall( timing, cur_pnode.GetSlowFallArrTime(), cur_pnode.GetSlowFallSlew(), fall_load, 
-		                   output_slowFall_arrival, output_slowFall_slew );
-	    computeGateOutputRise( timing, cur_pnode.GetSlowRiseArrTime(), cur_pnode.GetSlowRiseSlew(), rise_load, 
-		                   output_slowRise_arrival, output_slowRise_slew );
+	    propagateArc<InputTimingTable::POSITIVE_UNATE, ArcDelayTable::FAST>( timing, input_fast_arrival, input_fast_slew, load, 
+		                                                                 arc_delay, output_fast_arrival, output_fast_slew );
+	    propagateArc<InputTimingTable::POSITIVE_UNATE, ArcDelayTable::SLOW>( timing, input_slow_arrival, input_slow_slew, load, 
+		                                                                 arc_delay, output_slow_arrival, output_slow_slew );
 	}
 
-	assert( output_fastFall_arrival.size()>0 ); // at least one input has a signal
-	output_pnode.SetFastFallArrTime( *min_element(output_fastFall_arrival.begin(), output_fastFall_arrival.end()) ); 
-	output_pnode.SetFastFallSlew( *min_element(output_fastFall_slew.begin(), output_fastFall_slew.end()) );
-	output_pnode.SetFastRiseArrTime( *min_element(output_fastRise_arrival.begin(), output_fastRise_arrival.end()) );
-	output_pnode.SetFastRiseSlew( *min_element(output_fastRise_slew.begin(), output_fastRise_slew.end()) );
-	output_pnode.SetSlowFallArrTime( *max_element(output_slowFall_arrival.begin(), output_slowFall_arrival.end()) ); 
-	output_pnode.SetSlowFallSlew( *max_element(output_slowFall_slew.begin(), output_slowFall_slew.end()) );
-	output_pnode.SetSlowRiseArrTime( *max_element(output_slowRise_arrival.begin(), output_slowRise_arrival.end()) );
-	output_pnode.SetSlowRiseSlew( *max_element(output_slowRise_slew.begin(), output_slowRise_slew.end()) );
-
-	output_fastFall_arrival.clear();
-	output_fastRise_arrival.clear();
-	output_fastFall_slew.clear();
-	output_fastRise_slew.clear();
-	output_slowFall_arrival.clear();
-	output_slowRise_arrival.clear();
-	output_slowFall_slew.clear();
-	output_slowRise_slew.clear();
+	const unsigned output_id = output_pnode.GetId();
+	store.SetArrTime( TimingStore::FAST_FALL, output_id, output_fast_arrival[FALL] );
+	store.SetSlew( TimingStore::FAST_FALL, output_id, output_fast_slew[FALL] );
+	store.SetArrTime( TimingStore::FAST_RISE, output_id, output_fast_arrival[RISE] );
+	store.SetSlew( TimingStore::FAST_RISE, output_id, output_fast_slew[RISE] );
+	store.SetArrTime( TimingStore::SLOW_FALL, output_id, output_slow_arrival[FALL] );
+	store.SetSlew( TimingStore::SLOW_FALL, output_id, output_slow_slew[FALL] );
+	store.SetArrTime( TimingStore::SLOW_RISE, output_id, output_slow_arrival[RISE] );
+	store.SetSlew( TimingStore::SLOW_RISE, output_id, output_slow_slew[RISE] );
     } // end consider an output
  
     return;
 }
 
+// every tap driving a gate input pin gets the arrival time plus wire delay, and the slew degraded by the wire
+void propagateWireSignal( Circuit &circuit, const unsigned &root_id )
+{
+    const TimingGraph &graph = circuit.GetTimingGraph();
+    TimingStore &store = circuit.FetTimingStore();
+    const bool is_avx2 = getIsAvx2KernelOn();
+    double root_arrival[TimingStore::SPLIT_NO], root_slew_sq[TimingStore::SPLIT_NO];
+
+    for( unsigned s=0; s<TimingStore::SPLIT_NO; ++s )
+    {
+	root_arrival[s] = store.GetArrTime( static_cast<TimingStore::Split>(s), root_id );
+	root_slew_sq[s] = store.GetSlew( static_cast<TimingStore::Split>(s), root_id ) * store.GetSlew( static_cast<TimingStore::Split>(s), root_id );
+    }
+
+    for( unsigned i=graph.GetFanoutBegin(root_id); i<graph.GetFanoutEnd(root_id); ++i )
+    {
+	const unsigned fanout = graph.GetFanout(i);
+
+	if( TimingGraph::GetKind(fanout) != TimingGraph::PIN_NODE )
+	    continue;
+
+	const unsigned tap_id = TimingGraph::GetHandleId(fanout);
+
+	if( graph.GetTapInputId(tap_id) == TimingGraph::NO_ID ) // very special case
+	    continue;
+
+	assert( graph.GetFanoutNo(tap_id) == 1 );
+	const double wire_delay[EDGE_NO] = {graph.GetWireFallDelay(tap_id), graph.GetWireRiseDelay(tap_id)};
+	const double slew_hat_sq[EDGE_NO] = {graph.GetFallSlewHatSq(tap_id), graph.GetRiseSlewHatSq(tap_id)};
+	double tap_arrival[TimingStore::SPLIT_NO], tap_slew[TimingStore::SPLIT_NO];
+
+	if( is_avx2 )
+	    propagateWireAvx2( root_arrival, root_slew_sq, wire_delay, slew_hat_sq, tap_arrival, tap_slew );
+	else
+	    propagateWireLanes( root_arrival, root_slew_sq, wire_delay, slew_hat_sq, tap_arrival, tap_slew );
+
+	for( unsigned s=0; s<TimingStore::SPLIT_NO; ++s )
+	{
+	    store.SetArrTime( static_cast<TimingStore::Split>(s), tap_id, tap_arrival[s] );
+	    store.SetSlew( static_cast<TimingStore::Split>(s), tap_id, tap_slew[s] );
+	}
+    }
+
+    return;
+}
+
+// a step of parallel forward STA; flip-flops only propagate wires, since clock signals reach their outputs before
+void propagateGateSignal( Circuit &circuit, const unsigned &gate_id )
+{
+    const TimingGraph &graph = circuit.GetTimingGraph();
+    Gate *gate_ptr = graph.GetGatePtr(gate_id);
+
+    if( gate_ptr->GetCellPtr() != NULL && gate_ptr->GetIsNonClocked() ) // not PI, PO or flip-flop
+	propagateSignal( circuit, gate_id );
+
+    for( unsigned i=graph.GetOutputBegin(gate_id); i<graph.GetOutputEnd(gate_id); ++i )
+	if( graph.GetOutputPinNodeId(i) != TimingGraph::NO_ID )
+	    propagateWireSignal( circuit, graph.GetOutputPinNodeId(i) );
+
+    return;
+}
+
 //-----------------------------------------------------------------------
 //    Define auxiliary functions 
 //-----------------------------------------------------------------------
 
-// compute gate output signal falling information to output_arrival and output_slew
-double computeGateOutputFall( const InputTimingTable &timing, const double &input_arrival, const double &input_slew, const double &load, vector<double> &output_arrival, vector<double> &output_slew )
+template<InputTimingTable::TimingSense SENSE>
+void propagateSenseArcs( const TimingGraph &graph, TimingStore &store, ArcDelayTable &delay_table, const Cell &cur_cell, 
+	                 const unsigned &gate_id, const unsigned &output_pin_id, const double load[], const bool &is_avx2, 
+			 double output_arrival[], double output_slew[] )
 {
-    double gate_delay = timing.FallDelayA + timing.FallDelayB * load + timing.FallDelayC * input_slew;
+    const vector<vector<InputTimingTable> > &timing_vec = cur_cell.FetInputTimingVec();
+    const vector<unsigned> &input_pin_id_vec = cur_cell.FetSenseInputIdVec(output_pin_id, SENSE);
+    const unsigned output_id = graph.GetOutputBegin(gate_id) + output_pin_id;
+    double *fast_delay_arr = delay_table.FetDelayArray(ArcDelayTable::FAST);
+    double *slow_delay_arr = delay_table.FetDelayArray(ArcDelayTable::SLOW);
 
-    output_arrival.push_back( input_arrival + gate_delay );
-    output_slew.push_back( timing.FallSlewX + timing.FallSlewY * load + timing.FallSlewZ * input_slew );
+    for( unsigned k=0; k<input_pin_id_vec.size(); ++k )
+    {
+	const unsigned j = input_pin_id_vec[k];
+	const unsigned input_pnode_id = graph.GetInputPinNodeId( graph.GetInputBegin(gate_id)+j );
 
-    return gate_delay;
-}
+	if( input_pnode_id == TimingGraph::NO_ID || graph.GetFanin(input_pnode_id) == TimingGraph::NO_ID )
+	    continue;
 
-// compute gate output signal rising information to output_arrival and output_slew 
-double computeGateOutputRise( const InputTimingTable &timing, const double &input_arrival, const double &input_slew, const double &load, vector<double> &output_arrival, vector<double> &output_slew )
-{
-    double gate_delay = timing.RiseDelayA + timing.RiseDelayB * load + timing.RiseDelayC * input_slew;
+	double input_arrival[TimingStore::SPLIT_NO], input_slew[TimingStore::SPLIT_NO];
 
-    output_arrival.push_back( input_arrival + gate_delay );
-    output_slew.push_back( timing.RiseSlewX + timing.RiseSlewY * load + timing.RiseSlewZ * input_slew );
+	for( unsigned s=0; s<TimingStore::SPLIT_NO; ++s )
+	{
+	    input_arrival[s] = store.GetArrTime( static_cast<TimingStore::Split>(s), input_pnode_id );
+	    input_slew[s] = store.GetSlew( static_cast<TimingStore::Split>(s), input_pnode_id );
+	}
 
-    return gate_delay;
-}
+	const InputTimingTable &timing = timing_vec[j][output_pin_id];
+	const unsigned slot = delay_table.GetSlot(output_id, j);
 
+	if( is_avx2 )
+	    propagateArcAvx2<SENSE>( timing, input_arrival, input_slew, load, fast_delay_arr+slot, slow_delay_arr+slot, output_arrival, output_slew );
+	else
+	    propagateArcLanes<SENSE>( timing, input_arrival, input_slew, load, fast_delay_arr+slot, slow_delay_arr+slot, output_arrival, output_slew );
+    }
+
+    return;
+}
@@ -2,6 +2,7 @@
 #include <cassert>
 #include <cmath>
 #include <cstdio>
+#include <limits>
 #include <list>
 #include <queue>
 #include <vector>
@@ -9,6 +10,7 @@
 #include "Circuit.h"
 #include "Gate.h"
 #include "PinNode.h"
+#include "TimingStore.h"
 #include "process.h"
 
 using namespace std;
@@ -21,13 +23,15 @@ bool areAllComGatesInputNonTraversed( const Circuit &circuit ); // check-only
 
 bool areAllComGatesInputTraversed( const Circuit &circuit );    // check-only
 
-bool areOutputsReached( GOutPin& gout_pin );
+bool areOutputsReached( const TimingGraph &graph, const unsigned &gate_id );
 
-void injectPOsRATData( Circuit &circuit, queue<Gate*> &waited_queue );
+void injectPOsRATData( Circuit &circuit, queue<unsigned> &waited_queue );
+
+void notifyDrivingGate( const TimingGraph &graph, const unsigned &output_id, queue<unsigned> &waited_queue );
 
 void runComBackwardSlowSTA( const RATData &rat_data, Circuit &circuit );
 
-void visitAndNotifyDrivingGate( PinNode &cur_pnode, queue<Gate*> &waited_queue );
+void visitAndNotifyDrivingGate( Circuit &circuit, const unsigned &pnode_id, queue<unsigned> &waited_queue );
 
 //-----------------------------------------------------------------------
 //    Define main functions
@@ -35,71 +39,75 @@ void visitAndNotifyDrivingGate( PinNode &cur_pnode, queue<Gate*> &waited_queue )
 
 void runComBackwardSTA( Circuit &circuit )
 {
-    queue<Gate*> waited_queue;
+    const TimingGraph &graph = circuit.GetTimingGraph();
+    TimingStore &store = circuit.FetTimingStore();
+    const double inf = numeric_limits<double>::infinity();
+    queue<unsigned> waited_queue; // gate ids
 
     injectPOsRATData( circuit, waited_queue ); // inject PO to let propagation
 
     while( !waited_queue.empty() )
     {
-	Gate &cur_gate = *(waited_queue.front());
+	const unsigned cur_gate_id = waited_queue.front();
+	Gate &cur_gate = *(graph.GetGatePtr(cur_gate_id));
 	waited_queue.pop();
 
-        for( unsigned i=0; i<cur_gate.GetOutputNo(); ++i )
+        for( unsigned i=graph.GetOutputBegin(cur_gate_id); i<graph.GetOutputEnd(cur_gate_id); ++i )
 	{
-	    if( cur_gate.GetOutputPinNode(i) == NULL )
+	    const unsigned cur_id = graph.GetOutputPinNodeId(i);
+
+	    if( cur_id == TimingGraph::NO_ID )
 		continue;
 
-	    PinNode &cur_pnode = *(cur_gate.GetOutputPinNode(i));
-	    const unsigned fanout_no = cur_pnode.GetFanoutNo();
-	    vector<double> cur_fastFall_ratime, cur_fastRise_ratime, cur_slowFall_ratime, cur_slowRise_ratime;
-	    cur_fastFall_ratime.reserve( fanout_no );
-	    cur_fastRise_ratime.reserve( fanout_no );
-	    cur_slowFall_ratime.reserve( fanout_no );
-	    cur_slowRise_ratime.reserve( fanout_no );
+	    PinNode &cur_pnode = *(circuit.GetPinNodePtr(cur_id));
+	    bool has_driven_tap = false;
 
-	    for( unsigned j=0; j<fanout_no; ++j )
+	    // running extrema over all driven taps: max in early mode, min in late mode
+	    double cur_fastFall_ratime = -inf, cur_fastRise_ratime = -inf;
+	    double cur_slowFall_ratime = inf, cur_slowRise_ratime = inf;
+
+	    for( unsigned j=graph.GetFanoutBegin(cur_id); j<graph.GetFanoutEnd(cur_id); ++j )
 	    {
-		Element *driven_ptr = cur_pnode.GetFanoutPtr(j);
+		const unsigned fanout = graph.GetFanout(j);
 
-		if( driven_ptr->GetType() == Element::GIN_PIN )
+		if( TimingGraph::GetKind(fanout) != TimingGraph::PIN_NODE )
 		    continue;
 
-		PinNode &driven_pnode = *(static_cast<PinNode*>(driven_ptr));
+		const unsigned driven_id = TimingGraph::GetHandleId(fanout);
 
-		if( driven_pnode.GetFanoutPtrNo() == 0 )
+		if( graph.GetTapInputId(driven_id) == TimingGraph::NO_ID )
 		    continue;
 
-                assert( (driven_pnode.GetFanoutPtr(0))->GetType() == Element::GIN_PIN );
-		GInPin &driven_gin_pin = *(static_cast<GInPin*>(driven_pnode.GetFanoutPtr(0)));
-		cur_fastFall_ratime.push_back( driven_pnode.GetFastFallReqTime() - driven_gin_pin.GetFallArrDelay() );
-		cur_fastRise_ratime.push_back( driven_pnode.GetFastRiseReqTime() - driven_gin_pin.GetRiseArrDelay() );
-                cur_slowFall_ratime.push_back( driven_pnode.GetSlowFallReqTime() - driven_gin_pin.GetFallArrDelay() );
-		cur_slowRise_ratime.push_back( driven_pnode.GetSlowRiseReqTime() - driven_gin_pin.GetRiseArrDelay() );
+		has_driven_tap = true;
+		cur_fastFall_ratime = max( cur_fastFall_ratime, store.GetReqTime(TimingStore::FAST_FALL, driven_id) - graph.GetWireFallDelay(driven_id) );
+		cur_fastRise_ratime = max( cur_fastRise_ratime, store.GetReqTime(TimingStore::FAST_RISE, driven_id) - graph.GetWireRiseDelay(driven_id) );
+                cur_slowFall_ratime = min( cur_slowFall_ratime, store.GetReqTime(TimingStore::SLOW_FALL, driven_id) - graph.GetWireFallDelay(driven_id) );
+		cur_slowRise_ratime = min( cur_slowRise_ratime, store.GetReqTime(TimingStore::SLOW_RISE, driven_id) - graph.GetWireRiseDelay(driven_id) );
 	    }
 
 	    cur_pnode.SetIsVisited();
 
-	    if( cur_fastFall_ratime.size() > 0 )
+	    if( has_driven_tap )
 	    {
-		cur_pnode.SetFastFallReqTime( *max_element(cur_fastFall_ratime.begin(), cur_fastFall_ratime.end()) );
-		cur_pnode.SetFastRiseReqTime( *max_element(cur_fastRise_ratime.begin(), cur_fastRise_ratime.end()) );
-		cur_pnode.SetSlowFallReqTime( *min_element(cur_slowFall_ratime.begin(), cur_slowFall_ratime.end()) );
-		cur_pnode.SetSlowRiseReqTime( *min_element(cur_slowRise_ratime.begin(), cur_slowRise_ratime.end()) );
+		store.TightenReqTime( TimingStore::FAST_FALL, cur_id, cur_fastFall_ratime );
+		store.TightenReqTime( TimingStore::FAST_RISE, cur_id, cur_fastRise_ratime );
+		store.TightenReqTime( TimingStore::SLOW_FALL, cur_id, cur_slowFall_ratime );
+		store.TightenReqTime( TimingStore::SLOW_RISE, cur_id, cur_slowRise_ratime );
 	    }
 	}
 
 	if( cur_gate.GetCellPtr() != NULL ) // not PI
 	{
-	    backtraceSignal( cur_gate );
+	    backtraceSignal( circuit, cur_gate_id );
 
-	    for( unsigned i=0; i<cur_gate.GetInputNo(); ++i )
+	    for( unsigned i=graph.GetInputBegin(cur_gate_id); i<graph.GetInputEnd(cur_gate_id); ++i )
 	    {
-		assert( cur_gate.GetInputPinNode(i) != NULL );
+		assert( graph.GetInputPinNodeId(i) != TimingGraph::NO_ID );
 
-                if( cur_gate.GetInputPinNode(i) == NULL )
+                if( graph.GetInputPinNodeId(i) == TimingGraph::NO_ID )
 		    continue;
 
-                visitAndNotifyDrivingGate( *(cur_gate.GetInputPinNode(i)), waited_queue );
+                visitAndNotifyDrivingGate( circuit, graph.GetInputPinNodeId(i), waited_queue );
 	    }
 	}
     }
@@ -113,63 +121,38 @@ void runComForwardSTA( Circuit &circuit )
     assert( !circuit.GetIsSequential() ); // for combinational circuit only now
     assert( areAllComGatesInputNonTraversed(circuit) );
 
-    vector<Gate*> waited_queue;
-    waited_queue.reserve( circuit.GetTotGateNo() );
+    const TimingGraph &graph = circuit.GetTimingGraph();
+    vector<unsigned> waited_queue; // gate ids
+    waited_queue.reserve( graph.GetGateNo() );
 
     // insert primary inputs into queue
-    for( unsigned i=0; i<circuit.GetPINo(); ++i )
-	waited_queue.push_back( circuit.GetPIPtr(i) );
+    for( unsigned i=0; i<graph.GetPINo(); ++i )
+	waited_queue.push_back( i );
 
     for( unsigned i=0; i<waited_queue.size(); ++i )
     {
-	Gate &cur_gate = *(waited_queue[i]);
+	const unsigned cur_gate_id = waited_queue[i];
 
-	for( unsigned j=0; j<cur_gate.GetOutputNo(); ++j )
+	for( unsigned j=graph.GetOutputBegin(cur_gate_id); j<graph.GetOutputEnd(cur_gate_id); ++j )
 	{
-	    if( cur_gate.GetOutputPinNode(j) == NULL )
+	    const unsigned cur_id = graph.GetOutputPinNodeId(j);
+
+	    if( cur_id == TimingGraph::NO_ID )
 		continue;
 
-            PinNode &cur_pnode = *(cur_gate.GetOutputPinNode(j));
-	    const double output_fast_fall_slew_sq = cur_pnode.GetFastFallSlew() * cur_pnode.GetFastFallSlew();
-	    const double output_fast_rise_slew_sq = cur_pnode.GetFastRiseSlew() * cur_pnode.GetFastRiseSlew();
-	    const double output_slow_fall_slew_sq = cur_pnode.GetSlowFallSlew() * cur_pnode.GetSlowFallSlew();
-	    const double output_slow_rise_slew_sq = cur_pnode.GetSlowRiseSlew() * cur_pnode.GetSlowRiseSlew();
+	    propagateWireSignal( circuit, cur_id ); // taps first, then gates they reach
 
-	    for( unsigned k=0; k<cur_pnode.GetFanoutNo(); ++k )
+	    for( unsigned k=graph.GetFanoutBegin(cur_id); k<graph.GetFanoutEnd(cur_id); ++k )
 	    {
-                Gate *driven_gate_ptr;
-		assert( (cur_pnode.GetFanoutPtr(k))->GetType() == Element::PIN_NODE || 
-			(cur_pnode.GetFanoutPtr(k))->GetType() == Element::GIN_PIN );
-
-		if( (cur_pnode.GetFanoutPtr(k))->GetType() == Element::PIN_NODE )
-		{
-		    PinNode &driven_pnode = *(static_cast<PinNode*>(cur_pnode.GetFanoutPtr(k)));
-
-		    if( driven_pnode.GetFanoutPtrNo() == 0 ) // very special case
-			continue;
+		const unsigned fanout = graph.GetFanout(k);
+		const unsigned driven_input_id = (TimingGraph::GetKind(fanout) == TimingGraph::PIN_NODE)? 
+		                                 graph.GetTapInputId(TimingGraph::GetHandleId(fanout)): TimingGraph::GetHandleId(fanout);
 
-		    assert( (driven_pnode.GetFanoutPtr(0))->GetType() == Element::GIN_PIN );
-		    const GInPin &gin_pin = *(static_cast<GInPin*>(driven_pnode.GetFanoutPtr(0)));
-		    const double wire_fall_delay = gin_pin.GetFallArrDelay();
-		    const double wire_rise_delay = gin_pin.GetRiseArrDelay();
-
-		    driven_pnode.SetFastFallArrTime( cur_pnode.GetFastFallArrTime() + wire_fall_delay );
-		    driven_pnode.SetFastRiseArrTime( cur_pnode.GetFastRiseArrTime() + wire_rise_delay );
-		    driven_pnode.SetFastFallSlew( sqrt( output_fast_fall_slew_sq + driven_pnode.GetFallSlewHatSq() ) );
-		    driven_pnode.SetFastRiseSlew( sqrt( output_fast_rise_slew_sq + driven_pnode.GetRiseSlewHatSq() ) );
-
-		    driven_pnode.SetSlowFallArrTime( cur_pnode.GetSlowFallArrTime() + wire_fall_delay );
-		    driven_pnode.SetSlowRiseArrTime( cur_pnode.GetSlowRiseArrTime() + wire_rise_delay );
-		    driven_pnode.SetSlowFallSlew( sqrt( output_slow_fall_slew_sq + driven_pnode.GetFallSlewHatSq() ) );
-		    driven_pnode.SetSlowRiseSlew( sqrt( output_slow_rise_slew_sq + driven_pnode.GetRiseSlewHatSq() ) );
-
-		    assert( driven_pnode.GetFanoutNo() == 1 );
-		    assert( (driven_pnode.GetFanoutPtr(0))->GetType() == Element::GIN_PIN );
-		    driven_gate_ptr = (static_cast<GInPin*>(driven_pnode.GetFanoutPtr(0)))->GetGatePtr();
-		}
-		else
-		    driven_gate_ptr = (static_cast<GInPin*>(cur_pnode.GetFanoutPtr(k)))->GetGatePtr();
+		if( driven_input_id == TimingGraph::NO_ID ) // very special case
+		    continue;
 
+		const unsigned driven_gate_id = graph.GetInputGateId(driven_input_id);
+		Gate *driven_gate_ptr = graph.GetGatePtr(driven_gate_id);
 		driven_gate_ptr->IncInputVisitedCount();
 		assert( driven_gate_ptr->GetInputVisitedCount() <= driven_gate_ptr->GetInputNo() );
 
@@ -178,11 +161,11 @@ void runComForwardSTA( Circuit &circuit )
 		{
 		    if( driven_gate_ptr->GetCellPtr() != NULL ) // not PO
 		    {
-			waited_queue.push_back( driven_gate_ptr );
-			propagateSignal( driven_gate_ptr ); // propagate signal through this gate
+			waited_queue.push_back( driven_gate_id );
+			propagateSignal( circuit, driven_gate_id ); // propagate signal through this gate
 		    }
 		}
-	    } // end fanout consideration 
+	    } // end fanout consideration
 	}
     }
 
@@ -221,64 +204,52 @@ bool areAllComGatesInputTraversed( const Circuit &circuit )
     return true;
 }
 
-bool areOutputsReached( GOutPin& gout_pin )
+// true if every driven gate input pin of every output of the gate has been visited
+bool areOutputsReached( const TimingGraph &graph, const unsigned &gate_id )
 {
-    if( gout_pin.GetVisitedCount() < (gout_pin.GetFanoutPtr())->GetFanoutNo() )
-	return false;
-
-    Gate &cur_gate = *(gout_pin.GetGatePtr());
-
-    for( unsigned i=0; i<cur_gate.GetOutputNo(); ++i )
+    for( unsigned i=graph.GetOutputBegin(gate_id); i<graph.GetOutputEnd(gate_id); ++i )
     {
-	GOutPin &curGout_pin = cur_gate.FetGOutPin(i);
+	const unsigned pnode_id = graph.GetOutputPinNodeId(i);
 
-	if( curGout_pin.GetFanoutPtr() == NULL )
+	if( pnode_id == TimingGraph::NO_ID )
 	    continue;
 
-	if( curGout_pin.GetVisitedCount() < (curGout_pin.GetFanoutPtr())->GetFanoutNo() )
+	if( graph.FetGOutPin(i).GetVisitedCount() < graph.GetFanoutNo(pnode_id) )
 	    return false;
     }
 
     return true;
 }
 
-void injectPOsRATData( Circuit &circuit, queue<Gate*> &waited_queue )
+void injectPOsRATData( Circuit &circuit, queue<unsigned> &waited_queue )
 {
-    vector<Gate*> &po_ptr_vec = circuit.FetPOPtrVec();
+    const TimingGraph &graph = circuit.GetTimingGraph();
 
-    for( unsigned i=0; i<po_ptr_vec.size(); ++i )
+    for( unsigned i=graph.GetFirstPOId(); i<graph.GetFirstPOId()+graph.GetPONo(); ++i )
     {
-	Gate* cur_gate = po_ptr_vec[i];
-	assert( cur_gate->GetInputNo() == 1 && cur_gate->GetInputPinNode(0) != NULL );
-	PinNode &cur_pnode = *(cur_gate->GetInputPinNode(0));
+	assert( graph.GetInputEnd(i) == graph.GetInputBegin(i)+1 );
+	const unsigned cur_id = graph.GetInputPinNodeId( graph.GetInputBegin(i) );
+	assert( cur_id != TimingGraph::NO_ID );
+	PinNode &cur_pnode = *(circuit.GetPinNodePtr(cur_id));
 	const bool is_not_visited = cur_pnode.GetIsNotVisited();
 	cur_pnode.SetIsVisited();
+	const unsigned fanin = graph.GetFanin(cur_id);
 
-	if( cur_pnode.GetFaninPtr() != NULL )
+	if( fanin != TimingGraph::NO_ID )
 	{
-	    GOutPin *gout_pin=NULL;
-
-	    if( (cur_pnode.GetFaninPtr())->GetType() == Element::PIN_NODE )
+	    if( TimingGraph::GetKind(fanin) == TimingGraph::PIN_NODE )
 	    {
 		if( is_not_visited )
 		{
-		    PinNode *tmp_ptr = static_cast<PinNode*>(cur_pnode.GetFaninPtr());
-		    assert( tmp_ptr->GetFaninPtr()->GetType() == Element::GOUT_PIN );
-		    gout_pin = static_cast<GOutPin*>(tmp_ptr->GetFaninPtr());
-		    gout_pin->IncVisitedCount();
-
-		    if( areOutputsReached( *gout_pin ) )
-			waited_queue.push( gout_pin->GetGatePtr() );
+		    const unsigned root_fanin = graph.GetFanin( TimingGraph::GetHandleId(fanin) );
+		    assert( root_fanin != TimingGraph::NO_ID && TimingGraph::GetKind(root_fanin) == TimingGraph::GATE_OUTPUT );
+		    notifyDrivingGate( graph, TimingGraph::GetHandleId(root_fanin), waited_queue );
 		}
 	    }
 	    else
 	    {
-		assert( (cur_pnode.GetFaninPtr())->GetType() == Element::GOUT_PIN );
-		gout_pin = static_cast<GOutPin*>(cur_pnode.GetFaninPtr());
-		gout_pin->IncVisitedCount();
-
-		if( areOutputsReached( *gout_pin ) )
-		    waited_queue.push( gout_pin->GetGatePtr() );
+		assert( TimingGraph::GetKind(fanin) == TimingGraph::GATE_OUTPUT );
+		notifyDrivingGate( graph, TimingGraph::GetHandleId(fanin), waited_queue );
 	    }
 	}
     }
@@ -286,45 +257,51 @@ void injectPOsRATData( Circuit &circuit, queue<Gate*> &waited_queue )
     return;
 }
 
-void visitAndNotifyDrivingGate( PinNode &cur_pnode, queue<Gate*> &waited_queue )
+// one more driven gate input pin of the gate output pin is visited
+inline void notifyDrivingGate( const TimingGraph &graph, const unsigned &output_id, queue<unsigned> &waited_queue )
 {
+    graph.FetGOutPin(output_id).IncVisitedCount();
+    const unsigned gate_id = graph.GetOutputGateId(output_id);
+
+    if( areOutputsReached( graph, gate_id ) )
+	waited_queue.push( gate_id );
+
+    return;
+}
+
+void visitAndNotifyDrivingGate( Circuit &circuit, const unsigned &pnode_id, queue<unsigned> &waited_queue )
+{
+    const TimingGraph &graph = circuit.GetTimingGraph();
+    PinNode &cur_pnode = *(circuit.GetPinNodePtr(pnode_id));
     const bool non_visited = cur_pnode.GetIsNotVisited();
     cur_pnode.SetIsVisited();
-    Element *fanin_ptr = cur_pnode.GetFaninPtr();
+    const unsigned fanin = graph.GetFanin(pnode_id);
 
-    if( fanin_ptr == NULL )
+    if( fanin == TimingGraph::NO_ID )
 	return;
 
-    if( fanin_ptr->GetType() == Element::PIN_NODE )
+    if( TimingGraph::GetKind(fanin) == TimingGraph::PIN_NODE )
     {
 	if( non_visited )
 	{
-	    PinNode *tmp_ptr = static_cast<PinNode*>(fanin_ptr);
+	    const unsigned root_id = TimingGraph::GetHandleId(fanin);
+	    const unsigned root_fanin = graph.GetFanin(root_id);
 
-	    if( tmp_ptr->GetFaninPtr() == NULL ) // very special case
+	    if( root_fanin == TimingGraph::NO_ID ) // very special case
 	    {
-		(*tmp_ptr).SetIsVisited();
+		circuit.GetPinNodePtr(root_id)->SetIsVisited();
 		return;
 	    }
 
-	    assert( tmp_ptr->GetFaninPtr()->GetType() == Element::GOUT_PIN );
-	    GOutPin &gout_pin = *(static_cast<GOutPin*>(tmp_ptr->GetFaninPtr()));
-	    gout_pin.IncVisitedCount();
-
-	    if( areOutputsReached( gout_pin ) )
-		waited_queue.push( gout_pin.GetGatePtr() );
+	    assert( TimingGraph::GetKind(root_fanin) == TimingGraph::GATE_OUTPUT );
+	    notifyDrivingGate( graph, TimingGraph::GetHandleId(root_fanin), waited_queue );
 	}
     }
     else
     {
-	assert( fanin_ptr->GetType() == Element::GOUT_PIN );
-	GOutPin &gout_pin = *(static_cast<GOutPin*>(fanin_ptr));
-	gout_pin.IncVisitedCount();
-
-	if( areOutputsReached( gout_pin ) )
-	    waited_queue.push( gout_pin.GetGatePtr() );
+	assert( TimingGraph::GetKind(fanin) == TimingGraph::GATE_OUTPUT );
+	notifyDrivingGate( graph, TimingGraph::GetHandleId(fanin), waited_queue );
     }
 
     return;
 }
-
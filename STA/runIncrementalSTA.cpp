@@ -0,0 +1,350 @@
+/************************************************************************
+ *   Perform incremental STA after some gates change, e.g., their cells
+ *   are swapped, so that their arcs and the loads of the gates driving
+ *   them change, or after the parasitics of some wires change, so that
+ *   their wire delays and slew hats change, but the connectivity does not.
+ *
+ *   Forward STA re-propagates the changed gates in the order of levels
+ *   by a min-heap. A gate pushes the gates reached by an output wire
+ *   only if an arrival time or slew of the output changes by more than
+ *   a tolerance, so propagation stops where the old values come back.
+ *   A changed wire is propagated again first, and pushes its gates.
+ *
+ *   Backward STA then rebuilds the wires into the re-propagated gates
+ *   in reverse order of the levels of their driving gates by a max-heap.
+ *   A wire is reset to its given and flip-flop constraints and pulled
+ *   again from its taps, the same as in the level backward STA, and the
+ *   wires into its driving gate are rebuilt only if the required time
+ *   of its root changes by more than the tolerance. Changed wires, and
+ *   wires of changed required time constraints, are always rebuilt.
+ *
+ *   Author      : Kuan-Hsien Ho
+************************************************************************/
+
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "Circuit.h"
+#include "Gate.h"
+#include "PinNode.h"
+#include "TimingGraph.h"
+#include "TimingStore.h"
+#include "process.h"
+
+using namespace std;
+
+typedef pair<unsigned, unsigned> KeyId; // (level, gate id) or (level of the driving gate, root id)
+
+//-----------------------------------------------------------------------
+//    Declare main functions
+//-----------------------------------------------------------------------
+
+void runIncrementalSTA( Circuit &circuit, const vector<unsigned> &dirty_gate_id_vec, const vector<unsigned> &dirty_root_id_vec,
+	                const vector<unsigned> &dirty_req_root_id_vec, const double &tolerance );
+
+//-----------------------------------------------------------------------
+//    Declare auxiliary functions
+//-----------------------------------------------------------------------
+
+extern void injectFFRATData( Circuit &circuit, Gate &ff_gate, const unsigned &input_pin_id );
+
+extern void injectRATData( Circuit &circuit, const RATData &cur_data );
+
+extern void pullWireReqTime( Circuit &circuit, const unsigned &root_id );
+
+unsigned getWireRootId( const TimingGraph &graph, const unsigned &pnode_id ); // the pin node itself if it is a root
+
+inline bool isChanged( const double &old_val, const double &new_val, const double &tolerance );
+
+void pushInputWires( const TimingGraph &graph, const unsigned &gate_id, priority_queue<KeyId> &wire_heap );
+
+void pushWire( const TimingGraph &graph, const unsigned &root_id, priority_queue<KeyId> &wire_heap );
+
+void pushWireGates( const TimingGraph &graph, const unsigned &root_id,
+	            priority_queue<KeyId, vector<KeyId>, greater<KeyId> > &gate_heap );
+
+void resetReqTime( Circuit &circuit, const unsigned &pnode_id ); // to its given and flip-flop constraints only
+
+void runIncrementalBackwardSTA( Circuit &circuit, const vector<unsigned> &gate_id_vec, const vector<unsigned> &root_id_vec,
+	                        const vector<unsigned> &req_root_id_vec, const double &tolerance );
+
+void runIncrementalForwardSTA( Circuit &circuit, const vector<unsigned> &dirty_gate_id_vec, const vector<unsigned> &dirty_root_id_vec,
+	                       const double &tolerance, vector<unsigned> &propagated_gate_id_vec );
+
+//-----------------------------------------------------------------------
+//    Define main functions
+//-----------------------------------------------------------------------
+
+// after STA; dirty gates never reached in forward STA, and dirty wires out of them, are skipped
+void runIncrementalSTA( Circuit &circuit, const vector<unsigned> &dirty_gate_id_vec, const vector<unsigned> &dirty_root_id_vec,
+	                const vector<unsigned> &dirty_req_root_id_vec, const double &tolerance )
+{
+    if( !circuit.GetTimingGraph().IsLevelized() )
+	circuit.LevelizeTimingGraph();
+
+    vector<unsigned> propagated_gate_id_vec; // gate ids
+
+    runIncrementalForwardSTA( circuit, dirty_gate_id_vec, dirty_root_id_vec, tolerance, propagated_gate_id_vec );
+
+    if( !circuit.GetIsSequential() && circuit.GetRATDataNo() == 0 ) // no backward STA, the same as runSTA()
+	return;
+
+    runIncrementalBackwardSTA( circuit, propagated_gate_id_vec, dirty_root_id_vec, dirty_req_root_id_vec, tolerance );
+
+    return;
+}
+
+//-----------------------------------------------------------------------
+//    Define auxiliary functions
+//-----------------------------------------------------------------------
+
+void runIncrementalForwardSTA( Circuit &circuit, const vector<unsigned> &dirty_gate_id_vec, const vector<unsigned> &dirty_root_id_vec,
+	                       const double &tolerance, vector<unsigned> &propagated_gate_id_vec )
+{
+    const TimingGraph &graph = circuit.GetTimingGraph();
+    const TimingStore &store = circuit.FetTimingStore();
+    priority_queue<KeyId, vector<KeyId>, greater<KeyId> > gate_heap;
+    vector<double> old_timing_vec; // arrival times and then slews of all splits, output by output
+    KeyId last_key_id( TimingGraph::NO_ID, TimingGraph::NO_ID );
+
+    for( unsigned i=0; i<dirty_gate_id_vec.size(); ++i )
+	if( graph.GetGateLevel(dirty_gate_id_vec[i]) != TimingGraph::NO_ID )
+	    gate_heap.push( KeyId(graph.GetGateLevel(dirty_gate_id_vec[i]), dirty_gate_id_vec[i]) );
+
+    // a dirty driving gate propagates the wire again if its output changes
+    for( unsigned i=0; i<dirty_root_id_vec.size(); ++i )
+    {
+	const unsigned root_id = dirty_root_id_vec[i];
+	const unsigned fanin = graph.GetFanin(root_id);
+
+	if( fanin == TimingGraph::NO_ID || graph.GetGateLevel(graph.GetOutputGateId(TimingGraph::GetHandleId(fanin))) == TimingGraph::NO_ID )
+	    continue;
+
+	propagateWireSignal( circuit, root_id );
+	pushWireGates( graph, root_id, gate_heap );
+    }
+
+    while( !gate_heap.empty() )
+    {
+	const KeyId cur_key_id = gate_heap.top();
+	gate_heap.pop();
+
+	if( cur_key_id == last_key_id ) // pushed by more than one input
+	    continue;
+
+	last_key_id = cur_key_id;
+	const unsigned gate_id = cur_key_id.second;
+	Gate *gate_ptr = graph.GetGatePtr(gate_id);
+
+	if( gate_ptr->GetCellPtr() == NULL ) // PO
+	    continue;
+
+	old_timing_vec.clear();
+
+	for( unsigned i=graph.GetOutputBegin(gate_id); i<graph.GetOutputEnd(gate_id); ++i )
+	{
+	    const unsigned pnode_id = graph.GetOutputPinNodeId(i);
+
+	    for( unsigned s=0; s<TimingStore::SPLIT_NO; ++s )
+		old_timing_vec.push_back( (pnode_id == TimingGraph::NO_ID)? 0.0: store.GetArrTime(static_cast<TimingStore::Split>(s), pnode_id) );
+
+	    for( unsigned s=0; s<TimingStore::SPLIT_NO; ++s )
+		old_timing_vec.push_back( (pnode_id == TimingGraph::NO_ID)? 0.0: store.GetSlew(static_cast<TimingStore::Split>(s), pnode_id) );
+	}
+
+	if( gate_ptr->GetIsNonClocked() )
+	    propagateSignal( circuit, gate_id );
+	else if( gate_ptr->GetInputPinNode(gate_ptr->GetClockPinId()) != NULL )
+	    propagateSignal( circuit, gate_ptr->GetClockPinId(), gate_ptr ); // clock to Q and QN, also for constraints of new input slews
+
+	propagated_gate_id_vec.push_back( gate_id );
+
+	for( unsigned i=graph.GetOutputBegin(gate_id); i<graph.GetOutputEnd(gate_id); ++i )
+	{
+	    const unsigned root_id = graph.GetOutputPinNodeId(i);
+
+	    if( root_id == TimingGraph::NO_ID )
+		continue;
+
+	    const double *old_timing = &old_timing_vec[ (i-graph.GetOutputBegin(gate_id)) * 2 * TimingStore::SPLIT_NO ];
+	    bool is_changed = false;
+
+	    for( unsigned s=0; s<TimingStore::SPLIT_NO && !is_changed; ++s )
+	    {
+		const TimingStore::Split split = static_cast<TimingStore::Split>(s);
+		is_changed = ( isChanged(old_timing[s], store.GetArrTime(split, root_id), tolerance) ||
+		               isChanged(old_timing[TimingStore::SPLIT_NO+s], store.GetSlew(split, root_id), tolerance) );
+	    }
+
+	    if( is_changed )
+	    {
+		propagateWireSignal( circuit, root_id );
+		pushWireGates( graph, root_id, gate_heap );
+	    }
+	}
+    }
+
+    return;
+}
+
+// wires into the gates whose arc delays, output required times or constraints may change, wires of new delays,
+// and wires of new constraints
+void runIncrementalBackwardSTA( Circuit &circuit, const vector<unsigned> &gate_id_vec, const vector<unsigned> &root_id_vec,
+	                        const vector<unsigned> &req_root_id_vec, const double &tolerance )
+{
+    const TimingGraph &graph = circuit.GetTimingGraph();
+    const TimingStore &store = circuit.FetTimingStore();
+    priority_queue<KeyId> wire_heap;
+    KeyId last_key_id( TimingGraph::NO_ID, TimingGraph::NO_ID );
+
+    for( unsigned i=0; i<gate_id_vec.size(); ++i )
+	pushInputWires( graph, gate_id_vec[i], wire_heap );
+
+    for( unsigned i=0; i<root_id_vec.size(); ++i )
+	pushWire( graph, root_id_vec[i], wire_heap );
+
+    for( unsigned i=0; i<req_root_id_vec.size(); ++i )
+	pushWire( graph, req_root_id_vec[i], wire_heap );
+
+    while( !wire_heap.empty() )
+    {
+	const KeyId cur_key_id = wire_heap.top();
+	wire_heap.pop();
+
+	if( cur_key_id == last_key_id ) // pushed by more than one gate
+	    continue;
+
+	last_key_id = cur_key_id;
+	const unsigned root_id = cur_key_id.second;
+	double old_req_time[TimingStore::SPLIT_NO];
+
+	for( unsigned s=0; s<TimingStore::SPLIT_NO; ++s )
+	    old_req_time[s] = store.GetReqTime( static_cast<TimingStore::Split>(s), root_id );
+
+	// rebuild the wire from its constraints, since required times can only be tightened
+	resetReqTime( circuit, root_id );
+
+	for( unsigned i=graph.GetFanoutBegin(root_id); i<graph.GetFanoutEnd(root_id); ++i )
+	    if( TimingGraph::GetKind(graph.GetFanout(i)) == TimingGraph::PIN_NODE )
+		resetReqTime( circuit, TimingGraph::GetHandleId(graph.GetFanout(i)) );
+
+	pullWireReqTime( circuit, root_id );
+
+	if( graph.GetFanin(root_id) == TimingGraph::NO_ID )
+	    continue;
+
+	assert( TimingGraph::GetKind(graph.GetFanin(root_id)) == TimingGraph::GATE_OUTPUT );
+	const unsigned driver_id = graph.GetOutputGateId( TimingGraph::GetHandleId(graph.GetFanin(root_id)) );
+	const Gate &driver = *(graph.GetGatePtr(driver_id));
+
+	if( driver.GetCellPtr() == NULL || !driver.GetIsNonClocked() ) // PI or flip-flop
+	    continue;
+
+	bool is_changed = false;
+
+	for( unsigned s=0; s<TimingStore::SPLIT_NO && !is_changed; ++s )
+	    is_changed = isChanged( old_req_time[s], store.GetReqTime(static_cast<TimingStore::Split>(s), root_id), tolerance );
+
+	if( is_changed )
+	    pushInputWires( graph, driver_id, wire_heap );
+    }
+
+    return;
+}
+
+unsigned getWireRootId( const TimingGraph &graph, const unsigned &pnode_id )
+{
+    const unsigned fanin = graph.GetFanin(pnode_id);
+
+    if( fanin != TimingGraph::NO_ID && TimingGraph::GetKind(fanin) == TimingGraph::PIN_NODE )
+	return TimingGraph::GetHandleId(fanin);
+
+    return pnode_id;
+}
+
+// true if the difference is more than the tolerance, where equal infinite values are not changed
+inline bool isChanged( const double &old_val, const double &new_val, const double &tolerance )
+{
+    return ( new_val != old_val && !(fabs(new_val - old_val) <= tolerance) );
+}
+
+void pushInputWires( const TimingGraph &graph, const unsigned &gate_id, priority_queue<KeyId> &wire_heap )
+{
+    for( unsigned i=graph.GetInputBegin(gate_id); i<graph.GetInputEnd(gate_id); ++i )
+	if( graph.GetInputPinNodeId(i) != TimingGraph::NO_ID )
+	    pushWire( graph, getWireRootId(graph, graph.GetInputPinNodeId(i)), wire_heap );
+
+    return;
+}
+
+// keyed by the level of the driving gate plus one, or zero if driven by nothing, so a wire is rebuilt after all wires
+// out of the gates it drives; wires out of gates never reached in forward STA are never pulled
+void pushWire( const TimingGraph &graph, const unsigned &root_id, priority_queue<KeyId> &wire_heap )
+{
+    const unsigned fanin = graph.GetFanin(root_id);
+
+    if( fanin == TimingGraph::NO_ID )
+	wire_heap.push( KeyId(0, root_id) );
+    else if( graph.GetGateLevel(graph.GetOutputGateId(TimingGraph::GetHandleId(fanin))) != TimingGraph::NO_ID )
+	wire_heap.push( KeyId(graph.GetGateLevel(graph.GetOutputGateId(TimingGraph::GetHandleId(fanin)))+1, root_id) );
+
+    return;
+}
+
+void pushWireGates( const TimingGraph &graph, const unsigned &root_id,
+	            priority_queue<KeyId, vector<KeyId>, greater<KeyId> > &gate_heap )
+{
+    for( unsigned i=graph.GetFanoutBegin(root_id); i<graph.GetFanoutEnd(root_id); ++i )
+    {
+	const unsigned fanout = graph.GetFanout(i);
+	const unsigned driven_input_id = (TimingGraph::GetKind(fanout) == TimingGraph::PIN_NODE)?
+	                                 graph.GetTapInputId(TimingGraph::GetHandleId(fanout)): TimingGraph::GetHandleId(fanout);
+
+	if( driven_input_id == TimingGraph::NO_ID ) // very special case
+	    continue;
+
+	const unsigned driven_gate_id = graph.GetInputGateId(driven_input_id);
+
+	if( graph.GetGateLevel(driven_gate_id) != TimingGraph::NO_ID )
+	    gate_heap.push( KeyId(graph.GetGateLevel(driven_gate_id), driven_gate_id) );
+    }
+
+    return;
+}
+
+void resetReqTime( Circuit &circuit, const unsigned &pnode_id )
+{
+    const TimingGraph &graph = circuit.GetTimingGraph();
+    TimingStore &store = circuit.FetTimingStore();
+    const unsigned rat_id = circuit.GetRATDataId( *(circuit.GetPinNodePtr(pnode_id)) );
+
+    store.SetReqTime( TimingStore::FAST_FALL, pnode_id, MIN_REQ_TIME );
+    store.SetReqTime( TimingStore::FAST_RISE, pnode_id, MIN_REQ_TIME );
+    store.SetReqTime( TimingStore::SLOW_FALL, pnode_id, MAX_REQ_TIME );
+    store.SetReqTime( TimingStore::SLOW_RISE, pnode_id, MAX_REQ_TIME );
+
+    if( rat_id != RATData::NO_DATA )
+	injectRATData( circuit, circuit.FetRATDataVec()[rat_id] );
+
+    if( !circuit.GetIsSequential() )
+	return;
+
+    for( unsigned i=graph.GetFanoutBegin(pnode_id); i<graph.GetFanoutEnd(pnode_id); ++i )
+    {
+	if( TimingGraph::GetKind(graph.GetFanout(i)) != TimingGraph::GATE_INPUT )
+	    continue;
+
+	const unsigned input_id = TimingGraph::GetHandleId( graph.GetFanout(i) );
+	const unsigned gate_id = graph.GetInputGateId(input_id);
+	Gate &cur_gate = *(graph.GetGatePtr(gate_id));
+
+	if( cur_gate.GetCellPtr() != NULL && !cur_gate.GetIsNonClocked() )
+	    injectFFRATData( circuit, cur_gate, input_id-graph.GetInputBegin(gate_id) );
+    }
+
+    return;
+}
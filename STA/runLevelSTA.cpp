@@ -0,0 +1,278 @@
+/************************************************************************
+ *   Perform forward STA level by level on a levelized timing graph.
+ *   Gates of a level only read pin nodes written by lower levels, and
+ *   write their own output pin nodes, taps and arc delays, so each level
+ *   is propagated in parallel by chunks of gates. Every gate computes
+ *   the same values as in the serial forward STA.
+ *
+ *   Backward STA runs the levels in reverse order. Each gate pulls the
+ *   required times of its output pin nodes from their fanouts, whose
+ *   gates are all in higher levels, and it writes only its output pin
+ *   nodes and their taps, so no queue or readiness count is needed.
+ *   Alternatively, each gate pushes required times into the pin nodes
+ *   of its inputs and the roots of their wires by atomic min/max, so a
+ *   high-fanout wire is folded by all its gates instead of one thread.
+ *
+ *   Author      : Kuan-Hsien Ho
+************************************************************************/
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <vector>
+
+#include "Circuit.h"
+#include "Gate.h"
+#include "PinNode.h"
+#include "TimingGraph.h"
+#include "TimingStore.h"
+#include "process.h"
+
+using namespace std;
+
+//-----------------------------------------------------------------------
+//    Declare main functions
+//-----------------------------------------------------------------------
+
+void runLevelBackwardSTA( Circuit &circuit, ThreadPool &thread_pool, const unsigned &chunk_size, const bool &is_pushing );
+
+void runLevelForwardSTA( Circuit &circuit, ThreadPool &thread_pool, const unsigned &chunk_size );
+
+//-----------------------------------------------------------------------
+//    Declare auxiliary functions
+//-----------------------------------------------------------------------
+
+extern void injectFFsRATData( Circuit &circuit );
+
+void pullReqTime( Circuit &circuit, const unsigned &gate_id ); // of the wires driven by a gate
+
+void pushReqTime( Circuit &circuit, const unsigned &gate_id ); // into the wires driving a gate
+
+void pushInputReqTime( Circuit &circuit, const unsigned &gate_id ); // pushReqTime() but the output wires
+
+void pullWireReqTime( Circuit &circuit, const unsigned &root_id ); // of the taps of a wire, and then its root
+
+void visitWire( Circuit &circuit, const unsigned &root_id ); // set the root and taps of a wire visited
+
+//-----------------------------------------------------------------------
+//    Define main functions
+//-----------------------------------------------------------------------
+
+// after given required times are injected; gates never reached in forward STA are not visited
+void runLevelBackwardSTA( Circuit &circuit, ThreadPool &thread_pool, const unsigned &chunk_size, const bool &is_pushing )
+{
+    if( !circuit.GetTimingGraph().IsLevelized() )
+	circuit.LevelizeTimingGraph();
+
+    const TimingGraph &graph = circuit.GetTimingGraph();
+
+    if( circuit.GetIsSequential() )
+	injectFFsRATData( circuit );
+
+    // constraints of flip-flops reach gates in any level, also above the clock level
+    if( is_pushing )
+    {
+	const unsigned first_seq_gate_id = graph.GetFirstSeqGateId();
+	thread_pool.ParallelFor( graph.GetSeqGateNo(), chunk_size, [&](unsigned, unsigned begin, unsigned end) {
+	    for( unsigned i=first_seq_gate_id+begin; i<first_seq_gate_id+end; ++i )
+		pushInputReqTime( circuit, i ); } );
+    }
+
+    for( unsigned i=graph.GetLevelNo(); i-- > 0; )
+    {
+	const unsigned level_begin = graph.GetLevelBegin(i);
+
+	thread_pool.ParallelFor( graph.GetLevelEnd(i)-level_begin, chunk_size, [&](unsigned, unsigned begin, unsigned end) {
+	    for( unsigned j=level_begin+begin; j<level_begin+end; ++j )
+	    {
+		if( is_pushing )
+		    pushReqTime( circuit, graph.GetLevelGateId(j) );
+		else
+		    pullReqTime( circuit, graph.GetLevelGateId(j) );
+	    } } );
+    }
+
+    // wires driven by nothing, whose taps are still read by no gate if pulling
+    thread_pool.ParallelFor( graph.GetPinNodeNo(), chunk_size, [&](unsigned, unsigned begin, unsigned end) {
+	for( unsigned i=begin; i<end; ++i )
+	{
+	    if( graph.GetFanin(i) != TimingGraph::NO_ID )
+		continue;
+
+	    if( is_pushing )
+		visitWire( circuit, i );
+	    else
+		pullWireReqTime( circuit, i );
+	} } );
+
+    return;
+}
+
+// run both early-mode and late-mode STA on a combinational or sequential circuit
+void runLevelForwardSTA( Circuit &circuit, ThreadPool &thread_pool, const unsigned &chunk_size )
+{
+    if( !circuit.GetTimingGraph().IsLevelized() )
+	circuit.LevelizeTimingGraph();
+
+    const TimingGraph &graph = circuit.GetTimingGraph();
+
+    for( unsigned i=0; i<graph.GetLevelNo(); ++i )
+    {
+	const unsigned level_begin = graph.GetLevelBegin(i);
+
+	// clock signals reach Q's and QN's of all flip-flops before any wire from flip-flops is propagated
+	if( i == graph.GetClockLevel() )
+	{
+	    thread_pool.ParallelFor( graph.GetLevelEnd(i)-level_begin, chunk_size, [&](unsigned, unsigned begin, unsigned end) {
+		for( unsigned j=level_begin+begin; j<level_begin+end; ++j )
+		{
+		    Gate *gate_ptr = graph.GetGatePtr( graph.GetLevelGateId(j) );
+		    propagateSignal( circuit, gate_ptr->GetClockPinId(), gate_ptr );
+		} } );
+	}
+
+	thread_pool.ParallelFor( graph.GetLevelEnd(i)-level_begin, chunk_size, [&](unsigned, unsigned begin, unsigned end) {
+	    for( unsigned j=level_begin+begin; j<level_begin+end; ++j )
+		propagateGateSignal( circuit, graph.GetLevelGateId(j) ); } );
+    }
+
+    return;
+}
+
+//-----------------------------------------------------------------------
+//    Define auxiliary functions
+//-----------------------------------------------------------------------
+
+void pullReqTime( Circuit &circuit, const unsigned &gate_id )
+{
+    const TimingGraph &graph = circuit.GetTimingGraph();
+
+    for( unsigned i=graph.GetOutputBegin(gate_id); i<graph.GetOutputEnd(gate_id); ++i )
+	if( graph.GetOutputPinNodeId(i) != TimingGraph::NO_ID )
+	    pullWireReqTime( circuit, graph.GetOutputPinNodeId(i) );
+
+    return;
+}
+
+// the same values as the serial backward STA gives, where gates backtrace into the pin nodes of their inputs;
+// the root is written only if a gate drives it, and all pin nodes written are owned by the wire
+void pullWireReqTime( Circuit &circuit, const unsigned &root_id )
+{
+    const TimingGraph &graph = circuit.GetTimingGraph();
+    TimingStore &store = circuit.FetTimingStore();
+    const double inf = numeric_limits<double>::infinity();
+    const bool is_driven = ( graph.GetFanin(root_id) != TimingGraph::NO_ID );
+    PinNode &root_pnode = *(circuit.GetPinNodePtr(root_id));
+    bool has_driven_tap = false;
+
+    // running extrema over all driven taps: max in early mode, min in late mode
+    double root_fastFall_ratime = -inf, root_fastRise_ratime = -inf;
+    double root_slowFall_ratime = inf, root_slowRise_ratime = inf;
+
+    for( unsigned i=graph.GetFanoutBegin(root_id); i<graph.GetFanoutEnd(root_id); ++i )
+    {
+	const unsigned fanout = graph.GetFanout(i);
+
+	// gate input driven directly by the root
+	if( TimingGraph::GetKind(fanout) != TimingGraph::PIN_NODE )
+	{
+	    if( is_driven )
+		backtraceInputSignal( circuit, TimingGraph::GetHandleId(fanout) );
+
+	    continue;
+	}
+
+	const unsigned tap_id = TimingGraph::GetHandleId(fanout);
+	PinNode &tap_pnode = *(circuit.GetPinNodePtr(tap_id));
+	tap_pnode.SetIsVisited();
+
+	for( unsigned j=graph.GetFanoutBegin(tap_id); j<graph.GetFanoutEnd(tap_id); ++j )
+	{
+	    assert( TimingGraph::GetKind(graph.GetFanout(j)) == TimingGraph::GATE_INPUT );
+	    backtraceInputSignal( circuit, TimingGraph::GetHandleId(graph.GetFanout(j)) );
+	}
+
+	if( graph.GetTapInputId(tap_id) == TimingGraph::NO_ID )
+	    continue;
+
+	has_driven_tap = true;
+	root_fastFall_ratime = max( root_fastFall_ratime, store.GetReqTime(TimingStore::FAST_FALL, tap_id) - graph.GetWireFallDelay(tap_id) );
+	root_fastRise_ratime = max( root_fastRise_ratime, store.GetReqTime(TimingStore::FAST_RISE, tap_id) - graph.GetWireRiseDelay(tap_id) );
+	root_slowFall_ratime = min( root_slowFall_ratime, store.GetReqTime(TimingStore::SLOW_FALL, tap_id) - graph.GetWireFallDelay(tap_id) );
+	root_slowRise_ratime = min( root_slowRise_ratime, store.GetReqTime(TimingStore::SLOW_RISE, tap_id) - graph.GetWireRiseDelay(tap_id) );
+    }
+
+    root_pnode.SetIsVisited();
+
+    if( has_driven_tap && is_driven )
+    {
+	store.TightenReqTime( TimingStore::FAST_FALL, root_id, root_fastFall_ratime );
+	store.TightenReqTime( TimingStore::FAST_RISE, root_id, root_fastRise_ratime );
+	store.TightenReqTime( TimingStore::SLOW_FALL, root_id, root_slowFall_ratime );
+	store.TightenReqTime( TimingStore::SLOW_RISE, root_id, root_slowRise_ratime );
+    }
+
+    return;
+}
+
+// the output wires are folded already, by gates of higher levels
+void pushReqTime( Circuit &circuit, const unsigned &gate_id )
+{
+    const TimingGraph &graph = circuit.GetTimingGraph();
+    const Gate &cur_gate = *(graph.GetGatePtr(gate_id));
+
+    for( unsigned i=graph.GetOutputBegin(gate_id); i<graph.GetOutputEnd(gate_id); ++i )
+	if( graph.GetOutputPinNodeId(i) != TimingGraph::NO_ID )
+	    visitWire( circuit, graph.GetOutputPinNodeId(i) );
+
+    if( cur_gate.GetCellPtr() == NULL || cur_gate.GetIsNonClocked() ) // flip-flops pushed before all levels
+	pushInputReqTime( circuit, gate_id );
+
+    return;
+}
+
+// backtrace into the pin nodes of the inputs, and then fold their taps into the roots of their wires,
+// where pin nodes shared with other gates of the level are set atomically
+void pushInputReqTime( Circuit &circuit, const unsigned &gate_id )
+{
+    const TimingGraph &graph = circuit.GetTimingGraph();
+    TimingStore &store = circuit.FetTimingStore();
+
+    for( unsigned i=graph.GetInputBegin(gate_id); i<graph.GetInputEnd(gate_id); ++i )
+	backtraceSharedInputSignal( circuit, i );
+
+    for( unsigned i=graph.GetInputBegin(gate_id); i<graph.GetInputEnd(gate_id); ++i )
+    {
+	const unsigned tap_id = graph.GetInputPinNodeId(i);
+
+	if( tap_id == TimingGraph::NO_ID || graph.GetFanin(tap_id) == TimingGraph::NO_ID || 
+	    TimingGraph::GetKind(graph.GetFanin(tap_id)) != TimingGraph::PIN_NODE )
+	    continue;
+
+	const unsigned root_id = TimingGraph::GetHandleId( graph.GetFanin(tap_id) );
+
+	if( graph.GetFanin(root_id) == TimingGraph::NO_ID ) // the serial STA does not fold it either
+	    continue;
+
+	// other gates of the tap may still tighten it, but each pushes what it reads after its own backtrace,
+	// so the tightest push is the final value of the tap
+	store.AtomicTightenReqTime( TimingStore::FAST_FALL, root_id, store.AtomicGetReqTime(TimingStore::FAST_FALL, tap_id) - graph.GetWireFallDelay(tap_id) );
+	store.AtomicTightenReqTime( TimingStore::FAST_RISE, root_id, store.AtomicGetReqTime(TimingStore::FAST_RISE, tap_id) - graph.GetWireRiseDelay(tap_id) );
+	store.AtomicTightenReqTime( TimingStore::SLOW_FALL, root_id, store.AtomicGetReqTime(TimingStore::SLOW_FALL, tap_id) - graph.GetWireFallDelay(tap_id) );
+	store.AtomicTightenReqTime( TimingStore::SLOW_RISE, root_id, store.AtomicGetReqTime(TimingStore::SLOW_RISE, tap_id) - graph.GetWireRiseDelay(tap_id) );
+    }
+
+    return;
+}
+
+void visitWire( Circuit &circuit, const unsigned &root_id )
+{
+    const TimingGraph &graph = circuit.GetTimingGraph();
+    circuit.GetPinNodePtr(root_id)->SetIsVisited();
+
+    for( unsigned i=graph.GetFanoutBegin(root_id); i<graph.GetFanoutEnd(root_id); ++i )
+	if( TimingGraph::GetKind(graph.GetFanout(i)) == TimingGraph::PIN_NODE )
+	    circuit.GetPinNodePtr( TimingGraph::GetHandleId(graph.GetFanout(i)) )->SetIsVisited();
+
+    return;
+}
@@ -0,0 +1,275 @@
+/************************************************************************
+ *   Run a stream of timing operations after STA, in the style of the
+ *   TAU 2015 incremental timing contest. Edits are queued in the circuit,
+ *   and nothing is computed until a report needs timing, so the union of
+ *   the dirty cones of a batch of edits is propagated once.
+ *
+ *   One operation per line, where the constraint lines are the same as
+ *   in the netlist:
+ *     at <pin> <early fall> <late fall> <early rise> <late rise>
+ *     slew <pin> <fall> <rise>
+ *     rat <pin> early|late <fall> <rise>
+ *     clock <pin> <period>
+ *     replace_cell <output pin> <cell>
+ *     set_res <wire root> <node> <node> <resistance>
+ *     set_cap <wire root> <node> <capacitance>
+ *     wire <root> <taps> ..., followed by its res and cap lines
+ *     insert_gate <cell> <pin>:<node> ...
+ *     remove_gate <output pin>
+ *     insert_net <root> <taps> ..., followed by its res and cap lines
+ *     remove_net <root>
+ *     connect_pin <output pin> <cell pin> <node>
+ *     disconnect_pin <output pin> <cell pin>
+ *     update_timing
+ *     report_at|report_slew|report_rat|report_slack <pin>
+ *   A gate is named by an output pin node, and a net is a wire, named by
+ *   its root. A gate pin is connected to a pin node, which may be a tap
+ *   of a wire, as in an instance line.
+ *
+ *   Author      : Kuan-Hsien Ho
+************************************************************************/
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Cell.h"
+#include "CellLibrary.h"
+#include "Circuit.h"
+#include "Gate.h"
+#include "MappedFile.h"
+#include "NameTable.h"
+#include "PinNode.h"
+#include "RATData.h"
+#include "TimingStore.h"
+#include "process.h"
+
+using namespace std;
+
+//-----------------------------------------------------------------------
+//    Declare main functions
+//-----------------------------------------------------------------------
+
+void runOperations( Circuit &circuit, const CellLibrary &cell_library, const char *file_name );
+
+//-----------------------------------------------------------------------
+//    Declare auxiliary functions
+//-----------------------------------------------------------------------
+
+extern bool cmpCellPtrName( Cell *a_ptr, string_view name );
+
+extern void genSortedCellPtrVec( const CellLibrary &cell_library, vector<Cell*> &cell_ptr_vec );
+
+Cell* findCellPtr( const vector<Cell*> &cell_ptr_vec, string_view name ); // exit if not found
+
+Gate* findDrivingGatePtr( const Circuit &circuit, PinNode &pnode ); // exit if not driven by a gate
+
+PinNode* findPinNodePtr( const Circuit &circuit, string_view name ); // exit if not found
+
+void reportTiming( Circuit &circuit, string_view op, PinNode &pnode );
+
+//-----------------------------------------------------------------------
+//    Define main functions
+//-----------------------------------------------------------------------
+
+// reports are printed on screen
+void runOperations( Circuit &circuit, const CellLibrary &cell_library, const char *file_name )
+{
+    MappedFile inf( file_name ); // exit if failed
+    LineTokenizer tokenizer( inf );
+    vector<Cell*> cell_ptr_vec;
+    genSortedCellPtrVec( cell_library, cell_ptr_vec );
+    NameTable rc_node_name_table; // of an inserted wire
+
+    bool has_line = tokenizer.NextLine();
+    string_view op = (has_line)? tokenizer.NextToken(): string_view();
+
+    while( has_line )
+    {
+	if( op == "wire" ) // the block ends at the first line which is not res or cap
+	{
+	    const char *block_begin = op.data();
+	    const char *block_end = inf.GetEnd();
+
+	    while( (has_line = tokenizer.NextLine()) )
+	    {
+		op = tokenizer.NextToken();
+
+		if( op != "res" && op != "cap" )
+		{
+		    block_end = op.data();
+		    break;
+		}
+	    }
+
+	    circuit.ReplaceWire( string_view(block_begin, block_end-block_begin) );
+	    continue;
+	}
+
+	if( op == "insert_net" ) // the same, and the first word of the line next to the block is the next operation
+	{
+	    has_line = !circuit.InsertWire( tokenizer, rc_node_name_table, op );
+	    continue;
+	}
+
+	if( op == "at" )
+	{
+	    PinNode *pnode_ptr = findPinNodePtr( circuit, tokenizer.NextToken() );
+	    const double fast_fall_time = tokenizer.NextDouble();
+	    const double slow_fall_time = tokenizer.NextDouble();
+	    const double fast_rise_time = tokenizer.NextDouble();
+	    const double slow_rise_time = tokenizer.NextDouble();
+	    circuit.SetArrivalTime( pnode_ptr, fast_fall_time, slow_fall_time, fast_rise_time, slow_rise_time );
+	}
+	else if( op == "slew" )
+	{
+	    PinNode *pnode_ptr = findPinNodePtr( circuit, tokenizer.NextToken() );
+	    const double fall_slew = tokenizer.NextDouble();
+	    const double rise_slew = tokenizer.NextDouble();
+	    circuit.SetSlew( pnode_ptr, fall_slew, rise_slew );
+	}
+	else if( op == "rat" )
+	{
+	    PinNode *pnode_ptr = findPinNodePtr( circuit, tokenizer.NextToken() );
+	    const RATData::ModeType mode = (tokenizer.NextToken() == "early")? RATData::FAST: RATData::SLOW;
+	    const double fall_time = tokenizer.NextDouble();
+	    const double rise_time = tokenizer.NextDouble();
+	    circuit.SetRATData( pnode_ptr, mode, fall_time, rise_time );
+	}
+	else if( op == "clock" )
+	{
+	    tokenizer.NextToken(); // the clock pin does not change
+	    circuit.SetClockPeriod( tokenizer.NextDouble() );
+	}
+	else if( op == "replace_cell" )
+	{
+	    Gate *gate_ptr = findDrivingGatePtr( circuit, *findPinNodePtr(circuit, tokenizer.NextToken()) );
+	    circuit.ReplaceCell( gate_ptr, findCellPtr(cell_ptr_vec, tokenizer.NextToken()) );
+	}
+	else if( op == "set_res" )
+	{
+	    PinNode *root_ptr = findPinNodePtr( circuit, tokenizer.NextToken() );
+	    const string_view end1_name = tokenizer.NextToken();
+	    const string_view end2_name = tokenizer.NextToken();
+	    circuit.SetWireRes( root_ptr, end1_name, end2_name, tokenizer.NextDouble() );
+	}
+	else if( op == "set_cap" )
+	{
+	    PinNode *root_ptr = findPinNodePtr( circuit, tokenizer.NextToken() );
+	    const string_view node_name = tokenizer.NextToken();
+	    circuit.SetWireCap( root_ptr, node_name, tokenizer.NextDouble() );
+	}
+	else if( op == "update_timing" )
+	    circuit.UpdateTiming();
+	else if( op == "report_at" || op == "report_slew" || op == "report_rat" || op == "report_slack" )
+	    reportTiming( circuit, op, *findPinNodePtr(circuit, tokenizer.NextToken()) );
+	else if( op == "insert_gate" )
+	    circuit.InsertGate( tokenizer, findCellPtr(cell_ptr_vec, tokenizer.NextToken()) );
+	else if( op == "remove_gate" )
+	    circuit.RemoveGate( findDrivingGatePtr(circuit, *findPinNodePtr(circuit, tokenizer.NextToken())) );
+	else if( op == "remove_net" )
+	    circuit.RemoveWire( findPinNodePtr(circuit, tokenizer.NextToken()) );
+	else if( op == "connect_pin" )
+	{
+	    Gate *gate_ptr = findDrivingGatePtr( circuit, *findPinNodePtr(circuit, tokenizer.NextToken()) );
+	    const string_view pin_name = tokenizer.NextToken();
+	    circuit.ConnectPin( gate_ptr, pin_name, findPinNodePtr(circuit, tokenizer.NextToken()) );
+	}
+	else if( op == "disconnect_pin" )
+	{
+	    Gate *gate_ptr = findDrivingGatePtr( circuit, *findPinNodePtr(circuit, tokenizer.NextToken()) );
+	    circuit.DisconnectPin( gate_ptr, tokenizer.NextToken() );
+	}
+	else
+	{
+	    printf( "Error: unknown operation %s in %s\n", string(op).c_str(), file_name );
+	    exit(-1);
+	}
+
+	if( (has_line = tokenizer.NextLine()) )
+	    op = tokenizer.NextToken();
+    }
+
+    return;
+}
+
+//-----------------------------------------------------------------------
+//    Define auxiliary functions
+//-----------------------------------------------------------------------
+
+Cell* findCellPtr( const vector<Cell*> &cell_ptr_vec, string_view name )
+{
+    vector<Cell*>::const_iterator cellPtrVecIter = lower_bound( cell_ptr_vec.begin(), cell_ptr_vec.end(), name, cmpCellPtrName );
+
+    if( cellPtrVecIter == cell_ptr_vec.end() || (**cellPtrVecIter).GetName() != name )
+    {
+	printf( "Error: no cell %s in the library\n", string(name).c_str() );
+	exit(-1);
+    }
+
+    return (*cellPtrVecIter);
+}
+
+Gate* findDrivingGatePtr( const Circuit &circuit, PinNode &pnode )
+{
+    Element *fanin_ptr = pnode.GetFaninPtr();
+
+    if( fanin_ptr == NULL || fanin_ptr->GetType() != Element::GOUT_PIN ||
+	static_cast<GOutPin*>(fanin_ptr)->GetGatePtr()->GetCellPtr() == NULL )
+    {
+	printf( "Error: pin node %s is not driven by a gate\n", string(circuit.GetPinNodeName(pnode)).c_str() );
+	exit(-1);
+    }
+
+    return static_cast<GOutPin*>(fanin_ptr)->GetGatePtr();
+}
+
+PinNode* findPinNodePtr( const Circuit &circuit, string_view name )
+{
+    PinNode *pnode_ptr = circuit.FindPinNodePtr(name);
+
+    if( pnode_ptr == NULL )
+    {
+	printf( "Error: no pin node %s in the circuit\n", string(name).c_str() );
+	exit(-1);
+    }
+
+    return pnode_ptr;
+}
+
+// early fall, early rise, late fall and late rise, the same order as Circuit::PrintTimingData()
+void reportTiming( Circuit &circuit, string_view op, PinNode &pnode )
+{
+    circuit.UpdateTiming(); // queued edits
+
+    const TimingStore &store = circuit.GetTimingStore();
+    const unsigned id = pnode.GetId();
+    const string name( circuit.GetPinNodeName(pnode) );
+
+    if( op == "report_at" )
+	printf( "at %s %.5le %.5le %.5le %.5le\n", name.c_str(), 
+		store.GetArrTime(TimingStore::FAST_FALL, id), store.GetArrTime(TimingStore::FAST_RISE, id), 
+		store.GetArrTime(TimingStore::SLOW_FALL, id), store.GetArrTime(TimingStore::SLOW_RISE, id) );
+    else if( op == "report_slew" )
+	printf( "slew %s %.5le %.5le %.5le %.5le\n", name.c_str(), 
+		store.GetSlew(TimingStore::FAST_FALL, id), store.GetSlew(TimingStore::FAST_RISE, id), 
+		store.GetSlew(TimingStore::SLOW_FALL, id), store.GetSlew(TimingStore::SLOW_RISE, id) );
+    else if( op == "report_rat" )
+	printf( "rat %s %.5le %.5le %.5le %.5le\n", name.c_str(), 
+		store.GetReqTime(TimingStore::FAST_FALL, id), store.GetReqTime(TimingStore::FAST_RISE, id), 
+		store.GetReqTime(TimingStore::SLOW_FALL, id), store.GetReqTime(TimingStore::SLOW_RISE, id) );
+    else
+    {
+	printf( "slack %s early %.5le %.5le\n", name.c_str(), 
+		store.GetArrTime(TimingStore::FAST_FALL, id)-store.GetReqTime(TimingStore::FAST_FALL, id),
+		store.GetArrTime(TimingStore::FAST_RISE, id)-store.GetReqTime(TimingStore::FAST_RISE, id) );
+	printf( "slack %s late %.5le %.5le\n", name.c_str(), 
+		store.GetReqTime(TimingStore::SLOW_FALL, id)-store.GetArrTime(TimingStore::SLOW_FALL, id),
+		store.GetReqTime(TimingStore::SLOW_RISE, id)-store.GetArrTime(TimingStore::SLOW_RISE, id) );
+    }
+
+    return;
+}
@@ -1,5 +1,6 @@
 /************************************************************************
- *   Console of combinational or sequential STA.
+ *   Console of combinational or sequential STA, and of backward STA
+ *   only after constraints change.
  *
  *   Author      : Kuan-Hsien Ho
 ************************************************************************/
@@ -9,6 +10,7 @@
 
 #include "Circuit.h"
 #include "Gate.h"
+#include "TimingStore.h"
 #include "process.h"
 
 using namespace std;
@@ -19,7 +21,9 @@ using namespace std;
 
 void resistDefectPinNodes( Circuit &circuit );
 
-void runSTA( Circuit &circuit );
+void runConstraintSTA( Circuit &circuit, ThreadPool &thread_pool, const unsigned &chunk_size, const bool &is_push_backward );
+
+void runSTA( Circuit &circuit, ThreadPool &thread_pool, const unsigned &chunk_size, const bool &is_task_graph, const bool &is_push_backward );
 
 //-----------------------------------------------------------------------
 //    Declare auxiliary functions 
@@ -31,7 +35,9 @@ bool areAllPinNodesVisited( Circuit &circuit );    // check only
 
 void injectGivenRATData( Circuit &circuit );
 
-void propagateVirtualSignal( PinNode &cur_pnode );
+void injectRATData( Circuit &circuit, const RATData &cur_data ); // of one pin node
+
+void propagateVirtualSignal( const TimingGraph &graph, const unsigned &pnode_id );
 
 //-----------------------------------------------------------------------
 //    Define main functions
@@ -40,31 +46,28 @@ void propagateVirtualSignal( PinNode &cur_pnode );
 // resist simple defects on pin nodes to facilite STA signal propagation, e.g., off nodes in s400 and s1196
 void resistDefectPinNodes( Circuit &circuit )
 {
-    vector<PinNode*> &pnodes = circuit.FetPinNodePtrVec();
+    const TimingGraph &graph = circuit.GetTimingGraph();
 
-    for( unsigned i=0; i<pnodes.size(); ++i )
+    for( unsigned i=0; i<graph.GetPinNodeNo(); ++i )
     {
-	PinNode &cur_pnode = *(pnodes[i]);
-//	printf( "name = %s\n", cur_pnode.GetName().c_str() );
-
 	// pin node with no fanin
-	if( cur_pnode.GetFaninPtr() == NULL )
-	    propagateVirtualSignal( cur_pnode );
+	if( graph.GetFanin(i) == TimingGraph::NO_ID )
+	    propagateVirtualSignal( graph, i );
 
-	if( cur_pnode.GetFanoutPtrNo() == 0 )
+	if( graph.GetFanoutNo(i) == 0 )
 	{
-            Element *fanin_ptr = cur_pnode.GetFaninPtr();
+            unsigned fanin = graph.GetFanin(i);
 
-	    while( fanin_ptr != NULL && fanin_ptr->GetType() != Element::GOUT_PIN )
+	    while( fanin != TimingGraph::NO_ID && TimingGraph::GetKind(fanin) != TimingGraph::GATE_OUTPUT )
 	    {
-		assert( fanin_ptr->GetType() == Element::PIN_NODE );
-		fanin_ptr = static_cast<PinNode*>(fanin_ptr)->GetFaninPtr();
+		assert( TimingGraph::GetKind(fanin) == TimingGraph::PIN_NODE );
+		fanin = graph.GetFanin( TimingGraph::GetHandleId(fanin) );
 	    }
 
-	    if( fanin_ptr == NULL )
+	    if( fanin == TimingGraph::NO_ID )
 		continue;
 
-	    static_cast<GOutPin*>(fanin_ptr)->IncVisitedCount();
+	    graph.FetGOutPin( TimingGraph::GetHandleId(fanin) ).IncVisitedCount();
 	}
     }
 
@@ -74,45 +77,72 @@ void resistDefectPinNodes( Circuit &circuit )
 // gate with no input specified to anything (no off)
 void resistDefectGates( Circuit &circuit )
 {
-    vector<Gate*> &gates = circuit.FetComGatePtrVec();
+    const TimingGraph &graph = circuit.GetTimingGraph();
 
-    for( unsigned i=0; i<gates.size(); ++i )
+    for( unsigned i=graph.GetFirstComGateId(); i<graph.GetFirstComGateId()+graph.GetComGateNo(); ++i )
     {
-	Gate &cur_gate = *(gates[i]);
+	Gate &cur_gate = *(graph.GetGatePtr(i));
 
-	for( unsigned j=0; j<cur_gate.GetInputNo(); ++j )
-	    if( cur_gate.FetGInPin(j).GetFaninPtr() == NULL )
+	for( unsigned j=graph.GetInputBegin(i); j<graph.GetInputEnd(i); ++j )
+	    if( graph.GetInputPinNodeId(j) == TimingGraph::NO_ID )
 		cur_gate.IncInputVisitedCount();
     }
 
     return;
 }
 
-void runSTA( Circuit &circuit )
+// STA is parallel if there are more than one threads, where forward STA runs by levels or as a task graph,
+// and backward STA pulls or pushes required times level by level
+void runSTA( Circuit &circuit, ThreadPool &thread_pool, const unsigned &chunk_size, const bool &is_task_graph, const bool &is_push_backward )
 {
+    if( !circuit.HasTimingGraph() )
+	circuit.BuildTimingGraph();
+
     resistDefectPinNodes( circuit );
     resistDefectGates( circuit );
 
+    const bool is_parallel = ( thread_pool.GetThreadNo() > 1 );
+
     if( circuit.GetIsSequential() )
     {
-	runSeqForwardSTA( circuit );
+	if( is_parallel && is_task_graph )
+	    runTaskForwardSTA( circuit, thread_pool, chunk_size );
+	else if( is_parallel )
+	    runLevelForwardSTA( circuit, thread_pool, chunk_size );
+	else
+	    runSeqForwardSTA( circuit );
 
 	injectGivenRATData( circuit );
 
 	assert( areAllPinNodesNonVisited(circuit) );
-	runSeqBackwardSTA( circuit );
+
+	if( is_parallel )
+	    runLevelBackwardSTA( circuit, thread_pool, chunk_size, is_push_backward );
+	else
+	    runSeqBackwardSTA( circuit );
+
 	assert( areAllPinNodesVisited(circuit) );
     }
     else
     {
-	runComForwardSTA( circuit ); // get arrival time data, but it would set visited count in gates
+	if( is_parallel && is_task_graph )
+	    runTaskForwardSTA( circuit, thread_pool, chunk_size );
+	else if( is_parallel )
+	    runLevelForwardSTA( circuit, thread_pool, chunk_size );
+	else
+	    runComForwardSTA( circuit ); // get arrival time data, but it would set visited count in gates
 
 	if( circuit.GetRATDataNo() > 0 )
 	{
 	    injectGivenRATData( circuit );
 
 	    assert( areAllPinNodesNonVisited(circuit) );
-	    runComBackwardSTA( circuit ); 
+
+	    if( is_parallel )
+		runLevelBackwardSTA( circuit, thread_pool, chunk_size, is_push_backward );
+	    else
+		runComBackwardSTA( circuit ); 
+
 	    assert( areAllPinNodesVisited(circuit) );
 	}
     }
@@ -120,6 +150,23 @@ void runSTA( Circuit &circuit )
     return;
 }
 
+// given required times and the clock period take no part in forward STA, so arrival times and slews are kept;
+// required times are rebuilt from scratch, since they can only be tightened, by the level backward STA,
+// which does not depend on the visited counts left by the serial STA
+void runConstraintSTA( Circuit &circuit, ThreadPool &thread_pool, const unsigned &chunk_size, const bool &is_push_backward )
+{
+    assert( circuit.HasTimingGraph() );
+    circuit.FetTimingStore().ResetReqTimes();
+
+    if( !circuit.GetIsSequential() && circuit.GetRATDataNo() == 0 ) // no backward STA, the same as runSTA()
+	return;
+
+    injectGivenRATData( circuit );
+    runLevelBackwardSTA( circuit, thread_pool, chunk_size, is_push_backward ); // flip-flop constraints of the new period
+
+    return;
+}
+
 //-----------------------------------------------------------------------
 //    Define auxiliary functions 
 //-----------------------------------------------------------------------
@@ -151,59 +198,64 @@ void injectGivenRATData( Circuit &circuit )
     vector<RATData> &rat_vec = circuit.FetRATDataVec();
 
     for( unsigned i=0; i<rat_vec.size(); ++i )
-    {
-	RATData &cur_data = rat_vec[i];
-	PinNode &cur_pnode = (*cur_data.PinNodePtr);
+	injectRATData( circuit, rat_vec[i] );
 
-	switch( cur_data.Mode )
-	{
-	    case RATData::BOTH:
-		{
-		    cur_pnode.SetFastFallReqTime(cur_data.FastFallTime); 
-		    cur_pnode.SetFastRiseReqTime(cur_data.FastRiseTime);
-		    cur_pnode.SetSlowFallReqTime(cur_data.SlowFallTime);
-		    cur_pnode.SetSlowRiseReqTime(cur_data.SlowRiseTime);
-		    break;
-		}
-	    case RATData::SLOW:
-		{
-		    cur_pnode.SetSlowFallReqTime(cur_data.SlowFallTime);
-		    cur_pnode.SetSlowRiseReqTime(cur_data.SlowRiseTime);
-		    break;
-		}
-	    case RATData::FAST:
-		{
-		    cur_pnode.SetFastFallReqTime(cur_data.FastFallTime);
-		    cur_pnode.SetFastRiseReqTime(cur_data.FastRiseTime);
-		    break;
-		}
-	    default:
-		assert(0);
+    return;
+}
+
+void injectRATData( Circuit &circuit, const RATData &cur_data )
+{
+    TimingStore &store = circuit.FetTimingStore();
+    const unsigned id = cur_data.PinNodePtr->GetId();
+
+    switch( cur_data.Mode )
+    {
+	case RATData::BOTH:
+	    {
+		store.TightenReqTime( TimingStore::FAST_FALL, id, cur_data.FastFallTime );
+		store.TightenReqTime( TimingStore::FAST_RISE, id, cur_data.FastRiseTime );
+		store.TightenReqTime( TimingStore::SLOW_FALL, id, cur_data.SlowFallTime );
+		store.TightenReqTime( TimingStore::SLOW_RISE, id, cur_data.SlowRiseTime );
 		break;
-	}
+	    }
+	case RATData::SLOW:
+	    {
+		store.TightenReqTime( TimingStore::SLOW_FALL, id, cur_data.SlowFallTime );
+		store.TightenReqTime( TimingStore::SLOW_RISE, id, cur_data.SlowRiseTime );
+		break;
+	    }
+	case RATData::FAST:
+	    {
+		store.TightenReqTime( TimingStore::FAST_FALL, id, cur_data.FastFallTime );
+		store.TightenReqTime( TimingStore::FAST_RISE, id, cur_data.FastRiseTime );
+		break;
+	    }
+	default:
+	    assert(0);
+	    break;
     }
+
+    return;
 }
 
-void propagateVirtualSignal( PinNode &cur_pnode )
+void propagateVirtualSignal( const TimingGraph &graph, const unsigned &pnode_id )
 {
-    for( unsigned i=0; i<cur_pnode.GetFanoutPtrNo(); ++i )
+    for( unsigned i=graph.GetFanoutBegin(pnode_id); i<graph.GetFanoutEnd(pnode_id); ++i )
     {
-        Element *fanout_ptr = cur_pnode.GetFanoutPtr(i);
+        const unsigned fanout = graph.GetFanout(i);
 
-	if( fanout_ptr->GetType() == Element::GIN_PIN )
+	if( TimingGraph::GetKind(fanout) == TimingGraph::GATE_INPUT )
 	{
-//	    printf( "inject name = %s\n", static_cast<GInPin*>(fanout_ptr)->GetGatePtr()->GetCellPtr()->GetName().c_str() );
-	    static_cast<GInPin*>(fanout_ptr)->GetGatePtr()->IncInputVisitedCount();
-	    assert( static_cast<GInPin*>(fanout_ptr)->GetGatePtr()->GetInputVisitedCount() <
-                    static_cast<GInPin*>(fanout_ptr)->GetGatePtr()->GetInputNo() );
+	    Gate &driven_gate = *(graph.GetGatePtr( graph.GetInputGateId(TimingGraph::GetHandleId(fanout)) ));
+	    driven_gate.IncInputVisitedCount();
+	    assert( driven_gate.GetInputVisitedCount() < driven_gate.GetInputNo() );
 	}
 	else
 	{
-	    assert( fanout_ptr->GetType() == Element::PIN_NODE );
-	    propagateVirtualSignal( *(static_cast<PinNode*>(fanout_ptr)) );
+	    assert( TimingGraph::GetKind(fanout) == TimingGraph::PIN_NODE );
+	    propagateVirtualSignal( graph, TimingGraph::GetHandleId(fanout) );
 	}
     }
 
     return;
 }
-
@@ -9,6 +9,7 @@
 #include <cassert>
 #include <cmath>
 #include <cstdio>
+#include <limits>
 #include <list>
 #include <queue>
 #include <vector>
@@ -16,6 +17,7 @@
 #include "Circuit.h"
 #include "Gate.h"
 #include "PinNode.h"
+#include "TimingStore.h"
 #include "process.h"
 
 using namespace std;
@@ -32,15 +34,17 @@ void runSeqForwardSTA( Circuit &circuit );
 //    Declare auxiliary functions 
 //-----------------------------------------------------------------------
 
-extern bool areOutputsReached( GOutPin& gout_pin );
+void injectFFsRATData( Circuit &circuit ); // setup and hold time constraints only
 
-void injectFFsRATData( Circuit &circuit, queue<Gate*> &waited_queue );
+void injectFFRATData( Circuit &circuit, Gate &ff_gate, const unsigned &input_pin_id );
 
-extern void injectPOsRATData( Circuit &circuit, queue<Gate*> &waited_queue );
+void injectFFsRATData( Circuit &circuit, queue<unsigned> &waited_queue );
 
-void runSeqForwardSTA( Circuit &circuit, vector<Gate*> &waited_queue );
+extern void injectPOsRATData( Circuit &circuit, queue<unsigned> &waited_queue );
 
-extern void visitAndNotifyDrivingGate( PinNode &cur_pnode, queue<Gate*> &waited_queue );
+void runSeqForwardSTA( Circuit &circuit, vector<unsigned> &waited_queue );
+
+extern void visitAndNotifyDrivingGate( Circuit &circuit, const unsigned &pnode_id, queue<unsigned> &waited_queue );
 
 //-----------------------------------------------------------------------
 //    Define main functions
@@ -48,7 +52,10 @@ extern void visitAndNotifyDrivingGate( PinNode &cur_pnode, queue<Gate*> &waited_
 
 void runSeqBackwardSTA( Circuit &circuit )
 {
-    queue<Gate*> waited_queue;
+    const TimingGraph &graph = circuit.GetTimingGraph();
+    TimingStore &store = circuit.FetTimingStore();
+    const double inf = numeric_limits<double>::infinity();
+    queue<unsigned> waited_queue; // gate ids
 
     injectFFsRATData( circuit, waited_queue ); // inject flip-flop related constraints
 
@@ -56,68 +63,69 @@ void runSeqBackwardSTA( Circuit &circuit )
 
     while( !waited_queue.empty() )
     {
-	Gate &cur_gate = *(waited_queue.front());
+	const unsigned cur_gate_id = waited_queue.front();
+	Gate &cur_gate = *(graph.GetGatePtr(cur_gate_id));
 	waited_queue.pop();
 
 //	if( cur_gate.GetCellPtr() != NULL )
 //	    printf( "it is %s\n", cur_gate.GetCellPtr()->GetName().c_str() );
 
-        for( unsigned i=0; i<cur_gate.GetOutputNo(); ++i )
+        for( unsigned i=graph.GetOutputBegin(cur_gate_id); i<graph.GetOutputEnd(cur_gate_id); ++i )
 	{
-	    if( cur_gate.GetOutputPinNode(i) == NULL )
+	    const unsigned cur_id = graph.GetOutputPinNodeId(i);
+
+	    if( cur_id == TimingGraph::NO_ID )
 		continue;
 
-	    PinNode &cur_pnode = *(cur_gate.GetOutputPinNode(i));
-	    const unsigned fanout_no = cur_pnode.GetFanoutNo();
-	    vector<double> cur_fastFall_ratime, cur_fastRise_ratime, cur_slowFall_ratime, cur_slowRise_ratime;
-	    cur_fastFall_ratime.reserve( fanout_no );
-	    cur_fastRise_ratime.reserve( fanout_no );
-	    cur_slowFall_ratime.reserve( fanout_no );
-	    cur_slowRise_ratime.reserve( fanout_no );
+	    PinNode &cur_pnode = *(circuit.GetPinNodePtr(cur_id));
+	    bool has_driven_tap = false;
+
+	    // running extrema over all driven taps: max in early mode, min in late mode
+	    double cur_fastFall_ratime = -inf, cur_fastRise_ratime = -inf;
+	    double cur_slowFall_ratime = inf, cur_slowRise_ratime = inf;
 
-	    for( unsigned j=0; j<fanout_no; ++j )
+	    for( unsigned j=graph.GetFanoutBegin(cur_id); j<graph.GetFanoutEnd(cur_id); ++j )
 	    {
-		Element *driven_ptr = cur_pnode.GetFanoutPtr(j);
+		const unsigned fanout = graph.GetFanout(j);
 
-		if( driven_ptr->GetType() == Element::GIN_PIN )
+		if( TimingGraph::GetKind(fanout) != TimingGraph::PIN_NODE )
 		    continue;
 
-		PinNode &driven_pnode = *(static_cast<PinNode*>(driven_ptr));
+		const unsigned driven_id = TimingGraph::GetHandleId(fanout);
 
-		if( driven_pnode.GetFanoutPtrNo() == 0 )
+		if( graph.GetTapInputId(driven_id) == TimingGraph::NO_ID )
 		    continue;
 
-                assert( (driven_pnode.GetFanoutPtr(0))->GetType() == Element::GIN_PIN );
-		GInPin &driven_gin_pin = *(static_cast<GInPin*>(driven_pnode.GetFanoutPtr(0)));
-		cur_fastFall_ratime.push_back( driven_pnode.GetFastFallReqTime() - driven_gin_pin.GetFallArrDelay() );
-		cur_fastRise_ratime.push_back( driven_pnode.GetFastRiseReqTime() - driven_gin_pin.GetRiseArrDelay() );
-                cur_slowFall_ratime.push_back( driven_pnode.GetSlowFallReqTime() - driven_gin_pin.GetFallArrDelay() );
-		cur_slowRise_ratime.push_back( driven_pnode.GetSlowRiseReqTime() - driven_gin_pin.GetRiseArrDelay() );
+		has_driven_tap = true;
+		cur_fastFall_ratime = max( cur_fastFall_ratime, store.GetReqTime(TimingStore::FAST_FALL, driven_id) - graph.GetWireFallDelay(driven_id) );
+		cur_fastRise_ratime = max( cur_fastRise_ratime, store.GetReqTime(TimingStore::FAST_RISE, driven_id) - graph.GetWireRiseDelay(driven_id) );
+                cur_slowFall_ratime = min( cur_slowFall_ratime, store.GetReqTime(TimingStore::SLOW_FALL, driven_id) - graph.GetWireFallDelay(driven_id) );
+		cur_slowRise_ratime = min( cur_slowRise_ratime, store.GetReqTime(TimingStore::SLOW_RISE, driven_id) - graph.GetWireRiseDelay(driven_id) );
 	    }
 
 	    cur_pnode.SetIsVisited();
 
-	    if( cur_fastFall_ratime.size() > 0 )
+	    if( has_driven_tap )
 	    {
-		cur_pnode.SetFastFallReqTime( *max_element(cur_fastFall_ratime.begin(), cur_fastFall_ratime.end()) );
-		cur_pnode.SetFastRiseReqTime( *max_element(cur_fastRise_ratime.begin(), cur_fastRise_ratime.end()) );
-		cur_pnode.SetSlowFallReqTime( *min_element(cur_slowFall_ratime.begin(), cur_slowFall_ratime.end()) );
-		cur_pnode.SetSlowRiseReqTime( *min_element(cur_slowRise_ratime.begin(), cur_slowRise_ratime.end()) );
+		store.TightenReqTime( TimingStore::FAST_FALL, cur_id, cur_fastFall_ratime );
+		store.TightenReqTime( TimingStore::FAST_RISE, cur_id, cur_fastRise_ratime );
+		store.TightenReqTime( TimingStore::SLOW_FALL, cur_id, cur_slowFall_ratime );
+		store.TightenReqTime( TimingStore::SLOW_RISE, cur_id, cur_slowRise_ratime );
 	    }
 	}
 
 	if( cur_gate.GetCellPtr() != NULL && cur_gate.GetIsNonClocked() ) // not PI
 	{
-	    backtraceSignal( cur_gate );
+	    backtraceSignal( circuit, cur_gate_id );
 
-	    for( unsigned i=0; i<cur_gate.GetInputNo(); ++i )
+	    for( unsigned i=graph.GetInputBegin(cur_gate_id); i<graph.GetInputEnd(cur_gate_id); ++i )
 	    {
-		assert( cur_gate.GetInputPinNode(i) != NULL );
+		assert( graph.GetInputPinNodeId(i) != TimingGraph::NO_ID );
 
-		if( cur_gate.GetInputPinNode(i) == NULL )
+		if( graph.GetInputPinNodeId(i) == TimingGraph::NO_ID )
 		    continue;
 
-                visitAndNotifyDrivingGate( *(cur_gate.GetInputPinNode(i)), waited_queue );
+                visitAndNotifyDrivingGate( circuit, graph.GetInputPinNodeId(i), waited_queue );
 	    }
 	}
     }
@@ -131,12 +139,13 @@ void runSeqForwardSTA( Circuit &circuit )
     assert( circuit.GetIsSequential() ); // for sequential circuit
     //assert( areAllComGatesInputNonTraversed(circuit) );
 
-    vector<Gate*> waited_queue; // vector queue
-    waited_queue.reserve( circuit.GetTotGateNo() );
+    const TimingGraph &graph = circuit.GetTimingGraph();
+    vector<unsigned> waited_queue; // vector queue of gate ids
+    waited_queue.reserve( graph.GetGateNo() );
 
     // insert primary inputs into queue
-    for( unsigned i=0; i<circuit.GetPINo(); ++i )
-	waited_queue.push_back( circuit.GetPIPtr(i) );
+    for( unsigned i=0; i<graph.GetPINo(); ++i )
+	waited_queue.push_back( i );
 
     runSeqForwardSTA( circuit, waited_queue ); // propagate from PI to flip-flops and primary outputs
     waited_queue.clear();
@@ -144,11 +153,11 @@ void runSeqForwardSTA( Circuit &circuit )
 
     // propagate clock signals through flip-flops to Q's and QN's output pin nodes
     for( unsigned i=0; i<SeqGate_ptr_vec.size(); ++i )
-	propagateSignal( SeqGate_ptr_vec[i]->GetClockPinId(), SeqGate_ptr_vec[i] );
+	propagateSignal( circuit, SeqGate_ptr_vec[i]->GetClockPinId(), SeqGate_ptr_vec[i] );
 
     // insert flip-flops into queue
-    for( unsigned i=0; i<SeqGate_ptr_vec.size(); ++i )
-	waited_queue.push_back( circuit.GetSeqGatePtr(i) );
+    for( unsigned i=0; i<graph.GetSeqGateNo(); ++i )
+	waited_queue.push_back( graph.GetFirstSeqGateId()+i );
 
     runSeqForwardSTA( circuit, waited_queue ); // propagate from flip-flops to flip-flops and primary outputs
     return;
@@ -158,144 +167,146 @@ void runSeqForwardSTA( Circuit &circuit )
 //    Define auxiliary functions 
 //-----------------------------------------------------------------------
 
-void injectFFsRATData( Circuit &circuit, queue<Gate*> &waited_queue )
+void injectFFsRATData( Circuit &circuit )
 {
     const vector<Gate*> &SeqGate_ptr_vec = circuit.FetSeqGatePtrVec();
-    const double clock_period = circuit.GetClockPeriod();
 
     for( unsigned i=0; i<SeqGate_ptr_vec.size(); ++i )
     {
         Gate &cur_gate = *(SeqGate_ptr_vec[i]);
-	const unsigned clock_pin_id = cur_gate.GetClockPinId();
-	PinNode* clk_pnode_ptr = cur_gate.GetInputPinNode(clock_pin_id);
 
-	if( clk_pnode_ptr == NULL )
-	    continue;
+	for( unsigned j=0; j<cur_gate.GetInputNo(); ++j )
+	    injectFFRATData( circuit, cur_gate, j );
+    }
 
-	visitAndNotifyDrivingGate( *clk_pnode_ptr, waited_queue );
-	const vector<ClockParams*> &clock_params_vec = (cur_gate.GetCellPtr())->FetClockParamsVec();
+    return;
+}
 
-	for( unsigned j=0; j<cur_gate.GetInputNo(); ++j )
-	{
-	    if( j == clock_pin_id || cur_gate.GetInputPinNode(j) == NULL )
-		continue;
+// setup and hold time constraints of a flip-flop input pin, if any
+void injectFFRATData( Circuit &circuit, Gate &ff_gate, const unsigned &input_pin_id )
+{
+    TimingStore &store = circuit.FetTimingStore();
+    const double clock_period = circuit.GetClockPeriod();
+    const unsigned clock_pin_id = ff_gate.GetClockPinId();
+    PinNode* clk_pnode_ptr = ff_gate.GetInputPinNode(clock_pin_id);
 
-	    PinNode &input_pnode = *(cur_gate.GetInputPinNode(j));
+    if( clk_pnode_ptr == NULL || input_pin_id == clock_pin_id || ff_gate.GetInputPinNode(input_pin_id) == NULL )
+	return;
 
-            visitAndNotifyDrivingGate( input_pnode, waited_queue );
+    const unsigned clk_id = clk_pnode_ptr->GetId();
+    const unsigned input_id = ff_gate.GetInputPinNode(input_pin_id)->GetId();
+    const vector<ClockParams*> &clock_params_vec = (ff_gate.GetCellPtr())->FetClockParamsVec();
 
-	    if( clock_params_vec[j] == NULL )
-		continue;
+    if( clock_params_vec[input_pin_id] == NULL )
+	return;
 
-	    ClockParams &clock_params = *(clock_params_vec[j]);
+    const ClockParams &clock_params = *(clock_params_vec[input_pin_id]);
 
-	    // setup time constraint
-	    if( clock_params.SetupEdgeType == ClockParams::RISING )
-	    {
-		double fall_setup = clock_params.FallSetupG + clock_params.FallSetupH * (clk_pnode_ptr->GetFastRiseSlew())
-		                  + clock_params.FallSetupJ * input_pnode.GetSlowFallSlew();
-		double rise_setup = clock_params.RiseSetupG + clock_params.RiseSetupH * (clk_pnode_ptr->GetFastRiseSlew())
-		                  + clock_params.RiseSetupJ * input_pnode.GetSlowRiseSlew();
+    // setup time constraint
+    if( clock_params.SetupEdgeType == ClockParams::RISING )
+    {
+	double fall_setup = clock_params.FallSetupG + clock_params.FallSetupH * store.GetSlew(TimingStore::FAST_RISE, clk_id)
+	                  + clock_params.FallSetupJ * store.GetSlew(TimingStore::SLOW_FALL, input_id);
+	double rise_setup = clock_params.RiseSetupG + clock_params.RiseSetupH * store.GetSlew(TimingStore::FAST_RISE, clk_id)
+	                  + clock_params.RiseSetupJ * store.GetSlew(TimingStore::SLOW_RISE, input_id);
 
-		input_pnode.SetSlowFallReqTime( clock_period + clk_pnode_ptr->GetFastRiseArrTime() - fall_setup );
-		input_pnode.SetSlowRiseReqTime( clock_period + clk_pnode_ptr->GetFastRiseArrTime() - rise_setup );
-	    }
-	    else
-	    {
-		assert( clock_params.SetupEdgeType == ClockParams::FALLING );
-		double fall_setup = clock_params.FallSetupG + clock_params.FallSetupH * (clk_pnode_ptr->GetFastFallSlew())
-		                  + clock_params.FallSetupJ * input_pnode.GetSlowFallSlew();
-		double rise_setup = clock_params.RiseSetupG + clock_params.RiseSetupH * (clk_pnode_ptr->GetFastFallSlew())
-		                  + clock_params.RiseSetupJ * input_pnode.GetSlowRiseSlew();
-
-		input_pnode.SetSlowFallReqTime( clock_period + clk_pnode_ptr->GetFastFallArrTime() - fall_setup );
-		input_pnode.SetSlowRiseReqTime( clock_period + clk_pnode_ptr->GetFastFallArrTime() - rise_setup );
-	    }
+	store.TightenReqTime( TimingStore::SLOW_FALL, input_id, clock_period + store.GetArrTime(TimingStore::FAST_RISE, clk_id) - fall_setup );
+	store.TightenReqTime( TimingStore::SLOW_RISE, input_id, clock_period + store.GetArrTime(TimingStore::FAST_RISE, clk_id) - rise_setup );
+    }
+    else
+    {
+	assert( clock_params.SetupEdgeType == ClockParams::FALLING );
+	double fall_setup = clock_params.FallSetupG + clock_params.FallSetupH * store.GetSlew(TimingStore::FAST_FALL, clk_id)
+	                  + clock_params.FallSetupJ * store.GetSlew(TimingStore::SLOW_FALL, input_id);
+	double rise_setup = clock_params.RiseSetupG + clock_params.RiseSetupH * store.GetSlew(TimingStore::FAST_FALL, clk_id)
+	                  + clock_params.RiseSetupJ * store.GetSlew(TimingStore::SLOW_RISE, input_id);
+
+	store.TightenReqTime( TimingStore::SLOW_FALL, input_id, clock_period + store.GetArrTime(TimingStore::FAST_FALL, clk_id) - fall_setup );
+	store.TightenReqTime( TimingStore::SLOW_RISE, input_id, clock_period + store.GetArrTime(TimingStore::FAST_FALL, clk_id) - rise_setup );
+    }
 
-	    // hold time constraint
-	    if( clock_params.HoldEdgeType == ClockParams::RISING )
-	    {
-		double fall_hold = clock_params.FallHoldM + clock_params.FallHoldN * (clk_pnode_ptr->GetSlowRiseSlew())
-		                 + clock_params.FallHoldP * input_pnode.GetFastFallSlew();
-		double rise_hold = clock_params.RiseHoldM + clock_params.RiseHoldN * (clk_pnode_ptr->GetSlowRiseSlew())
-		                 + clock_params.RiseHoldP * input_pnode.GetFastRiseSlew();
+    // hold time constraint
+    if( clock_params.HoldEdgeType == ClockParams::RISING )
+    {
+	double fall_hold = clock_params.FallHoldM + clock_params.FallHoldN * store.GetSlew(TimingStore::SLOW_RISE, clk_id)
+	                 + clock_params.FallHoldP * store.GetSlew(TimingStore::FAST_FALL, input_id);
+	double rise_hold = clock_params.RiseHoldM + clock_params.RiseHoldN * store.GetSlew(TimingStore::SLOW_RISE, clk_id)
+	                 + clock_params.RiseHoldP * store.GetSlew(TimingStore::FAST_RISE, input_id);
 
-		input_pnode.SetFastFallReqTime( clk_pnode_ptr->GetSlowRiseArrTime() + fall_hold );
-		input_pnode.SetFastRiseReqTime( clk_pnode_ptr->GetSlowRiseArrTime() + rise_hold );
+	store.TightenReqTime( TimingStore::FAST_FALL, input_id, store.GetArrTime(TimingStore::SLOW_RISE, clk_id) + fall_hold );
+	store.TightenReqTime( TimingStore::FAST_RISE, input_id, store.GetArrTime(TimingStore::SLOW_RISE, clk_id) + rise_hold );
 
-	    }
-	    else
-	    {
-		assert( clock_params.HoldEdgeType == ClockParams::FALLING );
-		double fall_hold = clock_params.FallHoldM + clock_params.FallHoldN * (clk_pnode_ptr->GetSlowFallSlew())
-		                 + clock_params.FallHoldP * input_pnode.GetFastFallSlew();
-		double rise_hold = clock_params.RiseHoldM + clock_params.RiseHoldN * (clk_pnode_ptr->GetSlowFallSlew())
-		                 + clock_params.RiseHoldP * input_pnode.GetFastRiseSlew();
-
-		input_pnode.SetFastFallReqTime( clk_pnode_ptr->GetSlowFallArrTime() + fall_hold );
-		input_pnode.SetFastRiseReqTime( clk_pnode_ptr->GetSlowFallArrTime() + rise_hold );
-	    }
-	} // end input consideration
+    }
+    else
+    {
+	assert( clock_params.HoldEdgeType == ClockParams::FALLING );
+	double fall_hold = clock_params.FallHoldM + clock_params.FallHoldN * store.GetSlew(TimingStore::SLOW_FALL, clk_id)
+	                 + clock_params.FallHoldP * store.GetSlew(TimingStore::FAST_FALL, input_id);
+	double rise_hold = clock_params.RiseHoldM + clock_params.RiseHoldN * store.GetSlew(TimingStore::SLOW_FALL, clk_id)
+	                 + clock_params.RiseHoldP * store.GetSlew(TimingStore::FAST_RISE, input_id);
+
+	store.TightenReqTime( TimingStore::FAST_FALL, input_id, store.GetArrTime(TimingStore::SLOW_FALL, clk_id) + fall_hold );
+	store.TightenReqTime( TimingStore::FAST_RISE, input_id, store.GetArrTime(TimingStore::SLOW_FALL, clk_id) + rise_hold );
     }
 
     return;
 }
 
-// propagate from gates in waited_queue to flip-flops or primary outputs
-void runSeqForwardSTA( Circuit &circuit, vector<Gate*> &waited_queue )
+// constraints, and then notify the gates driving the flip-flops
+void injectFFsRATData( Circuit &circuit, queue<unsigned> &waited_queue )
 {
-    for( unsigned i=0; i<waited_queue.size(); ++i )
+    const vector<Gate*> &SeqGate_ptr_vec = circuit.FetSeqGatePtrVec();
+
+    for( unsigned i=0; i<SeqGate_ptr_vec.size(); ++i )
     {
-	Gate &cur_gate = *(waited_queue[i]);
+        Gate &cur_gate = *(SeqGate_ptr_vec[i]);
+	const unsigned clock_pin_id = cur_gate.GetClockPinId();
+	PinNode* clk_pnode_ptr = cur_gate.GetInputPinNode(clock_pin_id);
 
-	for( unsigned j=0; j<cur_gate.GetOutputNo(); ++j )
-	{
-	    if( cur_gate.GetOutputPinNode(j) == NULL )
-		continue;
+	if( clk_pnode_ptr == NULL )
+	    continue;
 
-            PinNode &cur_pnode = *(cur_gate.GetOutputPinNode(j));
-	    const double output_fast_fall_slew_sq = cur_pnode.GetFastFallSlew() * cur_pnode.GetFastFallSlew();
-	    const double output_fast_rise_slew_sq = cur_pnode.GetFastRiseSlew() * cur_pnode.GetFastRiseSlew();
-	    const double output_slow_fall_slew_sq = cur_pnode.GetSlowFallSlew() * cur_pnode.GetSlowFallSlew();
-	    const double output_slow_rise_slew_sq = cur_pnode.GetSlowRiseSlew() * cur_pnode.GetSlowRiseSlew();
+	visitAndNotifyDrivingGate( circuit, clk_pnode_ptr->GetId(), waited_queue );
 
-	    for( unsigned k=0; k<cur_pnode.GetFanoutNo(); ++k )
-	    {
-                Gate *driven_gate_ptr;
-		assert( (cur_pnode.GetFanoutPtr(k))->GetType() == Element::PIN_NODE || 
-			(cur_pnode.GetFanoutPtr(k))->GetType() == Element::GIN_PIN );
+	for( unsigned j=0; j<cur_gate.GetInputNo(); ++j )
+	    if( j != clock_pin_id && cur_gate.GetInputPinNode(j) != NULL )
+		visitAndNotifyDrivingGate( circuit, cur_gate.GetInputPinNode(j)->GetId(), waited_queue );
+    }
 
-		if( (cur_pnode.GetFanoutPtr(k))->GetType() == Element::PIN_NODE )
-		{
-		    PinNode &driven_pnode = *(static_cast<PinNode*>(cur_pnode.GetFanoutPtr(k)));
+    injectFFsRATData( circuit );
 
-		    if( driven_pnode.GetFanoutPtrNo() == 0 ) // very special case
-			continue;
+    return;
+}
 
-		    assert( (driven_pnode.GetFanoutPtr(0))->GetType() == Element::GIN_PIN );
-		    const GInPin &gin_pin = *(static_cast<GInPin*>(driven_pnode.GetFanoutPtr(0)));
-		    const double wire_fall_delay = gin_pin.GetFallArrDelay();
-		    const double wire_rise_delay = gin_pin.GetRiseArrDelay();
+// propagate from gates in waited_queue to flip-flops or primary outputs
+void runSeqForwardSTA( Circuit &circuit, vector<unsigned> &waited_queue )
+{
+    const TimingGraph &graph = circuit.GetTimingGraph();
 
-		    driven_pnode.SetFastFallArrTime( cur_pnode.GetFastFallArrTime() + wire_fall_delay );
-		    driven_pnode.SetFastRiseArrTime( cur_pnode.GetFastRiseArrTime() + wire_rise_delay );
-		    driven_pnode.SetFastFallSlew( sqrt( output_fast_fall_slew_sq + driven_pnode.GetFallSlewHatSq() ) );
-		    driven_pnode.SetFastRiseSlew( sqrt( output_fast_rise_slew_sq + driven_pnode.GetRiseSlewHatSq() ) );
+    for( unsigned i=0; i<waited_queue.size(); ++i )
+    {
+	const unsigned cur_gate_id = waited_queue[i];
 
-		    driven_pnode.SetSlowFallArrTime( cur_pnode.GetSlowFallArrTime() + wire_fall_delay );
-		    driven_pnode.SetSlowRiseArrTime( cur_pnode.GetSlowRiseArrTime() + wire_rise_delay );
-		    driven_pnode.SetSlowFallSlew( sqrt( output_slow_fall_slew_sq + driven_pnode.GetFallSlewHatSq() ) );
-		    driven_pnode.SetSlowRiseSlew( sqrt( output_slow_rise_slew_sq + driven_pnode.GetRiseSlewHatSq() ) );
+	for( unsigned j=graph.GetOutputBegin(cur_gate_id); j<graph.GetOutputEnd(cur_gate_id); ++j )
+	{
+	    const unsigned cur_id = graph.GetOutputPinNodeId(j);
 
-		    assert( driven_pnode.GetFanoutNo() == 1 );
-		    assert( (driven_pnode.GetFanoutPtr(0))->GetType() == Element::GIN_PIN );
-		    driven_gate_ptr = (static_cast<GInPin*>(driven_pnode.GetFanoutPtr(0)))->GetGatePtr();
-		}
-		else
-		{
-		    driven_gate_ptr = (static_cast<GInPin*>(cur_pnode.GetFanoutPtr(k)))->GetGatePtr();
-		}
+	    if( cur_id == TimingGraph::NO_ID )
+		continue;
+
+	    propagateWireSignal( circuit, cur_id ); // taps first, then gates they reach
+
+	    for( unsigned k=graph.GetFanoutBegin(cur_id); k<graph.GetFanoutEnd(cur_id); ++k )
+	    {
+		const unsigned fanout = graph.GetFanout(k);
+		const unsigned driven_input_id = (TimingGraph::GetKind(fanout) == TimingGraph::PIN_NODE)? 
+		                                 graph.GetTapInputId(TimingGraph::GetHandleId(fanout)): TimingGraph::GetHandleId(fanout);
+
+		if( driven_input_id == TimingGraph::NO_ID ) // very special case
+		    continue;
 
+		const unsigned driven_gate_id = graph.GetInputGateId(driven_input_id);
+		Gate *driven_gate_ptr = graph.GetGatePtr(driven_gate_id);
 		driven_gate_ptr->IncInputVisitedCount();
 		assert( driven_gate_ptr->GetInputVisitedCount() <= driven_gate_ptr->GetInputNo() );
 
@@ -304,14 +315,13 @@ void runSeqForwardSTA( Circuit &circuit, vector<Gate*> &waited_queue )
 		{
 		    if( driven_gate_ptr->GetIsNonClocked() && driven_gate_ptr->GetCellPtr() != NULL ) // not FF or PO
 		    {
-			waited_queue.push_back( driven_gate_ptr );
-			propagateSignal( driven_gate_ptr ); // propagate signal through this gate
+			waited_queue.push_back( driven_gate_id );
+			propagateSignal( circuit, driven_gate_id ); // propagate signal through this gate
 		    }
 		}
-	    } // end fanout consideration 
+	    } // end fanout consideration
 	}
     }
 
     return;
 }
-
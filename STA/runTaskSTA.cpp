@@ -0,0 +1,127 @@
+/************************************************************************
+ *   Perform forward STA as a task graph instead of level by level.
+ *   Each gate is a task. A finished task decrements the pending-input
+ *   counters of the gates its wires reach, and pushes a gate onto the
+ *   work-stealing deque of its worker as soon as the last input arrives,
+ *   so deep and narrow cones do not wait for the widest level.
+ *
+ *   A sequential circuit is propagated in two runs, from primary inputs
+ *   to flip-flops, and then from flip-flops after clock signals reach
+ *   their outputs, the same as the serial forward STA.
+ *
+ *   Author      : Kuan-Hsien Ho
+************************************************************************/
+
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <vector>
+
+#include "Circuit.h"
+#include "Gate.h"
+#include "TimingGraph.h"
+#include "process.h"
+
+using namespace std;
+
+//-----------------------------------------------------------------------
+//    Declare main functions
+//-----------------------------------------------------------------------
+
+void runTaskForwardSTA( Circuit &circuit, ThreadPool &thread_pool, const unsigned &chunk_size );
+
+//-----------------------------------------------------------------------
+//    Declare auxiliary functions
+//-----------------------------------------------------------------------
+
+inline bool isFlipFlop( const Gate *gate_ptr );
+
+//-----------------------------------------------------------------------
+//    Define main functions
+//-----------------------------------------------------------------------
+
+// run both early-mode and late-mode STA on a combinational or sequential circuit
+void runTaskForwardSTA( Circuit &circuit, ThreadPool &thread_pool, const unsigned &chunk_size )
+{
+    const TimingGraph &graph = circuit.GetTimingGraph();
+    const unsigned gate_no = graph.GetGateNo();
+
+    // inputs not reached yet, where inputs counted by resistDefectGates() are reached already
+    unique_ptr<atomic<unsigned>[]> pending_input_no_arr( new atomic<unsigned>[gate_no] );
+
+    for( unsigned i=0; i<gate_no; ++i )
+    {
+	const Gate *gate_ptr = graph.GetGatePtr(i);
+	assert( gate_ptr->GetInputVisitedCount() <= gate_ptr->GetInputNo() );
+	pending_input_no_arr[i].store( gate_ptr->GetInputNo()-gate_ptr->GetInputVisitedCount(), memory_order_relaxed );
+    }
+
+    const ThreadPool::TaskFunc propagate_task = [&](unsigned worker_id, unsigned gate_id) {
+	propagateGateSignal( circuit, gate_id );
+
+	for( unsigned i=graph.GetOutputBegin(gate_id); i<graph.GetOutputEnd(gate_id); ++i )
+	{
+	    const unsigned cur_id = graph.GetOutputPinNodeId(i);
+
+	    if( cur_id == TimingGraph::NO_ID )
+		continue;
+
+	    for( unsigned j=graph.GetFanoutBegin(cur_id); j<graph.GetFanoutEnd(cur_id); ++j )
+	    {
+		const unsigned fanout = graph.GetFanout(j);
+		const unsigned driven_input_id = (TimingGraph::GetKind(fanout) == TimingGraph::PIN_NODE)?
+		                                 graph.GetTapInputId(TimingGraph::GetHandleId(fanout)): TimingGraph::GetHandleId(fanout);
+
+		if( driven_input_id == TimingGraph::NO_ID ) // very special case
+		    continue;
+
+		const unsigned driven_gate_id = graph.GetInputGateId(driven_input_id);
+
+		// the last input releases the gate, and acquires what the other inputs' tasks wrote
+		const unsigned pending_input_no = pending_input_no_arr[driven_gate_id].fetch_sub( 1, memory_order_acq_rel );
+		assert( pending_input_no > 0 );
+
+		if( pending_input_no == 1 && !isFlipFlop(graph.GetGatePtr(driven_gate_id)) )
+		    thread_pool.Push( worker_id, driven_gate_id );
+	    }
+	} };
+
+    vector<unsigned> source_vec; // gate ids
+    source_vec.reserve( graph.GetPINo() );
+
+    for( unsigned i=0; i<graph.GetPINo(); ++i )
+	source_vec.push_back(i);
+
+    thread_pool.Run( source_vec, propagate_task ); // propagate from PI to flip-flops and primary outputs
+
+    if( !circuit.GetIsSequential() )
+	return;
+
+    // propagate clock signals through flip-flops to Q's and QN's output pin nodes
+    const unsigned first_seq_gate_id = graph.GetFirstSeqGateId();
+    thread_pool.ParallelFor( graph.GetSeqGateNo(), chunk_size, [&](unsigned, unsigned begin, unsigned end) {
+	for( unsigned i=first_seq_gate_id+begin; i<first_seq_gate_id+end; ++i )
+	{
+	    Gate *gate_ptr = graph.GetGatePtr(i);
+	    propagateSignal( circuit, gate_ptr->GetClockPinId(), gate_ptr );
+	} } );
+
+    source_vec.clear();
+
+    for( unsigned i=0; i<graph.GetSeqGateNo(); ++i )
+	source_vec.push_back( first_seq_gate_id+i );
+
+    thread_pool.Run( source_vec, propagate_task ); // propagate from flip-flops to flip-flops and primary outputs
+
+    return;
+}
+
+//-----------------------------------------------------------------------
+//    Define auxiliary functions
+//-----------------------------------------------------------------------
+
+// flip-flops are reached in the first run, but propagated only in the second
+inline bool isFlipFlop( const Gate *gate_ptr )
+{
+    return ( gate_ptr->GetCellPtr() != NULL && !gate_ptr->GetIsNonClocked() );
+}